@@ -3,9 +3,17 @@
 #if PLATFORM_WINDOWS
 #define AUDIO_MAX_VOICES 8
 #elif PLATFORM_LINUX
-#define AUDIO_MAX_VOICES 8
+#define AUDIO_MAX_VOICES 32
 #elif PLATFORM_DOLPHIN
 #define AUDIO_MAX_VOICES 8
 #elif PLATFORM_3DS
 #define AUDIO_MAX_VOICES 8
+#endif
+
+// Whether the backend can play IMA-ADPCM SoundWaves directly (decoding blocks as it mixes).
+// Other backends decode streamed SoundWaves to PCM at load time.
+#if PLATFORM_LINUX
+#define AUDIO_STREAMING_SUPPORTED 1
+#else
+#define AUDIO_STREAMING_SUPPORTED 0
 #endif
\ No newline at end of file
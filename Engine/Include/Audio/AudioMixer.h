@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Audio/ImaAdpcm.h"
+
+// Software mixer used by audio backends that don't have a hardware/OS mixer (Linux ALSA).
+// Voices are converted to float in blocks, resampled with linear interpolation,
+// accumulated into a float stereo bus, and clamped to int16 once at the very end.
+
+#define AUDIO_MIX_BLOCK_FRAMES 256
+#define AUDIO_MIX_OUTPUT_RATE 44100
+
+// Streamed (IMA-ADPCM) voices decode compressed blocks on demand into a small ring of PCM blocks.
+#define AUDIO_STREAM_RING_BLOCKS 2
+#define AUDIO_STREAM_RING_SAMPLES (AUDIO_STREAM_RING_BLOCKS * IMA_ADPCM_FRAMES_PER_BLOCK * 2)
+
+struct MixVoice
+{
+    const uint8_t* mSrcBuffer = nullptr;
+    uint32_t mSrcFrames = 0;
+    uint32_t mNumChannels = 2;
+    uint32_t mBytesPerSample = 2;
+    int32_t mSampleRate = 44100;
+    float mPitch = 1.0f;
+    float mVolumeL = 1.0f;
+    float mVolumeR = 1.0f;
+    double mCurFrame = 0.0;
+    bool mLoop = false;
+    bool mActive = false;
+
+    // Streaming
+    bool mAdpcm = false;
+    int16_t* mStreamRing = nullptr;
+    int64_t mStreamRingBlocks[AUDIO_STREAM_RING_BLOCKS] = { -1, -1 };
+};
+
+void AUD_MixVoices(
+    MixVoice* voices,
+    uint32_t numVoices,
+    int16_t* outBuffer,
+    uint32_t numFrames,
+    uint32_t outSampleRate = AUDIO_MIX_OUTPUT_RATE);
+
+bool AUD_IsVoiceFinished(const MixVoice& voice);
+
+// Mixes numVoices synthetic looping voices for the given number of seconds offline
+// and returns the elapsed time in milliseconds.
+float AUD_BenchmarkMixer(uint32_t numVoices, float seconds);
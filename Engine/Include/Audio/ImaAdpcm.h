@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// IMA-ADPCM (4 bits per sample) used for cooked SoundWaves.
+// Data is split into blocks of IMA_ADPCM_FRAMES_PER_BLOCK frames so any block can be decoded
+// independently. Each block stores one sub-block per channel:
+//   int16 predictor (little endian), uint8 step index, uint8 reserved, then
+//   IMA_ADPCM_FRAMES_PER_BLOCK / 2 bytes of nibbles (low nibble first).
+// The final block is zero padded.
+
+#define IMA_ADPCM_FRAMES_PER_BLOCK 1024
+#define IMA_ADPCM_CHANNEL_HEADER_SIZE 4
+#define IMA_ADPCM_CHANNEL_BLOCK_SIZE (IMA_ADPCM_CHANNEL_HEADER_SIZE + IMA_ADPCM_FRAMES_PER_BLOCK / 2)
+
+uint32_t AUD_GetImaAdpcmBlockSize(uint32_t numChannels);
+uint32_t AUD_GetImaAdpcmNumBlocks(uint32_t numFrames);
+
+void AUD_EncodeImaAdpcm(
+    const int16_t* samples,
+    uint32_t numFrames,
+    uint32_t numChannels,
+    std::vector<uint8_t>& outData);
+
+// Decodes one block into IMA_ADPCM_FRAMES_PER_BLOCK interleaved int16 frames.
+void AUD_DecodeImaAdpcmBlock(const uint8_t* block, uint32_t numChannels, int16_t* outSamples);
@@ -32,7 +32,8 @@ protected:
     void GenerateEmbeddedAssetFiles(
         std::vector<std::pair<AssetStub*, std::string> >& assets,
         const char* headerPath,
-        const char* sourcePath);
+        const char* sourcePath,
+        const char* blobPath);
 
     void GenerateEmbeddedScriptFiles(
         std::vector<std::string> files,
@@ -57,6 +58,7 @@ public:
     void ImportScene();
     void ShowBuildDataPrompt();
     void BuildData(Platform platform, bool embedded);
+    std::string CookAssets(Platform platform, std::vector<std::pair<AssetStub*, std::string> >& outPackFiles);
     void ClearWorld();
     void RecaptureAndSaveAllLevels();
     void ResaveAllAssets();
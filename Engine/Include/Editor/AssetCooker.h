@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "EngineTypes.h"
+#include "System/SystemTypes.h"
+
+struct AssetStub;
+class AssetDir;
+
+// Cooks every asset into a platform's Packaged directory. Each output is recorded in a manifest along with
+// a hash of its source file and cook settings, so assets that haven't changed since the last cook are skipped.
+// Loading and unloading stays on the main thread (loading creates GPU resources), but the platform saves,
+// which include the external texture converters, are spread across worker threads.
+
+#define COOK_MANIFEST_FILE "CookManifest.txt"
+#define COOK_MAX_THREADS 16
+#define COOK_BATCH_JOBS_PER_THREAD 4
+
+struct CookJob
+{
+    AssetStub* mStub = nullptr;
+    std::string mPackFile;
+    std::string mManifestKey;
+    uint64_t mSourceHash = 0;
+    bool mUpToDate = false;
+};
+
+struct CookStats
+{
+    uint32_t mNumCooked = 0;
+    uint32_t mNumSkipped = 0;
+    uint32_t mNumRemoved = 0;
+};
+
+class AssetCooker
+{
+public:
+
+    AssetCooker(Platform platform, const std::string& packagedDir);
+
+    // Fills outPackFiles with every asset's packaged file, including ones that were already up to date.
+    CookStats Cook(std::vector<std::pair<AssetStub*, std::string> >& outPackFiles);
+
+protected:
+
+    static ThreadFuncRet CookThreadFunc(void* in);
+
+    void GatherJobs(AssetDir* dir, bool engine);
+    void CookBatch(const std::vector<CookJob*>& batch);
+    uint64_t HashSource(AssetStub* stub) const;
+    void LoadManifest();
+    void SaveManifest();
+
+    Platform mPlatform = Platform::Count;
+    std::string mPackagedDir;
+    std::vector<CookJob> mJobs;
+    std::unordered_map<std::string, uint64_t> mManifest;
+
+    // Shared with the worker threads while a batch is cooking
+    const std::vector<CookJob*>* mBatch = nullptr;
+    uint32_t mNextBatchJob = 0;
+    MutexHandle mMutex = {};
+};
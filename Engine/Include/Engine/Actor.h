@@ -57,6 +57,10 @@ public:
 
     virtual ~Actor();
 
+    // Actor memory comes from ObjectPool. The destructor is virtual so delete passes the full object size.
+    static void* operator new(size_t size);
+    static void operator delete(void* object, size_t size);
+
     virtual void Create();
     virtual void Destroy();
     virtual void Tick(float deltaTime);
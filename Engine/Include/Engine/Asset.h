@@ -14,7 +14,13 @@ class Property;
 class AssetDir;
 
 #define ASSET_MAGIC_NUMBER 0x4f435421
-#define ASSET_CURRENT_VERSION 1
+#define ASSET_VERSION_BASE 1
+#define ASSET_VERSION_SOUNDWAVE_COMPRESSION 2
+#define ASSET_VERSION_LEVEL_RECORD_SIZE 3
+#define ASSET_VERSION_LEVEL_REPLICATED_FLAG 4
+#define ASSET_VERSION_STATIC_MESH_LODS 5
+#define ASSET_VERSION_TEXTURE_COMPRESSION 6
+#define ASSET_CURRENT_VERSION 6
 
 #define DECLARE_ASSET(Base, Parent) DECLARE_FACTORY(Base, Asset); DECLARE_RTTI(Base, Parent);
 #define DEFINE_ASSET(Base) DEFINE_FACTORY(Base, Asset); DEFINE_RTTI(Base);
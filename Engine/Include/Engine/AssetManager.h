@@ -15,6 +15,19 @@ class AssetDir;
 class Material;
 class ParticleSystem;
 
+// Discover() caches the header type of every .oct file it finds, keyed by path relative to the
+// discovered directory. Files whose modified time and size still match skip reading the header.
+#define ASSET_INDEX_FILE "AssetIndex.bin"
+#define ASSET_INDEX_MAGIC 0x4f435449
+#define ASSET_INDEX_VERSION 1
+
+struct AssetIndexEntry
+{
+    uint64_t mModifiedTime = 0;
+    uint64_t mSize = 0;
+    TypeId mType = INVALID_TYPE_ID;
+};
+
 struct AsyncLoadRequest
 {
     std::string mName;
@@ -122,6 +135,10 @@ protected:
 
     void UpdateEndLoadQueue();
 
+    std::string GetDiscoveryIndexPath(const std::string& dirPath) const;
+    void LoadDiscoveryIndex(const std::string& indexPath, std::unordered_map<std::string, AssetIndexEntry>& outIndex);
+    void SaveDiscoveryIndex(const std::string& indexPath, const std::unordered_map<std::string, AssetIndexEntry>& index);
+
     std::unordered_map<std::string, AssetStub*> mAssetMap;
     std::vector<Asset*> mTransientAssets;
     AssetDir* mRootDirectory = nullptr;
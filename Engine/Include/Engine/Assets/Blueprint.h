@@ -14,6 +14,25 @@ struct BlueprintComp
     std::vector<Property> mProperties;
 };
 
+// A single property write in an instantiation plan. The destination property is
+// rebased onto each new object by offset, so no names are compared while spawning.
+struct BlueprintPropWrite
+{
+    uint32_t mSrcIndex = 0;
+    uint32_t mOwnerOffset = 0;
+    uint32_t mDataOffset = 0;
+    Property mDstProp;
+};
+
+struct BlueprintObjectPlan
+{
+    std::vector<BlueprintPropWrite> mWrites;
+
+    // Set when a property's data doesn't live inside the object (e.g. script properties or vectors).
+    // These objects fall back to gathering and copying properties by name.
+    bool mGatherProperties = false;
+};
+
 class Blueprint : public Asset
 {
 public:
@@ -35,13 +54,25 @@ public:
     void Create(Actor* srcActor);
     Actor* Instantiate(World* world);
 
+    // Fill the actor/component object pools so the next count instantiations don't allocate.
+    void PrewarmPools(uint32_t count);
+
     const Property* GetActorProperty(const char* name);
     const Property* GetComponentProperty(int32_t index, const char* name);
 
 protected:
 
+    void CompileObjectPlan(BlueprintObjectPlan& plan, void* object, uint32_t objectSize, const std::vector<Property>& dstProps, const std::vector<Property>& srcProps);
+    void ApplyObjectPlan(BlueprintObjectPlan& plan, void* object, const std::vector<Property>& srcProps);
+    void InvalidatePlan();
+
     TypeId mActorType = INVALID_TYPE_ID;
     std::vector<Property> mActorProps;
     std::vector<BlueprintComp> mComponents;
     int32_t mRootComponentIndex = -1;
+
+    // Instantiation plan. Compiled the first time the blueprint is instantiated.
+    BlueprintObjectPlan mActorPlan;
+    std::vector<BlueprintObjectPlan> mComponentPlans;
+    bool mPlanCompiled = false;
 };
@@ -1,9 +1,36 @@
 #pragma once
 
 #include "Asset.h"
+#include "AssetRef.h"
+#include "Property.h"
 
 class World;
 class Actor;
+struct AsyncLoadRequest;
+
+// One actor entry of a level, split out of the level data when the level is loaded.
+// Blueprint refs and property overrides are resolved up front (on the async load thread
+// if the level is async loaded) so spawning only has to construct the actor.
+struct LevelActorRecord
+{
+    AssetRef mBlueprint;
+    std::vector<PropertyOverride> mOverrides;
+    TypeId mActorType = INVALID_TYPE_ID;
+    uint32_t mDataOffset = 0;
+    uint32_t mDataSize = 0;
+    bool mIsBlueprint = false;
+    bool mReplicated = false;
+};
+
+// Spawn progress of a level that is loaded into the world over multiple frames.
+struct LevelStreamState
+{
+    glm::mat4 mTransform = glm::mat4(1);
+    glm::vec3 mRotation = {};
+    uint32_t mNumActors = 0;
+    uint32_t mNextActor = 0;
+    uint32_t mStreamPos = 0;
+};
 
 class Level : public Asset
 {
@@ -31,13 +58,31 @@ public:
         glm::vec3 rotation = glm::vec3(0.0f, 0.0f, 0.0f));
     void UnloadFromWorld(World* world);
 
+    void BeginStreamIntoWorld(LevelStreamState& state, glm::vec3 offset, glm::vec3 rotation);
+
+    // Spawns actors until budgetMs has elapsed (at least one per call). A budget <= 0 spawns everything.
+    // Returns true once every actor has been spawned and the level has been added to the world.
+    bool StreamIntoWorld(World* world, LevelStreamState& state, float budgetMs);
+
     bool GetNetLoad() const;
 
 protected:
 
     bool ShouldSaveActor(Actor* actor) const;
+    void StageActorRecords(AsyncLoadRequest* request);
+    Actor* InstantiateRecord(World* world, const LevelActorRecord& record);
+    Actor* InstantiateFromStream(World* world, Stream& stream);
 
     bool mNetLoad = true;
 
+    // Levels saved before ASSET_VERSION_LEVEL_RECORD_SIZE don't store the size of native actor records,
+    // so their actors can't be staged and are read straight from mData while spawning.
+    bool mRecordSizes = false;
+
+    // Records store whether the actor is replicated, so clients can skip them without constructing them.
+    // The server spawns replicated actors on clients itself.
+    bool mReplicatedFlags = false;
+
     std::vector<uint8_t> mData;
+    std::vector<LevelActorRecord> mActorRecords;
 };
\ No newline at end of file
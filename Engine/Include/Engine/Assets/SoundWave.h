@@ -2,6 +2,14 @@
 
 #include "Asset.h"
 
+enum class SoundWaveFormat : uint8_t
+{
+    Pcm,
+    ImaAdpcm,
+
+    Count
+};
+
 class SoundWave : public Asset
 {
 public:
@@ -27,12 +35,20 @@ public:
     void SetPitchMultiplier(float pitch);
     float GetPitchMultiplier() const;
 
+    void SetCompress(bool compress);
+    bool GetCompress() const;
+
+    void SetStream(bool stream);
+    bool GetStream() const;
+
+    SoundWaveFormat GetWaveFormat() const;
     uint8_t* GetWaveData() const;
     uint32_t GetWaveDataSize() const;
     uint32_t GetNumChannels() const;
     uint32_t GetBitsPerSample() const;
     uint32_t GetSampleRate() const;
     uint32_t GetNumSamples() const;
+    uint32_t GetNumFrames() const;
     uint32_t GetBlockAlign() const;
     uint32_t GetByteRate() const;
 
@@ -42,10 +58,13 @@ protected:
 
     uint8_t* mWaveData = nullptr;
     uint32_t mWaveDataSize = 0;
+    SoundWaveFormat mWaveFormat = SoundWaveFormat::Pcm;
 
     // Properties
     float mVolumeMultiplier = 1.0f;
     float mPitchMultiplier = 1.0f;
+    bool mCompress = false;
+    bool mStream = false;
 
     // Soundwave Format
     uint32_t mNumChannels = 1;
@@ -14,6 +14,20 @@
 #include <assimp/scene.h>
 #endif
 
+// LOD 0 is the imported mesh. Lower LODs are generated by the quadric simplifier and reuse the LOD 0
+// vertex buffer, so each LOD is just another range of indices. A LOD is drawn once the mesh's projected
+// bounding sphere radius (as a fraction of half the screen height) drops below its screen size.
+#define MAX_MESH_LODS 4
+#define DEFAULT_LOD_REDUCTION 0.35f
+#define MIN_LOD_TRIANGLES 32
+
+struct StaticMeshLod
+{
+    uint32_t mFirstIndex = 0;
+    uint32_t mNumIndices = 0;
+    float mScreenSize = 1.0f;
+};
+
 class StaticMesh : public Asset
 {
 public:
@@ -64,6 +78,12 @@ public:
     void SetGenerateTriangleCollisionMesh(bool generate);
     uint32_t GetVertexSize() const;
 
+    uint32_t GetNumLods() const;
+    const StaticMeshLod& GetLod(uint32_t lod) const;
+    const std::vector<IndexType>& GetLodIndices() const;
+    uint32_t SelectLod(float screenSize) const;
+    void GenerateLods();
+
 private:
 
     void CreateTriangleCollisionShape(uint32_t numVertices,
@@ -86,6 +106,12 @@ private:
 
     Bounds mBounds;
 
+    StaticMeshLod mLods[MAX_MESH_LODS];
+    std::vector<IndexType> mLodIndices;
+    uint32_t mNumLods;
+    int32_t mMaxLods;
+    float mLodReduction;
+
     btCollisionShape* mCollisionShape;
     btBvhTriangleMeshShape* mTriangleCollisionShape;
     btTriangleIndexVertexArray* mTriangleIndexVertexArray;
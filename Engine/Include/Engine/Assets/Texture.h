@@ -41,6 +41,11 @@ public:
     PixelFormat GetFormat() const;
     FilterType GetFilterType() const;
     WrapMode GetWrapMode() const;
+    TextureCompression GetCompression() const;
+
+    // Format of the data held in mPixels. RGBA8 unless the texture was block compressed when cooked.
+    PixelFormat GetCookedFormat() const;
+    PixelFormat GetBlockFormat() const;
 
     static bool HandlePropChange(class Datum* datum, const void* newValue);
 
@@ -53,6 +58,8 @@ protected:
     PixelFormat mFormat;
     FilterType mFilterType;
     WrapMode mWrapMode;
+    TextureCompression mCompression;
+    PixelFormat mCookedFormat;
     bool mMipmapped;
     bool mRenderTarget;
 
@@ -36,4 +36,13 @@ public:
     static void StopComponent(AudioComponent* comp);
     static void StopSounds(SoundWave* soundWave);
     static void StopAllSounds();
+
+    // Playing components are kept in a spatial grid so Update() only has to consider
+    // components near the listener when promoting virtual voices to real ones.
+    static void TrackComponent(AudioComponent* comp);
+    static void UntrackComponent(AudioComponent* comp);
+    static void UpdateComponentBounds(AudioComponent* comp);
+
+    static uint32_t GetNumRealVoices();
+    static uint32_t GetNumVirtualVoices();
 };
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "Graphics/GraphicsTypes.h"
+
+// CPU encoders for the BCn block formats used by the desktop Vulkan path. Textures are compressed
+// when cooking for Windows/Linux so that the runtime can upload the blocks (and mips) directly.
+// Every format works on 4x4 pixel blocks of RGBA8 input, edge pixels are replicated for sizes
+// that aren't a multiple of 4.
+//   BC1: RGB (+1 bit alpha) at 4 bpp, endpoints picked along the principal axis.
+//   BC3: BC1 color + BC4 alpha at 8 bpp.
+//   BC5: two BC4 channels (R/G) at 8 bpp, meant for normal maps.
+//   BC7: Mode 6 only (single subset RGBA, 7.7.7.7 + pbit endpoints, 4 bit indices) at 8 bpp.
+
+#define BC_BLOCK_DIM 4
+
+bool BC_IsBlockFormat(PixelFormat format);
+uint32_t BC_GetBlockSize(PixelFormat format);
+uint32_t BC_GetCompressedSize(PixelFormat format, uint32_t width, uint32_t height);
+
+// Compresses a whole RGBA8 image and appends the blocks to outData.
+void BC_CompressImage(PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outData);
+
+// Box filters an RGBA8 image down to the next mip level.
+void BC_DownsampleImage(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outPixels);
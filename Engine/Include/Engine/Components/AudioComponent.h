@@ -20,6 +20,7 @@ public:
     virtual void Create() override;
     virtual void Destroy() override;
     virtual void Tick(float deltaTime) override;
+    virtual void UpdateTransform(bool updateChildren) override;
 
     virtual void SaveStream(Stream& stream) override;
     virtual void LoadStream(Stream& stream) override;
@@ -27,6 +27,9 @@ public:
     Component();
     virtual ~Component();
 
+    static void* operator new(size_t size);
+    static void operator delete(void* object, size_t size);
+
     virtual void Create();
     virtual void Destroy();
     
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "LightComponent.h"
+#include "Constants.h"
+
+class CameraComponent;
+class CameraFrustum;
 
 class DirectionalLightComponent : public LightComponent
 {
@@ -28,12 +32,20 @@ public:
     const glm::vec3& GetDirection() const;
     void SetDirection(const glm::vec3& dir);
 
-    const glm::mat4& GetViewProjectionMatrix() const;
+    // Fits one orthographic projection around each slice of the camera frustum.
+    void UpdateShadowCascades(CameraComponent* camera);
 
-protected:
+    const glm::mat4& GetCascadeViewProjectionMatrix(uint32_t cascade) const;
+    float GetCascadeSplit(uint32_t cascade) const;
+    void GetCascadeFrustum(uint32_t cascade, CameraFrustum& outFrustum) const;
 
-    void GenerateViewProjectionMatrix();
+protected:
 
     glm::vec3 mDirection;
-    glm::mat4 mViewProjectionMatrix;
+    glm::mat4 mCascadeMatrices[SHADOW_CASCADE_COUNT];
+    glm::vec3 mCascadeCenters[SHADOW_CASCADE_COUNT];
+    float mCascadeRadii[SHADOW_CASCADE_COUNT] = {};
+    float mCascadeSplits[SHADOW_CASCADE_COUNT] = {};
+    glm::vec3 mLightRight;
+    glm::vec3 mLightUp;
 };
\ No newline at end of file
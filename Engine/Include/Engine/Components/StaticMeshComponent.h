@@ -36,6 +36,10 @@ public:
     void SetUseTriangleCollision(bool triangleCol);
     bool GetUseTriangleCollision() const;
 
+    // Picked by the Renderer every frame from the mesh's projected size.
+    void SetLod(uint32_t lod);
+    uint32_t GetLod() const;
+
     virtual Material* GetMaterial() override;
     virtual void Render() override;
 
@@ -51,6 +55,7 @@ protected:
 
     StaticMeshRef mStaticMesh;
     bool mUseTriangleCollision;
+    uint32_t mLod = 0;
 
     // Graphics Resource
     StaticMeshCompResource mResource;
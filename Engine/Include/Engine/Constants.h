@@ -17,14 +17,18 @@
 
 #define DEFAULT_TEXTURE_SIZE 4
 #define MATERIAL_MAX_TEXTURES 4
-#define MAX_POINTLIGHTS 7
+#define MAX_POINTLIGHTS 256
 #define MAX_BONE_INFLUENCES 4
 #define MAX_BONES 128
 #define MAX_COLLISION_SHAPES 16
 #define MAX_UV_MAPS 2
 
+// The shadow map is split into a 2x2 grid, one cell per cascade.
 #define SHADOW_MAP_RESOLUTION 2048
-#define SHADOW_RANGE 50.0f
+#define SHADOW_CASCADE_COUNT 4
+#define SHADOW_CASCADE_RESOLUTION (SHADOW_MAP_RESOLUTION / 2)
+#define SHADOW_DISTANCE 100.0f
+#define SHADOW_CASCADE_SPLIT_LAMBDA 0.75f
 #define SHADOW_RANGE_Z 400.0f
 
 #define LOGGING_ENABLED 1
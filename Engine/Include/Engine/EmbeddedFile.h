@@ -2,6 +2,10 @@
 
 #include <stdint.h>
 
+// Embedded builds pack every asset into one blob (see ActionManager::GenerateEmbeddedAssetFiles).
+// mData points into that blob, and each asset starts on this alignment.
+#define EMBEDDED_ASSET_ALIGNMENT 32
+
 struct EmbeddedFile
 {
     const char* mName;
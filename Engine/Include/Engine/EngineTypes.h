@@ -183,6 +183,7 @@ struct CommandLineOptions
 {
     std::string mProjectPath;
     std::string mDefaultLevel;
+    std::string mCookPlatform;
 };
 
 enum class ConsoleMode
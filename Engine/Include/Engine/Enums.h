@@ -15,7 +15,8 @@ enum TextureSlot
 enum GlobalDescriptor
 {
     GLD_UNIFORM_BUFFER,
-    GLD_SHADOW_MAP
+    GLD_SHADOW_MAP,
+    GLD_CLUSTER_LIGHTS
 };
 
 enum GeometryDescriptor
@@ -81,6 +81,11 @@ public:
         return "Class";
     }
 
+    virtual uint32_t GetClassSize() const
+    {
+        return 0;
+    }
+
 protected:
     TypeId mType = 0;
 };
@@ -100,6 +105,7 @@ protected:
         Factory_##Class() { mType = BaseClass::RegisterFactory(this, TypeMod); } \
         virtual void* Create() override { return new Class(); } \
         virtual const char* GetClassName() const override { return #Class; } \
+        virtual uint32_t GetClassSize() const override { return uint32_t(sizeof(Class)); } \
     }; \
     static Factory_##Class sFactory_##Class; \
     TypeId Class::GetType() const { return sFactory_##Class.GetType(); } \
@@ -107,3 +113,19 @@ protected:
     TypeId Class::GetStaticType() { return sFactory_##Class.GetType(); }
 
 #define DEFINE_FACTORY(Class, BaseClass) DEFINE_FACTORY_EX(Class, BaseClass, 0)
+
+inline uint32_t FindFactoryClassSize(const std::vector<Factory*>& factoryList, TypeId type)
+{
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < factoryList.size(); ++i)
+    {
+        if (factoryList[i]->GetType() == type)
+        {
+            size = factoryList[i]->GetClassSize();
+            break;
+        }
+    }
+
+    return size;
+}
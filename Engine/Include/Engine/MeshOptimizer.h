@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Graphics/GraphicsTypes.h"
+
+// Import-time mesh optimization. Triangles are first reordered for the post-transform vertex cache
+// (Forsyth's linear-speed algorithm), then cache-friendly runs of triangles are sorted so that outward
+// facing clusters are drawn first to cut down on overdraw, and finally the vertex buffer is reordered
+// to match the order in which the index buffer first touches each vertex.
+
+#define MESH_OPT_CACHE_SIZE 32
+#define MESH_OPT_ACMR_CACHE_SIZE 16
+
+// Clusters are cut whenever the running ACMR exceeds the whole-mesh ACMR times this threshold,
+// so overdraw sorting only gives up a small amount of the vertex cache efficiency.
+#define MESH_OPT_OVERDRAW_THRESHOLD 1.05f
+
+struct MeshOptimizeStats
+{
+    float mAcmrBefore = 0.0f;
+    float mAcmrAfter = 0.0f;
+};
+
+// Average number of vertex shader invocations per triangle, simulated with a FIFO cache.
+float MeshOpt_ComputeAcmr(const IndexType* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize = MESH_OPT_ACMR_CACHE_SIZE);
+
+void MeshOpt_OptimizeVertexCache(IndexType* indices, uint32_t numIndices, uint32_t numVertices);
+
+// positions points at the first vertex position, positionStride is the size of a whole vertex in bytes.
+void MeshOpt_OptimizeOverdraw(IndexType* indices, uint32_t numIndices, const uint8_t* positions, uint32_t positionStride, uint32_t numVertices);
+
+// Reorders vertices in first-use order and rewrites the indices to match. Unreferenced vertices are
+// dropped, so the returned vertex count may be smaller than numVertices.
+uint32_t MeshOpt_OptimizeVertexFetch(uint8_t* vertices, uint32_t vertexSize, uint32_t numVertices, IndexType* indices, uint32_t numIndices);
+
+// Quadric error edge collapse (Garland-Heckbert). Vertices are only ever collapsed onto other existing
+// vertices, so the simplified indices can share the original vertex buffer. Vertices on open borders and
+// on attribute seams (several vertices at the same position) are locked to avoid cracks and UV smearing.
+// Simplifies indices in place and returns the new index count, which may stay above targetIndexCount
+// if the mesh can't be reduced any further.
+uint32_t MeshOpt_Simplify(IndexType* indices, uint32_t numIndices, const uint8_t* positions, uint32_t positionStride, uint32_t numVertices, uint32_t targetIndexCount);
+
+// Runs the cache, overdraw and fetch passes. Returns the new vertex count.
+uint32_t MeshOpt_OptimizeMesh(
+    uint8_t* vertices,
+    uint32_t vertexSize,
+    uint32_t positionOffset,
+    uint32_t numVertices,
+    IndexType* indices,
+    uint32_t numIndices,
+    MeshOptimizeStats* outStats = nullptr);
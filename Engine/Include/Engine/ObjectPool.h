@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Free-list pools for actor and component memory. Blocks are grouped by size class and carved out of
+// larger slabs so that spawning and destroying lots of short lived actors (projectiles, pickups, effects)
+// doesn't hit the general heap every time. Freed blocks are only recycled, never returned to the system,
+// until Shutdown(). Only the memory is pooled: constructors and destructors still run normally, so every
+// object starts from a fresh default state. Not thread safe, objects should be created on the main thread.
+
+#define OBJECT_POOL_ALIGNMENT 16
+#define OBJECT_POOL_SLAB_OBJECTS 32
+
+class ObjectPool
+{
+public:
+
+    static void* Alloc(size_t size);
+    static void Free(void* object, size_t size);
+
+    // Make sure at least count blocks of the given size are sitting in the free list.
+    static void Prewarm(size_t size, uint32_t count);
+
+    static void Shutdown();
+
+    static uint32_t GetNumFreeObjects(size_t size);
+    static uint32_t GetNumLiveObjects();
+};
@@ -19,12 +19,20 @@ struct CpuStat
     float mSmoothedTime = 0.0f;
 };
 
-//struct GpuStat
-//{
-//    const char mName[STAT_NAME_BUFFER_LENGTH] = {};
-//    float mTime = 0.0f;
-//    float mSmoothedTime = 0.0f;
-//};
+struct AllocStats
+{
+    uint32_t mObjectAllocs = 0;
+    uint32_t mObjectFrees = 0;
+    uint32_t mPoolMisses = 0;
+};
+
+// GPU times are measured by the graphics backend and arrive a few frames late.
+struct GpuStat
+{
+    char mName[STAT_NAME_BUFFER_LENGTH] = {};
+    float mTime = 0.0f;
+    float mSmoothedTime = 0.0f;
+};
 
 class Profiler
 {
@@ -36,16 +44,28 @@ public:
     void BeginCpuStat(const char* name);
     void EndCpuStat(const char* name);
 
-    //void BeginGpuStat(const char* name);
-    //void EndGpuStat();
+    void BeginGpuStat(const char* name);
+    void EndGpuStat();
 
     CpuStat* FindCpuStat(const char* name);
     const std::vector<CpuStat>& GetCpuStats() const;
 
+    // Called by the graphics backend when a GPU stat's timestamps have been read back.
+    void AddGpuStatTime(const char* name, float time);
+    GpuStat* FindGpuStat(const char* name);
+    const std::vector<GpuStat>& GetGpuStats() const;
+
+    // Counts pooled actor/component allocations. A miss means the pool had to grab a new slab.
+    void RecordObjectAlloc(bool poolMiss);
+    void RecordObjectFree();
+    const AllocStats& GetAllocStats() const;
+
 protected:
 
     std::vector<CpuStat> mCpuStats;
-    //std::vector<GpuStat> mGpuStats;
+    AllocStats mAllocStats;
+    AllocStats mFrameAllocStats;
+    std::vector<GpuStat> mGpuStats;
 };
 
 void CreateProfiler();
@@ -68,12 +88,31 @@ struct ScopedCpuStat
     char mName[STAT_NAME_BUFFER_LENGTH] = {};
 };
 
+struct ScopedGpuStat
+{
+    ScopedGpuStat(const char* name)
+    {
+        GetProfiler()->BeginGpuStat(name);
+    }
+
+    ~ScopedGpuStat()
+    {
+        GetProfiler()->EndGpuStat();
+    }
+};
+
 #if PROFILING_ENABLED
 #define SCOPED_CPU_STAT(name) ScopedCpuStat scopedStat##__LINE__(name);
 #define BEGIN_CPU_STAT(name) GetProfiler()->BeginCpuStat(name);
 #define END_CPU_STAT(name) GetProfiler()->EndCpuStat(name);
+#define SCOPED_GPU_STAT(name) ScopedGpuStat scopedGpuStat##__LINE__(name);
+#define BEGIN_GPU_STAT(name) GetProfiler()->BeginGpuStat(name);
+#define END_GPU_STAT() GetProfiler()->EndGpuStat();
 #else
 #define SCOPED_CPU_STAT(name) 
 #define BEGIN_CPU_STAT(name) 
 #define END_CPU_STAT(name) 
+#define SCOPED_GPU_STAT(name) 
+#define BEGIN_GPU_STAT(name) 
+#define END_GPU_STAT() 
 #endif
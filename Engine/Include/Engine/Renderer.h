@@ -18,6 +18,8 @@ class Widget;
 class Console;
 class StatsOverlay;
 class CameraFrustum;
+class StaticMeshComponent;
+class DirectionalLightComponent;
 
 struct EngineState;
 
@@ -74,6 +76,9 @@ public:
     void EnableFrustumCulling(bool enable);
     bool IsFrustumCullingEnabled() const;
 
+    void EnableMeshLods(bool enable);
+    bool AreMeshLodsEnabled() const;
+
     Texture* GetBlackTexture();
     Material* GetDefaultMaterial();
 
@@ -125,8 +130,10 @@ private:
     void RenderDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId);
     void RenderDebugDraws(const std::vector<DebugDraw>& draws, PipelineId pipelineId = PipelineId::Count);
     void FrustumCull(CameraComponent* camera);
+    void ShadowCull(DirectionalLightComponent* dirLight);
     int32_t FrustumCullDraws(const CameraFrustum& frustum, std::vector<DrawData>& drawData);
     int32_t FrustumCullDraws(const CameraFrustum& frustum, std::vector<DebugDraw>& drawData);
+    void SelectMeshLod(StaticMeshComponent* comp, CameraComponent* camera);
 
     void RenderShadowCasters(World* world);
     void RenderSelectedGeometry(World* world);
@@ -145,6 +152,7 @@ private:
     bool mInitialized = false;
 
     std::vector<DrawData> mShadowDraws;
+    std::vector<DrawData> mShadowCascadeDraws[SHADOW_CASCADE_COUNT];
     std::vector<DrawData> mOpaqueDraws;
     std::vector<DrawData> mSimpleShadowDraws;
     std::vector<DrawData> mPostShadowOpaqueDraws; // (post-simple-shadow opaques. not talking about shadow mapping)
@@ -161,6 +169,7 @@ private:
     DebugMode mDebugMode = DEBUG_NONE;
     BoundsDebugMode mBoundsDebugMode = BoundsDebugMode::Off;
     bool mFrustumCulling = true;
+    bool mMeshLods = true;
     bool mEnableProxyRendering = false;
     bool mInModalWidgetUpdate = false;
 };
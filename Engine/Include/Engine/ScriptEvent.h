@@ -21,4 +21,7 @@ struct ScriptEvent
     static void NetReject(std::string& tableName, std::string& funcName, NetMsgReject::Reason reason);
     static void NetDisconnect(std::string& tableName, std::string& funcName, const NetClient& client);
     static void NetKick(std::string& tableName, std::string& funcName, NetMsgKick::Reason reason);
+
+    // World
+    static void LevelStreamed(std::string& tableName, std::string& funcName, const std::string& levelName);
 };
@@ -32,6 +32,7 @@ public:
     void WriteFile(const char* path);
 
     void SetAsyncRequest(AsyncLoadRequest* request);
+    AsyncLoadRequest* GetAsyncRequest();
 
     void ReadAsset(AssetRef& asset);
     void WriteAsset(const AssetRef& asset);
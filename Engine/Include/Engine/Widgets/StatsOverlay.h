@@ -11,6 +11,7 @@ enum class StatDisplayMode
     CpuStatBars,
     Memory,
     Network,
+    Audio,
 
     Count
 };
@@ -57,7 +57,7 @@ public:
     virtual void Render();
 
     // Refresh any data used for rendering based on this widget's state. Use dirty flag.
-    // Recursively update children.
+    // Recursively update children. Only dirty and animated widgets (and their ancestors) are visited.
     void RecursiveUpdate();
     virtual void Update();
 
@@ -139,6 +139,12 @@ public:
     void MarkDirty();
     bool IsDirty() const;
 
+    // Animated widgets have Update() called every frame, even when they aren't dirty.
+    // Use this for widgets that poll input or other state in Update().
+    void SetAnimated(bool animated);
+    bool IsAnimated() const;
+    bool NeedsUpdate() const;
+
     static float InterfaceToNormalized(float interfaceCoord, float interfaceSize);
     static bool IsMouseInside(Rect rect);
 
@@ -200,7 +206,14 @@ protected:
     bool mUseScissor;
     bool mVisible;
     bool mScriptOwned;
+    bool mAnimated;
 
 private:
+
+    void MarkSubtreeDirty();
+    void MarkAncestorsDirty();
+
     bool mDirty[MAX_FRAMES] = {};
+    bool mChildDirty[MAX_FRAMES] = {};
+    bool mSubtreeAnimated = false;
 };
@@ -2,18 +2,21 @@
 
 #include <string>
 #include <vector>
+#include <list>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "Assets/StaticMesh.h"
 #include "Assets/Material.h"
 #include "Assets/Texture.h"
+#include "Assets/Level.h"
 #include "Actor.h"
 #include "Clock.h"
 #include "Line.h"
 #include "EngineTypes.h"
 #include "Components/CameraComponent.h"
 #include "Components/DirectionalLightComponent.h"
+#include "ScriptableFuncPointer.h"
 
 class Component;
 class AudioComponent;
@@ -25,6 +28,22 @@ struct QueuedLevel
     glm::vec3 mRotation = {};
 };
 
+// The level ref is the async load's target, so it holds the level from the moment the load finishes.
+// Streaming levels are kept in a list because the pending load keeps a pointer to that ref.
+struct StreamingLevel
+{
+    std::string mName;
+    LevelRef mLevel;
+    glm::vec3 mOffset = {};
+    glm::vec3 mRotation = {};
+    LevelStreamState mState;
+    bool mStarted = false;
+};
+
+typedef void(*LevelStreamedFP)(Level*);
+
+#define DEFAULT_LEVEL_STREAM_BUDGET_MS 2.0f
+
 class World
 {
 public:
@@ -116,6 +135,12 @@ public:
     void UnloadAllLevels();
 
     Actor* SpawnBlueprint(const char* name);
+
+    // Reserve pooled memory ahead of time for actors that get spawned and destroyed frequently.
+    void PrewarmActorPool(TypeId actorType, uint32_t count);
+    void PrewarmActorPool(const char* typeName, uint32_t count);
+    void PrewarmBlueprintPool(const char* name, uint32_t count);
+
     void LoadLevel(
         const char* name,
         glm::vec3 offset = { 0.0f, 0.0f, 0.0f },
@@ -127,6 +152,20 @@ public:
         glm::vec3 rotation = { 0.0f, 0.0f, 0.0f });
     void UnloadLevel(const char* name);
 
+    // Async loads the level on the asset thread, then spawns its actors over several frames,
+    // spending at most the level stream budget each frame.
+    void StreamLevel(
+        const char* name,
+        glm::vec3 offset = { 0.0f, 0.0f, 0.0f },
+        glm::vec3 rotation = { 0.0f, 0.0f, 0.0f });
+    bool IsStreamingLevels() const;
+    float GetLevelStreamProgress() const;
+    void SetLevelStreamBudget(float budgetMs);
+    float GetLevelStreamBudget() const;
+
+    void SetLevelStreamedCallback(LevelStreamedFP cb) { mLevelStreamedCallback.mFuncPointer = cb; }
+    void SetScriptLevelStreamedCallback(const char* tableName, const char* funcName) { mLevelStreamedCallback.mScriptTableName = tableName; mLevelStreamedCallback.mScriptFuncName = funcName; }
+
     void EnableInternalEdgeSmoothing(bool enable);
     bool IsInternalEdgeSmoothingEnabled() const;
 
@@ -159,6 +198,8 @@ private:
     void UpdateLines(float deltaTime);
     void SetTestDirectionalLight();
     void SpawnDefaultCamera();
+    void UpdateLevelStreaming();
+    void CancelStreamingLevel(StreamingLevel& streamingLevel);
 
 private:
 
@@ -169,6 +210,9 @@ private:
     std::vector<class AudioComponent*> mAudioComponents;
     std::vector<LevelRef> mLoadedLevels;
     std::vector<QueuedLevel> mQueuedLevels;
+    std::list<StreamingLevel> mStreamingLevels;
+    float mLevelStreamBudget = DEFAULT_LEVEL_STREAM_BUDGET_MS;
+    ScriptableFP<LevelStreamedFP> mLevelStreamedCallback;
     DirectionalLightComponent* mDirectionalLight;
     glm::vec4 mAmbientLightColor;
     glm::vec4 mShadowColor;
@@ -21,6 +21,7 @@ class Quad;
 class Text;
 
 struct FogSettings;
+struct DrawData;
 
 void GFX_Initialize();
 void GFX_Shutdown();
@@ -36,6 +37,7 @@ void GFX_BindPipeline(PipelineId pipelineId, VertexType vertexType = VertexType:
 
 void GFX_SetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
 void GFX_SetScissor(int32_t x, int32_t y, int32_t width, int32_t height);
+void GFX_SetShadowCascade(uint32_t cascade);
 glm::mat4 GFX_MakePerspectiveMatrix(float fovyDegrees, float aspectRatio, float zNear, float zFar);
 glm::mat4 GFX_MakeOrthographicMatrix(float left, float right, float bottom, float top, float zNear, float zFar);
 
@@ -44,11 +46,20 @@ void GFX_SetFog(const FogSettings& fogSettings);
 void GFX_DrawLines(const std::vector<Line>& lines);
 void GFX_DrawFullscreen();
 
+// Renders each draw's component, binding pipelineId first unless it is PipelineId::Count.
+// The backend may call PrimitiveComponent::Render() from worker threads.
+void GFX_RenderDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId = PipelineId::Count);
+
 void GFX_ResizeWindow();
 Actor* GFX_ProcessHitCheck(World* world, int32_t x, int32_t y);
 uint32_t GFX_GetNumViews();
 
 void GFX_SetFrameRate(int32_t frameRate);
+void GFX_GetMemoryStats(GpuMemoryStats& outStats);
+
+// Times the GPU work recorded between the calls. Results are reported through Profiler::AddGpuStatTime().
+void GFX_BeginGpuStat(const char* name);
+void GFX_EndGpuStat();
 
 // Texture
 void GFX_CreateTextureResource(Texture* texture, std::vector<uint8_t>& data);
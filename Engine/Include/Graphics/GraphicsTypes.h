@@ -53,6 +53,11 @@ enum class PixelFormat
     Depth16,
     Depth32F,
 
+    BC1,
+    BC3,
+    BC5,
+    BC7,
+
     Count
 };
 
@@ -74,8 +79,9 @@ enum class PipelineId
     Line,
     PostProcess,
     NullPostProcess,
-    Quad,
-    Text,
+    Ui,
+    OpaqueIndirect,
+    ShadowIndirect,
 
     HitCheck,
 
@@ -111,6 +117,18 @@ enum class WrapMode
     Count
 };
 
+enum class TextureCompression
+{
+    None,
+    Auto,
+    BC1,
+    BC3,
+    BC5,
+    BC7,
+
+    Count
+};
+
 #if API_VULKAN
 typedef uint32_t IndexType;
 #else
@@ -121,6 +139,7 @@ struct TextureResource
 {
 #if API_VULKAN
     Image* mImage = nullptr;
+    uint32_t mBindlessIndex = BINDLESS_INVALID_INDEX;
 #elif API_GX
     GXTexObj mGxTexObj = {};
     TPLFile mTplFile = {};
@@ -134,16 +153,37 @@ struct TextureResource
 struct MaterialResource
 {
 #if API_VULKAN
+    // Without bindless support. With it, the material's parameters live in the bindless material buffer.
     DescriptorSet* mDescriptorSet = nullptr;
     UniformBuffer* mUniformBuffer = nullptr;
+    uint32_t mBindlessIndex = BINDLESS_INVALID_INDEX;
 #endif
 };
 
+#if API_VULKAN
+// Location of a static mesh inside the shared MeshPool buffers, in vertices and indices.
+struct MeshPoolAlloc
+{
+    int32_t mVertexNode = -1;
+    int32_t mIndexNode = -1;
+    uint32_t mVertexOffset = 0;
+    uint32_t mFirstIndex = 0;
+    bool mVertexColor = false;
+
+    bool IsValid() const
+    {
+        return mVertexNode != -1;
+    }
+};
+#endif
+
 struct StaticMeshResource
 {
 #if API_VULKAN
+    // Only set when the mesh didn't fit in the MeshPool.
     Buffer* mVertexBuffer = nullptr;
     Buffer* mIndexBuffer = nullptr;
+    MeshPoolAlloc mPoolAlloc;
 #elif API_GX
     void* mDisplayList = nullptr;
     uint32_t mDisplayListSize = 0;
@@ -164,19 +204,43 @@ struct SkeletalMeshResource
 #endif
 };
 
+// GPU memory usage reported by the backend for the stats overlay.
+struct GpuMemoryStats
+{
+    uint64_t mUsedBytes = 0;
+    uint64_t mReservedBytes = 0;
+    uint64_t mHostVisibleBytes = 0;
+    uint32_t mNumAllocations = 0;
+    uint32_t mNumDedicated = 0;
+    uint32_t mNumBlocks = 0;
+    float mFragmentation = 0.0f; // 1 - (largest free range / total free), 0 when there is nothing free
+};
+
+#if API_VULKAN
+// Location of a component's geometry uniforms inside the frame's UniformRingBuffer.
+struct UniformRingAlloc
+{
+    uint32_t mBlock = 0;
+    uint32_t mOffset = 0;
+    uint32_t mGeneration = 0;
+};
+#endif
+
 struct StaticMeshCompResource
 {
 #if API_VULKAN
-    DescriptorSet* mDescriptorSet = nullptr;
-    UniformBuffer* mUniformBuffer = nullptr;
+    UniformRingAlloc mGeometryAlloc;
+
+    // Slot of the component's data in the frame's indirect draw buffer, valid while the generation matches.
+    uint32_t mIndirectDrawIndex = 0;
+    uint32_t mIndirectGeneration = 0;
 #endif
 };
 
 struct SkeletalMeshCompResource
 {
 #if API_VULKAN
-    DescriptorSet* mDescriptorSet = nullptr;
-    UniformBuffer* mUniformBuffer = nullptr;
+    UniformRingAlloc mGeometryAlloc;
     Buffer* mVertexBuffer = nullptr;
 #elif API_C3D
     DoubleBuffer mVertexData;
@@ -185,23 +249,14 @@ struct SkeletalMeshCompResource
 
 struct QuadResource
 {
-#if API_VULKAN
-    Buffer* mVertexBuffer = nullptr;
-    UniformBuffer* mUniformBuffer = nullptr;
-    DescriptorSet* mDescriptorSet = nullptr;
-#elif API_C3D
+#if API_C3D
     DoubleBuffer mVertexData;
 #endif
 };
 
 struct TextResource
 {
-#if API_VULKAN
-    Buffer* mVertexBuffer = nullptr;
-    UniformBuffer* mUniformBuffer = nullptr;
-    DescriptorSet* mDescriptorSet = nullptr;
-    uint32_t mNumBufferCharsAllocated = 0;
-#elif API_C3D
+#if API_C3D
     DoubleBuffer mVertexData;
     uint32_t mNumBufferCharsAllocated = 0;
 #endif
@@ -210,8 +265,7 @@ struct TextResource
 struct ParticleCompResource
 {
 #if API_VULKAN
-    DescriptorSet* mDescriptorSet = nullptr;
-    UniformBuffer* mUniformBuffer = nullptr;
+    UniformRingAlloc mGeometryAlloc;
     Buffer* mVertexBuffer = nullptr;
     Buffer* mIndexBuffer = nullptr;
     uint32_t mNumVerticesAllocated = 0;
@@ -5,22 +5,38 @@
 #include <vulkan/vulkan.h>
 #include <vector>
 
+// Device memory is suballocated from large blocks using a two-level segregated fit (TLSF) allocator.
+// Free ranges are kept in size class free lists. The first level splits sizes by power of two and
+// the second level splits each power of two linearly. A bitmap per level makes finding a large
+// enough free range O(1), and freeing merges with the physical neighbors in O(1).
+// Allocations at or above ALLOCATOR_DEDICATED_THRESHOLD get their own VkDeviceMemory.
+
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_MIN_LOG2 8 // Sizes below 256 bytes all share first level 0
+#define TLSF_FL_COUNT (64 - TLSF_FL_MIN_LOG2 + 1)
+#define TLSF_MIN_ALIGNMENT 16
+#define ALLOCATOR_DEDICATED_THRESHOLD (8 * 1024 * 1024)
+#define ALLOCATOR_ALL_MEMORY_TYPES 0xffffffff
+
+struct MemoryBlock;
+
 struct Allocation
 {
     VkDeviceMemory mDeviceMemory;
     uint32_t mType;
-    int64_t mID;
     VkDeviceSize mSize;
     VkDeviceSize mOffset;
-    VkDeviceSize mPaddedSize;
+    MemoryBlock* mBlock; // nullptr for dedicated allocations
+    int32_t mNode;
 
     Allocation() :
         mDeviceMemory(VK_NULL_HANDLE),
         mType(0),
-        mID(-1),
         mSize(0),
         mOffset(0),
-        mPaddedSize(0)
+        mBlock(nullptr),
+        mNode(-1)
     {
 
     }
@@ -31,44 +47,64 @@ struct Allocation
     }
 };
 
-struct MemoryChunk
+struct MemoryNode
 {
-    int64_t mID;
-    uint64_t mOffset;
-    uint64_t mSize;
-    bool mFree;
-
-    MemoryChunk() :
-        mID(-1),
-        mOffset(0),
-        mSize(0),
-        mFree(true)
-    {
-
-    }
+    VkDeviceSize mOffset = 0;
+    VkDeviceSize mSize = 0;
+    int32_t mPrevPhysical = -1;
+    int32_t mNextPhysical = -1;
+    int32_t mPrevFree = -1;
+    int32_t mNextFree = -1;
+    bool mFree = false;
 };
 
 struct MemoryBlock
 {
-    MemoryChunk* AllocateChunk(uint64_t size);
-    bool FreeChunk(int64_t id);
+    void Init(VkDeviceSize size);
+    int32_t AllocateNode(VkDeviceSize size, VkDeviceSize alignment);
+    void FreeNode(int32_t node);
 
     MemoryBlock() :
-        mDeviceMemory(0),
+        mDeviceMemory(VK_NULL_HANDLE),
         mSize(0),
-        mAvailableMemory(0),
-        mLargestChunk(0),
-        mMemoryType(0)
+        mUsedBytes(0),
+        mNumAllocations(0),
+        mMemoryType(0),
+        mFlBitmap(0)
     {
-        
+
     }
 
-    std::vector<MemoryChunk> mChunks;
+    std::vector<MemoryNode> mNodes;
+    std::vector<int32_t> mUnusedNodes;
     VkDeviceMemory mDeviceMemory;
-    uint64_t mSize;
-    uint64_t mAvailableMemory;
-    uint64_t mLargestChunk;
+    VkDeviceSize mSize;
+    VkDeviceSize mUsedBytes;
+    uint32_t mNumAllocations;
     uint32_t mMemoryType;
+
+    uint64_t mFlBitmap;
+    uint32_t mSlBitmaps[TLSF_FL_COUNT];
+    int32_t mFreeHeads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+private:
+
+    int32_t NewNode();
+    void ReleaseNode(int32_t node);
+    void InsertFree(int32_t node);
+    void RemoveFree(int32_t node);
+    int32_t FindFree(uint32_t fl, uint32_t sl) const;
+};
+
+struct AllocatorStats
+{
+    uint32_t mNumBlocks = 0;
+    uint32_t mNumAllocations = 0;
+    uint32_t mNumDedicated = 0;
+    uint32_t mNumFreeRanges = 0;
+    uint64_t mReservedBytes = 0; // Block memory + dedicated memory
+    uint64_t mUsedBytes = 0;
+    uint64_t mLargestFreeRange = 0;
 };
 
 class Allocator
@@ -82,17 +118,21 @@ public:
     static uint64_t GetNumAllocations();
     static uint64_t GetNumAllocatedBytes();
 
+    static void GetStats(AllocatorStats& outStats, uint32_t memoryType = ALLOCATOR_ALL_MEMORY_TYPES);
+    static void LogStats();
+
     static const uint64_t sDefaultBlockSize;
 
 private:
 
     static MemoryBlock* AllocateBlock(uint64_t newBlockSize, uint32_t memoryType);
-    static void FreeBlock(MemoryBlock& block);
-
+    static void FreeBlock(MemoryBlock* block);
 
-    static std::vector<MemoryBlock> sBlocks;
+    static std::vector<MemoryBlock*> sBlocks;
     static uint64_t sNumAllocations;
     static uint64_t sNumAllocatedBytes;
+    static uint32_t sNumDedicated[VK_MAX_MEMORY_TYPES];
+    static uint64_t sDedicatedBytes[VK_MAX_MEMORY_TYPES];
 };
 
-#endif
\ No newline at end of file
+#endif
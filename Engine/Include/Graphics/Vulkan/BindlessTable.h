@@ -0,0 +1,59 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Vulkan/VulkanConstants.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <stdint.h>
+
+class Image;
+class UniformBuffer;
+struct MaterialData;
+
+// Owns the descriptor set that bindless pipelines bind at the material set index. Binding 0 is a storage
+// buffer holding every material's MaterialData and binding 1 is an array of every texture's image.
+// There is one set and one material buffer per frame in flight. Texture slots are written into all of
+// the sets right away, which is allowed because the binding is UPDATE_UNUSED_WHILE_PENDING and a slot
+// is only reused after the frames that may have sampled it have finished. Material slots are written
+// into the current frame's buffer when the material is dirty for that frame.
+
+class BindlessTable
+{
+public:
+
+    void Create(VkDescriptorSetLayout layout);
+    void Destroy();
+
+    // Recycles the slots freed MAX_FRAMES frames ago. Called after the frame's fence has been waited on.
+    void BeginFrame();
+
+    uint32_t AddTexture(Image* image);
+    void RemoveTexture(uint32_t index);
+
+    uint32_t AddMaterial();
+    void RemoveMaterial(uint32_t index);
+    void UpdateMaterial(uint32_t index, const MaterialData& data);
+
+    void Bind(VkCommandBuffer cb, VkPipelineLayout pipelineLayout);
+
+private:
+
+    static uint32_t AllocSlot(std::vector<uint32_t>& freeSlots, uint32_t& numSlots, uint32_t maxSlots);
+
+    VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet mDescriptorSets[MAX_FRAMES] = { };
+    UniformBuffer* mMaterialBuffer = nullptr;
+
+    uint32_t mNumTextureSlots = 0;
+    uint32_t mNumMaterialSlots = 0;
+    std::vector<uint32_t> mFreeTextureSlots;
+    std::vector<uint32_t> mFreeMaterialSlots;
+    std::vector<uint32_t> mPendingTextureSlots[MAX_FRAMES];
+    std::vector<uint32_t> mPendingMaterialSlots[MAX_FRAMES];
+};
+
+#endif
@@ -13,7 +13,9 @@ enum class BufferType
     Vertex,
     Index,
     Uniform,
+    Storage,
     Transfer,
+    Indirect,
 
     Count
 };
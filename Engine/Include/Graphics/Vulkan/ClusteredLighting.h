@@ -0,0 +1,97 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Constants.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <stdint.h>
+
+class UniformBuffer;
+class CameraComponent;
+class PointLightComponent;
+
+// Point lights are assigned to a grid of view space clusters (froxels) on the CPU so that each
+// fragment only evaluates the lights that can reach it. The grid splits the screen into tiles and
+// the view depth into exponential slices. Every frame the lights are binned by testing their
+// bounding spheres against the view space bounds of the clusters in their screen/depth range.
+// The light data, per cluster (offset, count) pairs, and the compacted light index list are
+// uploaded to a storage buffer in the global descriptor set that Forward.frag indexes.
+// Binning is split by depth slice across the CommandRecorder's worker threads. Each slice only writes
+// its own clusters and visits the lights in order, so the result doesn't depend on the thread count.
+// These values must match the defines in Common.glsl.
+
+#define LIGHT_CLUSTER_DIM_X 16
+#define LIGHT_CLUSTER_DIM_Y 9
+#define LIGHT_CLUSTER_DIM_Z 24
+#define LIGHT_CLUSTER_COUNT (LIGHT_CLUSTER_DIM_X * LIGHT_CLUSTER_DIM_Y * LIGHT_CLUSTER_DIM_Z)
+#define LIGHT_CLUSTER_MAX_LIGHTS 64
+#define LIGHT_CLUSTER_MIN_DEPTH 0.1f
+#define LIGHT_CLUSTER_PARALLEL_MIN_LIGHTS 16
+#define LIGHT_CLUSTER_SLICES_PER_JOB 2
+
+// Layout of the storage buffer (std430). The light index list follows mClusters.
+struct ClusterLightData
+{
+    glm::vec4 mLightPositions[MAX_POINTLIGHTS]; // xyz = position, w = radius
+    glm::vec4 mLightColors[MAX_POINTLIGHTS];
+    glm::uvec2 mClusters[LIGHT_CLUSTER_COUNT]; // x = first index, y = light count
+};
+
+struct LightClusterBounds
+{
+    glm::vec3 mMin;
+    glm::vec3 mMax;
+};
+
+// A light's view space sphere and the cluster range it can touch.
+struct LightClusterRange
+{
+    glm::vec3 mViewPos;
+    float mRadiusSq;
+    int32_t mMin[3];
+    int32_t mMax[3];
+    uint16_t mLightIndex;
+};
+
+class ClusteredLighting
+{
+public:
+
+    void Create();
+    void Destroy();
+
+    // Bins the point lights into the camera's clusters and uploads the result for the current frame.
+    void Update(CameraComponent* camera, const std::vector<PointLightComponent*>& pointLights);
+
+    UniformBuffer* GetBuffer();
+    int32_t GetNumLights() const;
+
+    // x = slice scale, y = slice bias, so that slice = log(depth) * x + y.
+    glm::vec4 GetDepthParams() const;
+
+private:
+
+    void UpdateClusterBounds(const glm::mat4& projection, float nearZ, float farZ);
+    int32_t GetDepthSlice(float depth) const;
+    void BinSlices(uint32_t zBegin, uint32_t zEnd);
+
+    UniformBuffer* mBuffer = nullptr;
+    std::vector<uint8_t> mData;
+    std::vector<LightClusterBounds> mClusterBounds;
+    std::vector<uint16_t> mClusterLights;
+    std::vector<uint8_t> mClusterCounts;
+    std::vector<LightClusterRange> mLightRanges;
+
+    glm::mat4 mBoundsProjection = glm::mat4(0.0f);
+    float mBoundsNear = 0.0f;
+    float mBoundsFar = 0.0f;
+
+    glm::vec4 mDepthParams = glm::vec4(0.0f);
+    int32_t mNumLights = 0;
+};
+
+#endif
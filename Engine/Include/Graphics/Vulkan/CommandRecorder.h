@@ -0,0 +1,109 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/GraphicsTypes.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+class Pipeline;
+struct DrawData;
+
+// Records the shadow and forward passes into secondary command buffers so that large draw lists
+// can be split across worker threads. Those passes are begun with secondary command buffer contents,
+// so every command in them is recorded into a secondary: the main thread's commands between draw lists
+// go into a secondary of its own, and each draw list job gets one. They are executed into the frame's
+// primary command buffer in submission order when the pass ends.
+// Command pools can only be used from one thread at a time, so every thread has its own pool per frame
+// in flight. Pools are reset as a whole once the frame's fence has been waited on.
+// The same worker threads also run plain CPU tasks (RunTasks) outside of draw recording.
+
+#define RECORD_MAX_THREADS 8
+#define RECORD_MIN_DRAWS_PER_JOB 64
+
+typedef std::function<void(uint32_t begin, uint32_t end)> RecordTaskFunc;
+
+struct RecordJob
+{
+    // Set for RunTasks() jobs, which don't record commands.
+    const RecordTaskFunc* mTask = nullptr;
+    const std::vector<DrawData>* mDrawData = nullptr;
+    uint32_t mBegin = 0;
+    uint32_t mEnd = 0;
+    PipelineId mPipelineId = PipelineId::Count;
+    VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+};
+
+// Recording state that used to live on the context, kept per thread so that jobs don't share it.
+struct RecordThreadState
+{
+    VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+    Pipeline* mBoundPipeline = nullptr;
+};
+
+class CommandRecorder
+{
+public:
+
+    void Create(uint32_t queueFamilyIndex);
+    void Destroy();
+
+    // Resets the current frame's command pools. Called after the frame's fence has been waited on.
+    void BeginFrame();
+
+    void BeginPass(VkRenderPass renderPass, VkFramebuffer framebuffer);
+    void EndPass(VkCommandBuffer primaryCb);
+
+    bool IsEnabled() const;
+    bool IsPassActive() const;
+
+    // The calling thread's secondary command buffer while a pass is active, otherwise VK_NULL_HANDLE.
+    VkCommandBuffer GetCommandBuffer();
+    RecordThreadState& GetThreadState();
+
+    // Records the draws, splitting them across the worker threads if the list is long enough.
+    void RecordDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId);
+
+    // Calls task over [0, count) split into ranges across the worker threads and the calling thread,
+    // returning once every range is done. Only called from the main thread.
+    void RunTasks(uint32_t count, uint32_t minPerJob, const RecordTaskFunc& task);
+
+private:
+
+    static void WorkerThreadFunc(CommandRecorder* recorder, uint32_t threadIndex);
+    static void RecordRange(const std::vector<DrawData>& drawData, uint32_t begin, uint32_t end, PipelineId pipelineId);
+
+    VkCommandBuffer BeginSecondary(uint32_t threadIndex);
+    void EndMainSecondary();
+    void DispatchJobs();
+    void RunJob(uint32_t jobIndex, uint32_t threadIndex);
+
+    VkCommandPool mCommandPools[MAX_FRAMES][RECORD_MAX_THREADS + 1] = { };
+    std::vector<VkCommandBuffer> mSecondaries[MAX_FRAMES][RECORD_MAX_THREADS + 1];
+    uint32_t mNumSecondariesUsed[MAX_FRAMES][RECORD_MAX_THREADS + 1] = { };
+    RecordThreadState mThreadStates[RECORD_MAX_THREADS + 1];
+
+    VkRenderPass mRenderPass = VK_NULL_HANDLE;
+    VkFramebuffer mFramebuffer = VK_NULL_HANDLE;
+    bool mPassActive = false;
+    std::vector<VkCommandBuffer> mPassCommandBuffers;
+
+    std::vector<std::thread> mThreads;
+    std::mutex mJobMutex;
+    std::condition_variable mJobCondition;
+    std::condition_variable mDoneCondition;
+    std::vector<RecordJob> mJobs;
+    uint32_t mNextJob = 0;
+    uint32_t mJobsRemaining = 0;
+    bool mExit = false;
+};
+
+#endif
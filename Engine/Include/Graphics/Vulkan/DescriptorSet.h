@@ -15,6 +15,7 @@ class UniformBuffer;
 enum class DescriptorType
 {
     Uniform,
+    Storage,
     Image,
 
     Count
@@ -35,9 +36,14 @@ public:
     // Updates the current frame's descriptor.
     void UpdateImageDescriptor(int32_t binding, Image* image);
     void UpdateUniformDescriptor(int32_t binding, UniformBuffer* uniformBuffer);
+    void UpdateStorageDescriptor(int32_t binding, UniformBuffer* storageBuffer);
 
     void Bind(VkCommandBuffer cb, uint32_t index, VkPipelineLayout pipelineLayout);
 
+    // Writes pending binding updates for the current frame. Bind() does this lazily,
+    // call it up front when the set is going to be bound from several threads.
+    void Refresh();
+
     VkDescriptorSet Get();
     VkDescriptorSet Get(uint32_t frameIndex);
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Profiler.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <stdint.h>
+
+// Measures GPU time of named scopes with timestamp queries and reports it to the Profiler's GPU stats.
+// There is one query pool per frame in flight. A frame's results are read back when its frame index
+// comes around again, after the fence wait, so reading them never stalls. The stats are MAX_FRAMES
+// frames old by the time they are displayed.
+// Queries are reset on the frame's primary command buffer before any pass begins. Timestamps can be
+// written into secondary command buffers too, so scopes may be opened inside any pass.
+
+#define GPU_TIMER_MAX_SCOPES 32
+#define GPU_TIMER_MAX_QUERIES (GPU_TIMER_MAX_SCOPES * 2)
+#define GPU_TIMER_INVALID_SCOPE 0xffffffff
+
+struct GpuTimerScope
+{
+    char mName[STAT_NAME_BUFFER_LENGTH] = {};
+};
+
+class GpuTimer
+{
+public:
+
+    void Create(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex);
+    void Destroy();
+
+    // Reports the results of the last frame that used this frame index, then resets its queries.
+    // Called after the frame's fence has been waited on and its primary command buffer has begun.
+    void BeginFrame(VkCommandBuffer cb);
+
+    void BeginScope(VkCommandBuffer cb, const char* name);
+    void EndScope(VkCommandBuffer cb);
+
+    bool IsEnabled() const;
+
+private:
+
+    void ReadResults(uint32_t frameIndex);
+
+    VkQueryPool mQueryPools[MAX_FRAMES] = { };
+    std::vector<GpuTimerScope> mScopes[MAX_FRAMES];
+    std::vector<uint32_t> mScopeStack;
+
+    uint64_t mTimestampMask = 0;
+    float mTimestampPeriod = 0.0f;
+};
+
+#endif
@@ -42,7 +42,7 @@ public:
 
     VkFormat GetFormat() const;
 
-    void Update(const void* srcData);
+    void Update(const void* srcData, uint32_t mipLevel = 0);
 
     void Transition(VkImageLayout layout, VkCommandBuffer commandBuffer = VK_NULL_HANDLE);
     void GenerateMips();
@@ -0,0 +1,69 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Constants.h"
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/GraphicsTypes.h"
+#include "Graphics/Vulkan/VulkanTypes.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <stdint.h>
+
+class UniformBuffer;
+class DescriptorSet;
+class Pipeline;
+class StaticMeshComponent;
+class Material;
+struct DrawData;
+
+// Records opaque and shadow static mesh draws with vkCmdDrawIndexedIndirect instead of one draw call each.
+// Every eligible draw writes its geometry and bindless material index into a per-frame storage buffer,
+// which the indirect shaders index with gl_InstanceIndex (the command's firstInstance). Commands are
+// bucketed by vertex format so each bucket needs one pipeline bind, one MeshPool bind and one draw call.
+// Only components whose mesh lives in the MeshPool and whose material has a bindless slot qualify,
+// everything else is handed back to the regular path. Like UniformRingBuffer, the draw data and commands
+// are written to CPU copies during the frame and uploaded together in Flush().
+
+#define INDIRECT_DRAWS_ENABLED 1
+#define INDIRECT_MAX_DRAWS 8192
+#define INDIRECT_MAX_COMMANDS (INDIRECT_MAX_DRAWS * 2)
+
+class IndirectDrawer
+{
+public:
+
+    // layout is the indirect pipelines' geometry set layout.
+    void Create(VkDescriptorSetLayout layout);
+    void Destroy();
+
+    void BeginFrame();
+    void Flush();
+
+    // Records the eligible draws and returns the ones that still need to be drawn individually.
+    const std::vector<DrawData>& RecordDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId);
+
+    bool IsEnabled() const;
+
+private:
+
+    Pipeline* GetIndirectPipeline(const DrawData& draw, PipelineId pipelineId) const;
+    uint32_t WriteDrawData(StaticMeshComponent* staticMeshComp, Material* material);
+    void RecordBucket(Pipeline* pipeline, bool vertexColor, const std::vector<VkDrawIndexedIndirectCommand>& commands);
+
+    DescriptorSet* mDescriptorSet = nullptr;
+    UniformBuffer* mDrawBuffer = nullptr;
+    UniformBuffer* mCommandBuffer = nullptr;
+
+    std::vector<IndirectDrawData> mDraws;
+    std::vector<VkDrawIndexedIndirectCommand> mCommands;
+    std::vector<VkDrawIndexedIndirectCommand> mBucketCommands[2];
+    std::vector<DrawData> mRemainingDraws;
+
+    uint32_t mMaxDrawIndirectCount = 1;
+    uint32_t mGeneration = 1;
+};
+
+#endif
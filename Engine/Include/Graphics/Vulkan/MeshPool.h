@@ -0,0 +1,55 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/GraphicsTypes.h"
+#include "Graphics/Vulkan/Allocator.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <stdint.h>
+
+class Buffer;
+
+// Shared device-local vertex and index buffers that static meshes are suballocated from, so that many
+// meshes can be drawn without rebinding buffers (and with one indirect draw per bucket). There is one
+// vertex buffer per static mesh vertex format since vertex offsets are counted in vertices.
+// Ranges are managed with the same TLSF range allocator used for device memory blocks, counted in
+// vertices and indices instead of bytes. Freed ranges are only reused after MAX_FRAMES frames, once
+// no frame in flight can still be reading them. Meshes that don't fit keep buffers of their own.
+
+#define MESH_POOL_VERTEX_CAPACITY (512 * 1024)
+#define MESH_POOL_COLOR_VERTEX_CAPACITY (256 * 1024)
+#define MESH_POOL_INDEX_CAPACITY (4 * 1024 * 1024)
+
+class MeshPool
+{
+public:
+
+    void Create();
+    void Destroy();
+
+    // Returns ranges freed MAX_FRAMES frames ago. Called after the frame's fence has been waited on.
+    void BeginFrame();
+
+    bool Alloc(bool vertexColor, uint32_t numVertices, const void* vertices, uint32_t numIndices, const IndexType* indices, MeshPoolAlloc& outAlloc);
+    void Free(MeshPoolAlloc& alloc);
+
+    // Binds the pool's buffers. Passing an allocation offsets them so that its mesh starts at vertex/index 0.
+    void Bind(VkCommandBuffer cb, bool vertexColor, const MeshPoolAlloc* alloc = nullptr);
+
+private:
+
+    void FreeNow(const MeshPoolAlloc& alloc);
+
+    Buffer* mVertexBuffers[2] = { };
+    Buffer* mIndexBuffer = nullptr;
+    MemoryBlock mVertexRanges[2];
+    MemoryBlock mIndexRanges;
+
+    std::vector<MeshPoolAlloc> mPendingFrees[MAX_FRAMES];
+};
+
+#endif
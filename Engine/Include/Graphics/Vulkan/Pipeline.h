@@ -47,13 +47,17 @@ public:
 
     PipelineId GetId() const;
 
+    // True if the material set is the shared bindless set and the material is selected with a push constant.
+    bool IsBindless() const;
+
 protected:
 
     void CreateGraphicsPipeline();
     void CreateComputePipeline();
 
-    void PushSet();
-    void AddLayoutBinding(VkDescriptorType type, VkShaderStageFlags stageFlags);
+    void PushSet(VkDescriptorSetLayoutCreateFlags flags = 0);
+    void AddLayoutBinding(VkDescriptorType type, VkShaderStageFlags stageFlags, uint32_t count = 1, VkDescriptorBindingFlagsEXT bindingFlags = 0);
+    void AddMaterialLayoutBindings();
 
     VkShaderModule CreateShaderModule(const std::vector<char>& code);
 
@@ -68,6 +72,7 @@ protected:
     std::vector<VkPipeline> mPipelines;
     VkPipelineLayout mPipelineLayout;
     std::vector<VkDescriptorSetLayout> mDescriptorSetLayouts;
+    bool mBindless;
     
 public:
 
@@ -82,6 +87,11 @@ public:
     std::string mFragmentShaderPath;
     std::string mComputeShaderPath;
 
+    // Bindless materials. Pipelines that draw with materials set mBindlessMaterials, and if their fragment
+    // shader reads the material, mBindlessFragmentShaderPath to the shader's bindless variant.
+    bool mBindlessMaterials;
+    std::string mBindlessFragmentShaderPath;
+
     // Viewport
     uint32_t mViewportWidth;
     uint32_t mViewportHeight;
@@ -103,7 +113,13 @@ public:
     // Color Blend State
     std::vector<VkPipelineColorBlendAttachmentState> mBlendAttachments;
 
+    // Push constants (a single range starting at offset 0)
+    uint32_t mPushConstantSize;
+    VkShaderStageFlags mPushConstantStages;
+
     std::vector<std::vector<VkDescriptorSetLayoutBinding> > mLayoutBindings;
+    std::vector<std::vector<VkDescriptorBindingFlagsEXT> > mLayoutBindingFlags;
+    std::vector<VkDescriptorSetLayoutCreateFlags> mLayoutSetFlags;
 };
 
 #endif // API_VULKAN
\ No newline at end of file
@@ -20,6 +20,8 @@ public:
         mName = "Shadow Pipeline";
         mRasterizerDiscard = VK_FALSE;
         mFragmentShaderPath = ENGINE_SHADER_DIR "Shadow.frag";
+        mBindlessFragmentShaderPath = ENGINE_SHADER_DIR "ShadowBindless.frag";
+        mBindlessMaterials = true;
         SetMeshVertexConfigs(
             ENGINE_SHADER_DIR "Shadow.vert",
             ENGINE_SHADER_DIR "Shadow.vert",
@@ -29,6 +31,10 @@ public:
         mViewportWidth = SHADOW_MAP_RESOLUTION;
         mViewportHeight = SHADOW_MAP_RESOLUTION;
 
+        // Cascade index, selects the light matrix in the global uniform buffer.
+        mPushConstantSize = sizeof(uint32_t);
+        mPushConstantStages = VK_SHADER_STAGE_VERTEX_BIT;
+
         mBlendAttachments.clear();
         mPipelineId = PipelineId::Shadow;
     }
@@ -38,15 +44,38 @@ public:
         Pipeline::PopulateLayoutBindings();
 
         PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+
+        AddMaterialLayoutBindings();
+    }
+};
+
+// Draws pooled static meshes with vkCmdDrawIndexedIndirect. Geometry comes from a storage buffer indexed
+// by the draw's instance index instead of a dynamic uniform buffer offset. Only created with bindless.
+class ShadowIndirectPipeline : public ShadowPipeline
+{
+public:
+
+    ShadowIndirectPipeline()
+    {
+        mName = "Shadow Indirect Pipeline";
+        mFragmentShaderPath = ENGINE_SHADER_DIR "ShadowIndirect.frag";
+        mBindlessFragmentShaderPath = ENGINE_SHADER_DIR "ShadowIndirect.frag";
+        ClearVertexConfigs();
+        AddVertexConfig(VertexType::Vertex, ENGINE_SHADER_DIR "ShadowIndirect.vert");
+        AddVertexConfig(VertexType::VertexColor, ENGINE_SHADER_DIR "ShadowIndirect.vert");
+
+        mPipelineId = PipelineId::ShadowIndirect;
+    }
+
+    virtual void PopulateLayoutBindings() override
+    {
+        Pipeline::PopulateLayoutBindings();
 
         PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
-        // Add texture sampler descriptors for each texture slot
-        for (int32_t i = 0; i < MATERIAL_MAX_TEXTURES; ++i)
-        {
-            AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
-        }
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT);
+
+        AddMaterialLayoutBindings();
     }
 };
 
@@ -63,6 +92,8 @@ public:
             ENGINE_SHADER_DIR "ForwardSkinned.vert",
             ENGINE_SHADER_DIR "ForwardParticle.vert");
         mFragmentShaderPath = ENGINE_SHADER_DIR "Forward.frag";
+        mBindlessFragmentShaderPath = ENGINE_SHADER_DIR "ForwardBindless.frag";
+        mBindlessMaterials = true;
         mDepthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
         mDepthWriteEnabled = true;
         mCullMode = VK_CULL_MODE_BACK_BIT;
@@ -75,15 +106,9 @@ public:
         Pipeline::PopulateLayoutBindings();
 
         PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
 
-        PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
-        // Add texture sampler descriptors for each texture slot
-        for (int32_t i = 0; i < MATERIAL_MAX_TEXTURES; ++i)
-        {
-            AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
-        }
+        AddMaterialLayoutBindings();
     }
 };
 
@@ -96,6 +121,32 @@ public:
     }
 };
 
+class OpaqueIndirectPipeline : public OpaquePipeline
+{
+public:
+    OpaqueIndirectPipeline()
+    {
+        mName = "Opaque Indirect Pipeline";
+        mFragmentShaderPath = ENGINE_SHADER_DIR "ForwardIndirect.frag";
+        mBindlessFragmentShaderPath = ENGINE_SHADER_DIR "ForwardIndirect.frag";
+        ClearVertexConfigs();
+        AddVertexConfig(VertexType::Vertex, ENGINE_SHADER_DIR "ForwardIndirect.vert");
+        AddVertexConfig(VertexType::VertexColor, ENGINE_SHADER_DIR "ForwardColorIndirect.vert");
+
+        mPipelineId = PipelineId::OpaqueIndirect;
+    }
+
+    virtual void PopulateLayoutBindings() override
+    {
+        Pipeline::PopulateLayoutBindings();
+
+        PushSet();
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT);
+
+        AddMaterialLayoutBindings();
+    }
+};
+
 class TranslucentPipeline : public ForwardPipeline
 {
 public:
@@ -182,6 +233,7 @@ public:
         mBlendAttachments.push_back(blendAttachment);
 
         mFragmentShaderPath = ENGINE_SHADER_DIR "ForwardShadow.frag";
+        mBindlessFragmentShaderPath = "";
 
         mPipelineId = PipelineId::ShadowMeshBack;
     }
@@ -211,6 +263,7 @@ public:
         mBlendAttachments.push_back(blendAttachment);
 
         mFragmentShaderPath = ENGINE_SHADER_DIR "ForwardShadow.frag";
+        mBindlessFragmentShaderPath = "";
 
         mPipelineId = PipelineId::ShadowMeshFront;
     }
@@ -279,47 +332,16 @@ public:
 
 };
 
-class QuadPipeline : public Pipeline
-{
-public:
-
-    QuadPipeline()
-    {
-        mName = "Quad Pipeline";
-        SetVertexConfig(VertexType::VertexUI, ENGINE_SHADER_DIR "Quad.vert");
-        mFragmentShaderPath = ENGINE_SHADER_DIR "Quad.frag";
-        mPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
-        mCullMode = VK_CULL_MODE_NONE;
-        mDepthTestEnabled = VK_FALSE;
-        
-        mBlendAttachments[0].blendEnable = VK_TRUE;
-        mBlendAttachments[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-        mBlendAttachments[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-
-        mPipelineId = PipelineId::Quad;
-    }
-
-    virtual void PopulateLayoutBindings() override
-    {
-        Pipeline::PopulateLayoutBindings();
-
-        PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
-    }
-};
-
-class TextPipeline : public Pipeline
+class UiPipeline : public Pipeline
 {
 public:
 
-    TextPipeline()
+    UiPipeline()
     {
-        mName = "Text Pipeline";
-        SetVertexConfig(VertexType::VertexUI, ENGINE_SHADER_DIR "Text.vert");
-        mFragmentShaderPath = ENGINE_SHADER_DIR "Text.frag";
+        mName = "UI Pipeline";
+        SetVertexConfig(VertexType::VertexUI, ENGINE_SHADER_DIR "Ui.vert");
+        mFragmentShaderPath = ENGINE_SHADER_DIR "Ui.frag";
         mPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
         mCullMode = VK_CULL_MODE_NONE;
         mDepthTestEnabled = VK_FALSE;
 
@@ -327,7 +349,7 @@ public:
         mBlendAttachments[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
         mBlendAttachments[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 
-        mPipelineId = PipelineId::Text;
+        mPipelineId = PipelineId::Ui;
     }
 
     virtual void PopulateLayoutBindings() override
@@ -335,7 +357,6 @@ public:
         Pipeline::PopulateLayoutBindings();
 
         PushSet();
-        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
         AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
     }
 };
@@ -355,6 +376,7 @@ public:
             ENGINE_SHADER_DIR "DepthSkinned.vert",
             ENGINE_SHADER_DIR "Depth.vert");
         mFragmentShaderPath = ENGINE_SHADER_DIR "SelectedGeometry.frag";
+        mBindlessFragmentShaderPath = "";
 
         mBlendAttachments.clear(); // Clear all geometry blends
         AddMixBlendAttachmentState();
@@ -376,6 +398,7 @@ public:
             ENGINE_SHADER_DIR "DepthSkinned.vert",
             ENGINE_SHADER_DIR "Depth.vert");
         mFragmentShaderPath = ENGINE_SHADER_DIR "HitCheck.frag";
+        mBindlessFragmentShaderPath = "";
         mDepthCompareOp = VK_COMPARE_OP_LESS;
 
         mBlendAttachments.clear(); // Clear all geometry blends
@@ -398,6 +421,7 @@ public:
         mPolygonMode = VK_POLYGON_MODE_LINE;
         mLineWidth = 1.0f;
         mFragmentShaderPath = ENGINE_SHADER_DIR "ColorGeometry.frag";
+        mBindlessFragmentShaderPath = "";
 
         mBlendAttachments.clear(); // Clear all geometry blends
         AddOpaqueBlendAttachmentState();
@@ -0,0 +1,85 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/Vulkan/ResourceArena.h"
+#include "Vertex.h"
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+
+class Buffer;
+class Image;
+class Texture;
+class Quad;
+class Text;
+
+// Widgets don't own any GPU resources. During the UI pass, Quad and Text widgets append their
+// transformed vertices to one CPU-side stream, and consecutive widgets that use the same image and
+// scissor rect are merged into a single batch. The stream is uploaded and drawn when the pass ends.
+// Small textures and font glyph pages are copied into a shared atlas the first time they are drawn,
+// so most widgets end up in the same batch.
+
+#define UI_ATLAS_SIZE 2048
+#define UI_ATLAS_MAX_TEXTURE_SIZE 512
+#define UI_ATLAS_PADDING 1
+#define UI_MIN_VERTEX_BUFFER_VERTS 4096
+
+struct UiBatch
+{
+    Image* mImage = nullptr;
+    VkRect2D mScissor = {};
+    uint32_t mFirstVertex = 0;
+    uint32_t mNumVertices = 0;
+};
+
+struct UiAtlasEntry
+{
+    glm::vec2 mUvOffset = {};
+    glm::vec2 mUvScale = {};
+    bool mInAtlas = false;
+};
+
+class UiBatcher
+{
+public:
+
+    void Create();
+    void Destroy();
+
+    void BeginFrame();
+    void SetScissor(const VkRect2D& scissor);
+    void Flush(VkCommandBuffer cb);
+
+    void AddQuad(Quad* quad);
+    void AddText(Text* text);
+
+    void RemoveTexture(Texture* texture);
+
+private:
+
+    VertexUI* AllocVertices(Image* image, uint32_t numVertices);
+    const UiAtlasEntry& GetAtlasEntry(Texture* texture);
+    bool CanUseAtlas(Texture* texture) const;
+    bool InsertIntoAtlas(Texture* texture, UiAtlasEntry& outEntry);
+
+    std::vector<VertexUI> mVertices;
+    std::vector<UiBatch> mBatches;
+    VkRect2D mScissor = {};
+
+    Buffer* mVertexBuffers[MAX_FRAMES] = {};
+    uint32_t mFrameVertexOffset = 0;
+    DescriptorSetArena mDescriptorSetArena;
+
+    Image* mAtlasImage = nullptr;
+    std::unordered_map<Texture*, UiAtlasEntry> mAtlasEntries;
+    uint32_t mShelfX = 0;
+    uint32_t mShelfY = 0;
+    uint32_t mShelfHeight = 0;
+};
+
+#endif
@@ -11,7 +11,8 @@ class UniformBuffer
 {
 public:
 
-    UniformBuffer(size_t size, const char* debugName, const void* srcData = nullptr);
+    // Also used for per-frame storage buffers by passing BufferType::Storage.
+    UniformBuffer(size_t size, const char* debugName, const void* srcData = nullptr, BufferType type = BufferType::Uniform);
 
     void Update(const void* srcData, size_t srcSize);
 
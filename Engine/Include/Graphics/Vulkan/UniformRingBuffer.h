@@ -0,0 +1,66 @@
+#pragma once
+
+#if API_VULKAN
+
+#include "Graphics/GraphicsConstants.h"
+#include "Graphics/GraphicsTypes.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <stdint.h>
+
+class Buffer;
+
+// Transient per-frame uniform storage. Each frame owns a list of fixed size blocks, and every block has one
+// uniform buffer plus one descriptor set that points at it with a dynamic offset. Allocations are linear
+// within the block and the whole frame is recycled in BeginFrame() once the GPU is done with it.
+// Writes go to a CPU copy of the block and are uploaded together in Flush() before the frame is submitted.
+// Allocations are tagged with a generation so callers can keep reusing their data until the next reset.
+
+#define UNIFORM_RING_BLOCK_SIZE (2 * 1024 * 1024)
+
+struct UniformRingBlock
+{
+    Buffer* mBuffer = nullptr;
+    VkDescriptorSet mDescriptorSet = VK_NULL_HANDLE;
+    std::vector<uint8_t> mData;
+    uint32_t mUsed = 0;
+    uint32_t mFlushed = 0;
+};
+
+class UniformRingBuffer
+{
+public:
+
+    // range is the size of the largest structure bound through this ring.
+    void Create(VkDescriptorSetLayout layout, uint32_t range, const char* debugName);
+    void Destroy();
+
+    void BeginFrame();
+    void Flush();
+
+    // Forces callers to rewrite their data without recycling the frame's memory.
+    void Invalidate();
+
+    // Returns a pointer to size bytes of uniform data that is valid until Flush().
+    void* Alloc(uint32_t size, UniformRingAlloc& outAlloc);
+    bool IsCurrent(const UniformRingAlloc& alloc) const;
+
+    void Bind(VkCommandBuffer cb, uint32_t setIndex, VkPipelineLayout pipelineLayout, const UniformRingAlloc& alloc);
+
+private:
+
+    UniformRingBlock& AddBlock();
+
+    std::vector<UniformRingBlock> mBlocks[MAX_FRAMES];
+    VkDescriptorSetLayout mLayout = VK_NULL_HANDLE;
+    const char* mDebugName = nullptr;
+    uint32_t mRange = 0;
+    uint32_t mAlignment = 0;
+    uint32_t mFrameIndex = 0;
+    uint32_t mBlockIndex = 0;
+    uint32_t mGeneration = 1;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#if API_VULKAN
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+class Buffer;
+
+// Batches resource uploads (buffer/image copies, layout transitions, mip generation) into one command
+// buffer that is submitted once per frame instead of submitting a tiny command buffer per upload.
+// Upload data is copied into the batch's persistent staging block. A batch is recycled once its fence
+// signals, so loading many assets never waits on the GPU unless every batch is still in flight.
+// Uploads that don't fit in a staging block fall back to a dedicated staging buffer.
+
+#define UPLOAD_BATCH_COUNT 3
+#define UPLOAD_STAGING_SIZE (8 * 1024 * 1024)
+#define UPLOAD_STAGING_ALIGNMENT 16
+
+struct UploadBatch
+{
+    VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+    VkFence mFence = VK_NULL_HANDLE;
+    Buffer* mStagingBuffer = nullptr;
+    uint32_t mStagingUsed = 0;
+    bool mRecording = false;
+};
+
+class UploadQueue
+{
+public:
+
+    void Create();
+    void Destroy();
+
+    // Returns the command buffer of the batch being recorded, starting a new batch if needed.
+    VkCommandBuffer GetCommandBuffer();
+
+    // Copies data into staging memory that stays valid until the batch has executed.
+    void Stage(const void* srcData, uint32_t size, VkBuffer& outBuffer, VkDeviceSize& outOffset);
+
+    // Submits the batch being recorded (if any). Called before every frame submit.
+    void Flush();
+
+private:
+
+    UploadBatch& BeginBatch();
+
+    UploadBatch mBatches[UPLOAD_BATCH_COUNT];
+    uint32_t mBatchIndex = 0;
+};
+
+#endif
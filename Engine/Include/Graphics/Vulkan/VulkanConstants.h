@@ -5,9 +5,22 @@
 #define MAX_ENABLED_LAYERS 8
 #define MAX_DESCRIPTOR_SETS 8192
 #define MAX_UNIFORM_BUFFER_DESCRIPTORS 8192
+#define MAX_DYNAMIC_UNIFORM_BUFFER_DESCRIPTORS 64
 #define MAX_STORAGE_BUFFER_DESCRIPTORS 32
 #define MAX_STORAGE_IMAGE_DESCRIPTORS 32
 #define MAX_SAMPLER_DESCRIPTORS 4096
 
+// Bindless materials (VK_EXT_descriptor_indexing). When the device supports it, every texture is written
+// into one large sampled image array and every material's parameters into one storage buffer.
+// Draws select their material with a push constant instead of binding a descriptor set.
+#define BINDLESS_ENABLED 1
+#define BINDLESS_MAX_TEXTURES 4096
+#define BINDLESS_MAX_MATERIALS 4096
+#define BINDLESS_INVALID_INDEX 0xffffffff
+
+#define PIPELINE_CACHE_FILE "PipelineCache.bin"
+#define PIPELINE_CACHE_MAGIC 0x4F504C43 // "OPLC"
+#define PIPELINE_CACHE_VERSION 1
+
 #define SELECTED_COMP_COLOR glm::vec4(1.0f, 1.0f, 0.5f, 1.0f)
 #define MULTI_SELECTED_COMP_COLOR glm::vec4(1.0f, 0.6f, 0.3f, 1.0f)
@@ -16,6 +16,15 @@
 #include "Image.h"
 #include "Line.h"
 #include "ResourceArena.h"
+#include "UiBatcher.h"
+#include "UniformRingBuffer.h"
+#include "ClusteredLighting.h"
+#include "UploadQueue.h"
+#include "CommandRecorder.h"
+#include "BindlessTable.h"
+#include "GpuTimer.h"
+#include "MeshPool.h"
+#include "IndirectDrawer.h"
 
 #if PLATFORM_LINUX
 #include <xcb/xcb.h>
@@ -64,6 +73,8 @@ public:
     void RebindPipeline(VertexType vertexType);
     void DrawLines(const std::vector<Line>& lines);
     void DrawFullscreen();
+    void BeginGpuStat(const char* name);
+    void EndGpuStat();
 
     VkDevice GetDevice();
     void CreateSwapchain();
@@ -71,6 +82,7 @@ public:
 
     VkPhysicalDevice GetPhysicalDevice();
     VkDescriptorPool GetDescriptorPool();
+    VkPipelineCache GetPipelineCache();
 
     DestroyQueue* GetDestroyQueue();
 
@@ -86,6 +98,9 @@ public:
 
     void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
     void SetScissor(int32_t x, int32_t y, int32_t width, int32_t height);
+    void SetShadowCascade(uint32_t cascade);
+    const VkViewport& GetViewport() const;
+    const VkRect2D& GetScissor() const;
 
     DescriptorSet* GetGlobalDescriptorSet();
 
@@ -106,9 +121,18 @@ public:
     GlobalUniformData& GetGlobalUniformData();
 
     bool IsValidationEnabled() const;
-
-    DescriptorSetArena& GetMeshDescriptorSetArena();
-    UniformBufferArena& GetMeshUniformBufferArena();
+    bool IsBlockCompressionSupported() const;
+    bool IsBindlessEnabled() const;
+    bool IsIndirectDrawEnabled() const;
+
+    UniformRingBuffer& GetGeometryRingBuffer();
+    UiBatcher& GetUiBatcher();
+    UploadQueue& GetUploadQueue();
+    CommandRecorder& GetCommandRecorder();
+    BindlessTable& GetBindlessTable();
+    GpuTimer& GetGpuTimer();
+    MeshPool& GetMeshPool();
+    IndirectDrawer& GetIndirectDrawer();
 
 private:
 
@@ -128,6 +152,10 @@ private:
     void CreateRenderPass();
     void CreatePipelines();
     void DestroyPipelines();
+    void CreatePipelineCache();
+    void SavePipelineCache();
+    void DestroyPipelineCache();
+    std::string GetPipelineCachePath() const;
     void CreateFramebuffers();
     void CreateCommandPool();
     void CreateSemaphores();
@@ -171,6 +199,7 @@ private:
     // Pools
     VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
     VkCommandPool mCommandPool = VK_NULL_HANDLE;
+    VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
 
     // Command Buffers
     std::vector<VkCommandBuffer> mCommandBuffers;
@@ -224,10 +253,22 @@ private:
     const char* mEnabledExtensions[MAX_ENABLED_EXTENSIONS] = { };
     uint32_t mEnabledLayersCount = 0;
     const char* mEnabledLayers[MAX_ENABLED_LAYERS] = { };
-    DescriptorSetArena mMeshDescriptorSetArena;
-    UniformBufferArena mMeshUniformBufferArena;
+    UniformRingBuffer mGeometryRing;
+    UiBatcher mUiBatcher;
+    ClusteredLighting mClusteredLighting;
+    UploadQueue mUploadQueue;
+    CommandRecorder mCommandRecorder;
+    BindlessTable mBindlessTable;
+    GpuTimer mGpuTimer;
+    MeshPool mMeshPool;
+    IndirectDrawer mIndirectDrawer;
+    VkViewport mViewport = { };
+    VkRect2D mScissor = { };
 
     // Misc
+    bool mSupportsBlockCompression = false;
+    bool mSupportsBindless = false;
+    bool mSupportsIndirectDraws = false;
     int32_t mFrameIndex = 0;
     int32_t mFrameNumber = 0;
     uint32_t mSwapchainImageIndex = 0;
@@ -236,7 +277,7 @@ private:
     Buffer* mLineVertexBuffer = nullptr;
     bool mInitialized = false;
     EngineState* mEngineState = nullptr;
-    Pipeline* mCurrentlyBoundPipeline = nullptr;
+    uint32_t mShadowCascade = 0;
 
 #if EDITOR
 public:
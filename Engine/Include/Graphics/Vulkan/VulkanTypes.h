@@ -5,7 +5,8 @@
 struct GlobalUniformData
 {
     glm::mat4 mViewProjMatrix;
-    glm::mat4 mDirectionalLightVP;
+    glm::mat4 mShadowCascadeVP[SHADOW_CASCADE_COUNT];
+    glm::vec4 mShadowCascadeSplits;
     glm::vec4 mDirectionalLightDirection;
     glm::vec4 mDirectionalLightColor;
     glm::vec4 mAmbientLightColor;
@@ -13,13 +14,12 @@ struct GlobalUniformData
     glm::vec4 mViewDirection;
     glm::vec2 mScreenDimensions;
     glm::vec2 mInterfaceResolution;
-    glm::vec4 mPointLightPositions[MAX_POINTLIGHTS];
-    glm::vec4 mPointLightColors[MAX_POINTLIGHTS];
+    glm::vec4 mClusterDepthParams;
     glm::vec4 mShadowColor;
 
     int32_t mNumPointLights;
     int32_t mVisualizationMode;
-    int32_t mPadding0;
+    int32_t mShadowsEnabled;
     int32_t mPadding1;
 
     glm::vec4 mFogColor;
@@ -34,7 +34,6 @@ struct GeometryData
     glm::mat4 mWVPMatrix;
     glm::mat4 mWorldMatrix;
     glm::mat4 mNormalMatrix;
-    glm::mat4 mLightWVPMatrix;
     glm::vec4 mColor;
 
     uint32_t mHitCheckId;
@@ -55,30 +54,6 @@ struct SkinnedGeometryData
     uint32_t mPadding2;
 };
 
-struct QuadUniformData
-{
-    glm::mat4 mTransform;
-    glm::vec4 mTint;
-};
-
-struct TextUniformData
-{
-    glm::mat4 mTransform;
-
-    float mX;
-    float mY;
-    float mCutoff;
-    float mOutlineSize;
-
-    float mScale;
-    float mSoftness;
-    float mPadding1;
-    float mPadding2;
-
-    int32_t mDistanceField;
-    int32_t mEffect;
-};
-
 struct MaterialData
 {
     glm::vec2 mUvOffset0;
@@ -107,6 +82,25 @@ struct MaterialData
 
     uint32_t mUvMaps[MATERIAL_MAX_TEXTURES];
     uint32_t mTevModes[MATERIAL_MAX_TEXTURES];
+    uint32_t mTextureIndices[MATERIAL_MAX_TEXTURES]; // Bindless texture array indices
+};
+
+// Per draw data of indirect draws, selected in the shader by the draw's firstInstance.
+struct IndirectDrawData
+{
+    GeometryData mGeometry;
+
+    uint32_t mMaterialIndex;
+    uint32_t mPadding0;
+    uint32_t mPadding1;
+    uint32_t mPadding2;
+};
+
+// Push constants of pipelines that use bindless materials.
+struct DrawPushConstants
+{
+    uint32_t mShadowCascade;
+    uint32_t mMaterialIndex;
 };
 
 enum class DescriptorSetBinding
@@ -115,8 +109,7 @@ enum class DescriptorSetBinding
 
     Geometry = 1,
     PostProcess = 1,
-    Quad = 1,
-    Text = 1,
+    Ui = 1,
 
     Material = 2
 };
@@ -23,8 +23,7 @@ class StaticMeshComponent;
 class SkeletalMeshComponent;
 class ShadowMeshComponent;
 class ParticleComponent;
-class Quad;
-class Text;
+class PrimitiveComponent;
 
 VkFormat ConvertPixelFormat(PixelFormat pixelFormat);
 
@@ -47,13 +46,17 @@ void TransitionImageLayout(
 void CopyBuffer(
     VkBuffer srcBuffer,
     VkBuffer dstBuffer,
-    VkDeviceSize size);
+    VkDeviceSize size,
+    VkDeviceSize dstOffset = 0,
+    VkDeviceSize srcOffset = 0);
 
 void CopyBufferToImage(
     VkBuffer buffer,
     VkImage image,
     uint32_t width,
-    uint32_t height);
+    uint32_t height,
+    uint32_t mipLevel = 0,
+    VkDeviceSize bufferOffset = 0);
 
 uint32_t GetFrameIndex();
 DestroyQueue* GetDestroyQueue();
@@ -62,8 +65,15 @@ VkCommandBuffer GetCommandBuffer();
 
 void DeviceWaitIdle();
 
+// Upload/transfer work is recorded into the upload queue's current batch and submitted before the next frame.
+// Use DeviceWaitIdle() when the results are needed immediately.
 VkCommandBuffer BeginCommandBuffer();
 void EndCommandBuffer(VkCommandBuffer commandBuffer);
+
+// A dedicated primary command buffer for work that begins render passes, submitted right away by
+// EndSingleCommandBuffer() after any pending uploads.
+VkCommandBuffer BeginSingleCommandBuffer();
+void EndSingleCommandBuffer(VkCommandBuffer commandBuffer);
 uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
 uint32_t GetFormatPixelSize(VkFormat format);
@@ -109,6 +119,7 @@ void BindSkeletalMeshResourceIndices(SkeletalMesh* skeletalMesh);
 // StaticMeshComp
 void CreateStaticMeshCompResource(StaticMeshComponent* staticMeshComp);
 void DestroyStaticMeshCompResource(StaticMeshComponent* staticMeshComp);
+void WriteStaticMeshCompGeometryData(StaticMeshComponent* staticMeshComp, GeometryData& outData);
 void UpdateStaticMeshCompResource(StaticMeshComponent* staticMeshComp);
 void DrawStaticMeshComp(StaticMeshComponent* staticMeshComp, StaticMesh* meshOverride = nullptr);
 
@@ -131,22 +142,11 @@ void UpdateParticleCompResource(ParticleComponent* particleComp);
 void UpdateParticleCompVertexBuffer(ParticleComponent* particleComp, const std::vector<VertexParticle>& vertices);
 void DrawParticleComp(ParticleComponent* particleComp);
 
-// Quad
-void CreateQuadResource(Quad* quad);
-void DestroyQuadResource(Quad* quad);
-void UpdateQuadResource(Quad* quad);
-void DrawQuad(Quad* quad);
-
-// Text
-void CreateTextResource(Text* text);
-void DestroyTextResource(Text* text);
-void CreateTextResourceVertexBuffer(Text* text);
-void DestroyTextResourceVertexBuffer(Text* text);
-void UpdateTextResourceUniformData(Text* text);
-void UpdateTextResourceVertexData(Text* text);
-void DrawTextWidget(Text* text);
-
 // Arbitrary mesh draw
 void DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& transform, glm::vec4 color, uint32_t hitCheckId = 0);
 
+// Performs the lazy per frame updates that drawing a component would otherwise do (geometry uniforms,
+// material uniforms and descriptor writes) so that the draw itself only records commands.
+void PrepareDrawResources(PrimitiveComponent* comp, Material* material);
+
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@ struct Audio_Lua
     static int PlaySound3D(lua_State* L);
     static int StopSounds(lua_State* L);
     static int StopAllSounds(lua_State* L);
+    static int BenchmarkMixer(lua_State* L);
 
     static void Bind();
 };
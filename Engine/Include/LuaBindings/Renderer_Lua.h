@@ -13,6 +13,8 @@ struct Renderer_Lua
     static int RemoveWidget(lua_State* L);
     static int RemoveAllWidgets(lua_State* L);
     static int EnableStatsOverlay(lua_State* L);
+    static int SetStatsDisplayMode(lua_State* L);
+    static int GetStatsDisplayMode(lua_State* L);
     static int SetModalWidget(lua_State* L);
     static int GetModalWidget(lua_State* L);
     static int IsInModalWidgetUpdate(lua_State* L);
@@ -32,6 +34,8 @@ struct Renderer_Lua
     static int GetBoundsDebugMode(lua_State* L);
     static int EnableFrustumCulling(lua_State* L);
     static int IsFrustumCullingEnabled(lua_State* L);
+    static int EnableMeshLods(lua_State* L);
+    static int AreMeshLodsEnabled(lua_State* L);
     static int AddDebugDraw(lua_State* L);
     static int AddDebugLine(lua_State* L);
 
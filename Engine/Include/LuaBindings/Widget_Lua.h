@@ -65,6 +65,8 @@ struct Widget_Lua
     static int GetNumChildren(lua_State* L);
     static int MarkDirty(lua_State* L);
     static int IsDirty(lua_State* L);
+    static int SetAnimated(lua_State* L);
+    static int IsAnimated(lua_State* L);
     static int ContainsMouse(lua_State* L);
     static int ContainsPoint(lua_State* L);
     static int SetRotation(lua_State* L);
@@ -54,9 +54,16 @@ struct World_Lua
     static int UnloadAllLevels(lua_State* L);
 
     static int SpawnBlueprint(lua_State* L);
+    static int PrewarmActorPool(lua_State* L);
+    static int PrewarmBlueprintPool(lua_State* L);
     static int LoadLevel(lua_State* L);
     static int QueueLevelLoad(lua_State* L);
     static int UnloadLevel(lua_State* L);
+    static int StreamLevel(lua_State* L);
+    static int IsStreamingLevels(lua_State* L);
+    static int GetLevelStreamProgress(lua_State* L);
+    static int SetLevelStreamBudget(lua_State* L);
+    static int SetLevelStreamedCallback(lua_State* L);
 
     static int EnableInternalEdgeSmoothing(lua_State* L);
     static int IsInternalEdgeSmoothingEnabled(lua_State* L);
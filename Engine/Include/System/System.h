@@ -17,6 +17,7 @@ void SYS_OpenDirectory(const std::string& dirPath, DirEntry& outDirEntry);
 void SYS_IterateDirectory(DirEntry& dirEntry);
 void SYS_CloseDirectory(DirEntry& dirEntry);
 void SYS_RemoveFile(const char* path);
+bool SYS_GetFileInfo(const char* path, uint64_t& outModifiedTime, uint64_t& outSize);
 bool SYS_Rename(const char* oldPath, const char* newPath);
 std::string SYS_OpenFileDialog();
 std::string SYS_SaveFileDialog();
@@ -8,3 +8,17 @@ for %%f in (.\src\*) do (
     (( %VULKAN_SDK%/Bin/glslc.exe %%f -o .\bin\%%~nxf ) && ( echo Compile Successful )) || pause 
   )
 )
+
+REM Bindless material variants, used when the device supports descriptor indexing
+for %%f in (Forward Shadow) do (
+  (( %VULKAN_SDK%/Bin/glslc.exe -DBINDLESS .\src\%%f.frag -o .\bin\%%fBindless.frag ) && ( echo Compile Successful )) || pause
+)
+
+REM Indirect draw variants, used when the device also supports multi draw indirect
+for %%f in (Forward ForwardColor Shadow) do (
+  (( %VULKAN_SDK%/Bin/glslc.exe -DINDIRECT .\src\%%f.vert -o .\bin\%%fIndirect.vert ) && ( echo Compile Successful )) || pause
+)
+
+for %%f in (Forward Shadow) do (
+  (( %VULKAN_SDK%/Bin/glslc.exe -DBINDLESS -DINDIRECT .\src\%%f.frag -o .\bin\%%fIndirect.frag ) && ( echo Compile Successful )) || pause
+)
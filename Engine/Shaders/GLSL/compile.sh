@@ -16,6 +16,26 @@ then
         fi
 
     done
+
+    # Bindless material variants, used when the device supports descriptor indexing
+    for file in Forward.frag Shadow.frag
+    do
+        echo $VULKAN_SDK/bin/glslc -DBINDLESS $file -o ../bin/${file%.frag}Bindless.frag
+        $VULKAN_SDK/bin/glslc -DBINDLESS $file -o ../bin/${file%.frag}Bindless.frag
+    done
+
+    # Indirect draw variants, used when the device also supports multi draw indirect
+    for file in Forward.vert ForwardColor.vert Shadow.vert
+    do
+        echo $VULKAN_SDK/bin/glslc -DINDIRECT $file -o ../bin/${file%.vert}Indirect.vert
+        $VULKAN_SDK/bin/glslc -DINDIRECT $file -o ../bin/${file%.vert}Indirect.vert
+    done
+
+    for file in Forward.frag Shadow.frag
+    do
+        echo $VULKAN_SDK/bin/glslc -DBINDLESS -DINDIRECT $file -o ../bin/${file%.frag}Indirect.frag
+        $VULKAN_SDK/bin/glslc -DBINDLESS -DINDIRECT $file -o ../bin/${file%.frag}Indirect.frag
+    done
 else
     echo "ERROR: glslc not detected - have you installed Shaderc? Try the LunarG Vulkan SDK!"
     exit 1;
@@ -1,4 +1,10 @@
-#define MAX_POINTLIGHTS 7
+#define MAX_POINTLIGHTS 256
+#define LIGHT_CLUSTER_DIM_X 16
+#define LIGHT_CLUSTER_DIM_Y 9
+#define LIGHT_CLUSTER_DIM_Z 24
+#define LIGHT_CLUSTER_COUNT (LIGHT_CLUSTER_DIM_X * LIGHT_CLUSTER_DIM_Y * LIGHT_CLUSTER_DIM_Z)
+#define LIGHT_CLUSTER_MIN_DEPTH 0.1
+#define SHADOW_CASCADE_COUNT 4
 #define MAX_TEXTURES 4
 
 #define SHADING_MODEL_UNLIT 0
@@ -32,7 +38,8 @@
 struct GlobalUniforms
 {
     mat4 mViewProj;
-    mat4 mDirectionalLightVP;
+    mat4 mShadowCascadeVP[SHADOW_CASCADE_COUNT];
+    vec4 mShadowCascadeSplits;
 
     vec4 mDirectionalLightDirection;
     vec4 mDirectionalLightColor;
@@ -41,13 +48,12 @@ struct GlobalUniforms
     vec4 mViewDirection;
     vec2 mScreenDimensions;
     vec2 mInterfaceResolution;
-    vec4 mPointLightPositions[MAX_POINTLIGHTS];
-    vec4 mPointLightColors[MAX_POINTLIGHTS];
+    vec4 mClusterDepthParams;
     vec4 mShadowColor;
 
     int mNumPointLights;
     int mVisualizationMode;
-    int mPadding0;
+    int mShadowsEnabled;
     int mPadding1;
 
     vec4 mFogColor;
@@ -63,7 +69,6 @@ struct GeometryUniforms
     mat4 mWVP;
     mat4 mWorldMatrix;
     mat4 mNormalMatrix;
-    mat4 mLightWVP;
 	vec4 mColor;
 
 	uint mHitCheckId;
@@ -72,12 +77,22 @@ struct GeometryUniforms
     uint mPadding2;
 };
 
+// Per draw data of indirect draws, read with gl_InstanceIndex (the draw's firstInstance).
+struct DrawUniforms
+{
+    GeometryUniforms mGeometry;
+
+    uint mMaterialIndex;
+    uint mPadding0;
+    uint mPadding1;
+    uint mPadding2;
+};
+
 struct SkinnedGeometryUniforms 
 {
     mat4 mWVP;
     mat4 mWorldMatrix;
     mat4 mNormalMatrix;
-    mat4 mLightWVP;
 	vec4 mColor;
 
 	uint mHitCheckId;
@@ -121,6 +136,7 @@ struct MaterialUniforms
 
     uvec4 mUvMaps; // MAX_TEXTURES
     uvec4 mTevModes; // MAX_TEXTURES
+    uvec4 mTextureIndices; // MAX_TEXTURES, only used by bindless shaders
 };
 
 const mat4 SHADOW_BIAS_MAT = mat4( 
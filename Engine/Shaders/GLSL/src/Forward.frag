@@ -1,5 +1,8 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
 
 #include "Common.glsl"
 #include "Fog.glsl"
@@ -13,11 +16,52 @@ layout (set = 0, binding = 0) uniform GlobalUniformBuffer
 
 layout (set = 0, binding = 1) uniform sampler2D shadowSampler;
 
+layout (std430, set = 0, binding = 2) readonly buffer ClusterLightBuffer
+{
+    vec4 mLightPositions[MAX_POINTLIGHTS];
+    vec4 mLightColors[MAX_POINTLIGHTS];
+    uvec2 mClusters[LIGHT_CLUSTER_COUNT];
+    uint mLightIndices[];
+} clusterLights;
+
+#ifndef INDIRECT
 layout (set = 1, binding = 0) uniform GeometryUniformBuffer 
 {
 	GeometryUniforms geometry;
 };
+#endif
+
+#ifdef BINDLESS
+layout(std430, set = 2, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialUniforms materials[];
+};
+
+layout(set = 2, binding = 1) uniform sampler2D textures[];
+
+#ifdef INDIRECT
+// Draws of one indirect call can use different materials, so the texture index isn't uniform.
+layout(location = 6) flat in uint inMaterialIndex;
 
+#define material materials[inMaterialIndex]
+#define sampler0 textures[nonuniformEXT(material.mTextureIndices[0])]
+#define sampler1 textures[nonuniformEXT(material.mTextureIndices[1])]
+#define sampler2 textures[nonuniformEXT(material.mTextureIndices[2])]
+#define sampler3 textures[nonuniformEXT(material.mTextureIndices[3])]
+#else
+layout(push_constant) uniform DrawConstants
+{
+    uint mShadowCascade;
+    uint mMaterialIndex;
+} draw;
+
+#define material materials[draw.mMaterialIndex]
+#define sampler0 textures[material.mTextureIndices[0]]
+#define sampler1 textures[material.mTextureIndices[1]]
+#define sampler2 textures[material.mTextureIndices[2]]
+#define sampler3 textures[material.mTextureIndices[3]]
+#endif
+#else
 layout(set = 2, binding = 0) uniform MaterialUniformBuffer
 {
     MaterialUniforms material;
@@ -27,12 +71,12 @@ layout(set = 2, binding = 1) uniform sampler2D sampler0;
 layout(set = 2, binding = 2) uniform sampler2D sampler1;
 layout(set = 2, binding = 3) uniform sampler2D sampler2;
 layout(set = 2, binding = 4) uniform sampler2D sampler3;
+#endif
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inTexcoord0;
 layout(location = 2) in vec2 inTexcoord1;
 layout(location = 3) in vec3 inNormal;
-layout(location = 4) in vec4 inShadowCoordinate;
 layout(location = 5) in vec4 inColor;
 
 layout(location = 0) out vec4 outColor;
@@ -63,11 +107,39 @@ vec4 CalculateLighting(uint shadingModel, vec3 L, vec3 N, vec3 V, vec4 color, fl
     return retLighting;
 }
 
-float CalculateShadow(vec4 sc)
+float CalculateShadow(vec3 worldPos)
 {
+    if (global.mShadowsEnabled == 0)
+    {
+        return 1.0f;
+    }
+
+    // Pick the first cascade whose slice contains this fragment.
+    float viewDepth = dot(worldPos - global.mViewPosition.xyz, global.mViewDirection.xyz);
+    int cascade = SHADOW_CASCADE_COUNT;
+
+    for (int i = SHADOW_CASCADE_COUNT - 1; i >= 0; --i)
+    {
+        if (viewDepth < global.mShadowCascadeSplits[i])
+        {
+            cascade = i;
+        }
+    }
+
+    if (cascade >= SHADOW_CASCADE_COUNT)
+    {
+        return 1.0f;
+    }
+
+    vec4 sc = (SHADOW_BIAS_MAT * global.mShadowCascadeVP[cascade]) * vec4(worldPos, 1.0);
+    sc = sc / sc.w;
+
+    // Cascades are laid out in a 2x2 grid within the shadow map.
+    vec2 uv = sc.xy * 0.5 + vec2(cascade % 2, cascade / 2) * 0.5;
+
     float visibility = 0.0f;
 
-    if (texture(shadowSampler, sc.xy /*+ vec2(dx*x, dy*y)*/).r + SHADAOW_DEPTH_BIAS >=  sc.z)
+    if (texture(shadowSampler, uv).r + SHADAOW_DEPTH_BIAS >= sc.z)
     {
         visibility = 1.0f;
     }
@@ -75,6 +147,20 @@ float CalculateShadow(vec4 sc)
     return visibility;
 }
 
+uint GetLightCluster(vec3 worldPos)
+{
+    float viewDepth = dot(worldPos - global.mViewPosition.xyz, global.mViewDirection.xyz);
+    float slice = log(max(viewDepth, LIGHT_CLUSTER_MIN_DEPTH)) * global.mClusterDepthParams.x + global.mClusterDepthParams.y;
+
+    uint z = uint(clamp(int(slice), 0, LIGHT_CLUSTER_DIM_Z - 1));
+    uvec2 tile = uvec2(clamp(
+        ivec2(gl_FragCoord.xy / global.mScreenDimensions * vec2(LIGHT_CLUSTER_DIM_X, LIGHT_CLUSTER_DIM_Y)),
+        ivec2(0, 0),
+        ivec2(LIGHT_CLUSTER_DIM_X - 1, LIGHT_CLUSTER_DIM_Y - 1)));
+
+    return (z * LIGHT_CLUSTER_DIM_Y + tile.y) * LIGHT_CLUSTER_DIM_X + tile.x;
+}
+
 vec4 BlendTexture(vec4 prevColor, uint texIdx, sampler2D texSampler, vec2 uv0, vec2 uv1, float vertexIntensity)
 {
     vec4 outColor = prevColor;
@@ -145,16 +231,19 @@ void main()
             vec4 lightColor = global.mDirectionalLightColor;
 
             vec4 dirLighting = CalculateLighting(shadingModel, L, N, V, lightColor, 1.0);
-            float shadowVis = 1.0f; //CalculateShadow(inShadowCoordinate);
+            float shadowVis = CalculateShadow(inPosition);
             totalLight += dirLighting * shadowVis;
         }
 
-        //Point Lights
-        for (int i = 0; i < global.mNumPointLights; ++i)
+        //Point Lights (only the ones assigned to this fragment's cluster)
+        uvec2 cluster = (global.mNumPointLights > 0) ? clusterLights.mClusters[GetLightCluster(inPosition)] : uvec2(0, 0);
+
+        for (uint c = 0; c < cluster.y; ++c)
         {
-            vec3 lightPos = global.mPointLightPositions[i].xyz;
-            vec4 lightColor = global.mPointLightColors[i];
-            float lightRadius = global.mPointLightPositions[i].w;
+            uint i = clusterLights.mLightIndices[cluster.x + c];
+            vec3 lightPos = clusterLights.mLightPositions[i].xyz;
+            vec4 lightColor = clusterLights.mLightColors[i];
+            float lightRadius = clusterLights.mLightPositions[i].w;
 
             vec3 toLight = lightPos - inPosition;
             float dist = length(toLight);
@@ -8,10 +8,19 @@ layout (set = 0, binding = 0) uniform GlobalUniformBuffer
     GlobalUniforms global;
 };
 
+#ifdef INDIRECT
+layout (std430, set = 1, binding = 0) readonly buffer DrawBuffer
+{
+    DrawUniforms draws[];
+};
+
+#define geometry draws[gl_InstanceIndex].mGeometry
+#else
 layout (set = 1, binding = 0) uniform GeometryUniformBuffer 
 {
 	GeometryUniforms geometry;
 };
+#endif
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inTexcoord0;
@@ -22,8 +31,10 @@ layout(location = 0) out vec3 outPosition;
 layout(location = 1) out vec2 outTexcoord0;
 layout(location = 2) out vec2 outTexcoord1;
 layout(location = 3) out vec3 outNormal;
-layout(location = 4) out vec4 outShadowCoordinate;
 layout(location = 5) out vec4 outColor;
+#ifdef INDIRECT
+layout(location = 6) flat out uint outMaterialIndex;
+#endif
 
 out gl_PerVertex 
 {
@@ -40,8 +51,7 @@ void main()
     outNormal = normalize((geometry.mNormalMatrix * vec4(inNormal, 0.0)).xyz);
     outColor = vec4(1.0, 1.0, 1.0, 1.0);
 
-    // Shadow map coordinate computation
-    vec4 shadowCoord = (SHADOW_BIAS_MAT * global.mDirectionalLightVP) * vec4(outPosition, 1.0);
-	shadowCoord = shadowCoord / shadowCoord.w;
-    outShadowCoordinate = shadowCoord;
+#ifdef INDIRECT
+    outMaterialIndex = draws[gl_InstanceIndex].mMaterialIndex;
+#endif
 }  
\ No newline at end of file
@@ -18,16 +18,6 @@ layout (set = 1, binding = 0) uniform GeometryUniformBuffer
 	GeometryUniforms geometry;
 };
 
-layout(set = 2, binding = 0) uniform MaterialUniformBuffer
-{
-    MaterialUniforms material;
-};
-
-layout(set = 2, binding = 1) uniform sampler2D sampler0;
-layout(set = 2, binding = 2) uniform sampler2D sampler1;
-layout(set = 2, binding = 3) uniform sampler2D sampler2;
-layout(set = 2, binding = 4) uniform sampler2D sampler3;
-
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inTexcoord;
 layout(location = 2) in vec3 inNormal;
@@ -25,7 +25,6 @@ layout(location = 0) out vec3 outPosition;
 layout(location = 1) out vec2 outTexcoord0;
 layout(location = 2) out vec2 outTexcoord1;
 layout(location = 3) out vec3 outNormal;
-layout(location = 4) out vec4 outShadowCoordinate;
 layout(location = 5) out vec4 outColor;
 
 out gl_PerVertex 
@@ -46,9 +45,4 @@ void main()
     outTexcoord1 = inTexcoord1;    
     outNormal = normalize((geometry.mNormalMatrix * vec4(skinnedNormal, 0.0)).xyz);
     outColor = vec4(1.0, 1.0, 1.0, 1.0);
-
-    // Shadow map coordinate computation
-    vec4 shadowCoord = (SHADOW_BIAS_MAT * global.mDirectionalLightVP) * vec4(outPosition, 1.0);
-    shadowCoord = shadowCoord / shadowCoord.w;
-    outShadowCoordinate = shadowCoord;
 }
\ No newline at end of file
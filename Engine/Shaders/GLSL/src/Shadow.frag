@@ -1,5 +1,8 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
 
 #include "Common.glsl"
 
@@ -8,11 +11,44 @@ layout(set = 0, binding = 0) uniform GlobalUniformBuffer
     GlobalUniforms global;
 };
 
+#ifndef INDIRECT
 layout(set = 1, binding = 0) uniform GeometryUniformBuffer 
 {
 	GeometryUniforms geometry;
 };
+#endif
 
+#ifdef BINDLESS
+layout(std430, set = 2, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialUniforms materials[];
+};
+
+layout(set = 2, binding = 1) uniform sampler2D textures[];
+
+#ifdef INDIRECT
+// Draws of one indirect call can use different materials, so the texture index isn't uniform.
+layout(location = 1) flat in uint inMaterialIndex;
+
+#define material materials[inMaterialIndex]
+#define sampler0 textures[nonuniformEXT(material.mTextureIndices[0])]
+#define sampler1 textures[nonuniformEXT(material.mTextureIndices[1])]
+#define sampler2 textures[nonuniformEXT(material.mTextureIndices[2])]
+#define sampler3 textures[nonuniformEXT(material.mTextureIndices[3])]
+#else
+layout(push_constant) uniform DrawConstants
+{
+    uint mShadowCascade;
+    uint mMaterialIndex;
+} draw;
+
+#define material materials[draw.mMaterialIndex]
+#define sampler0 textures[material.mTextureIndices[0]]
+#define sampler1 textures[material.mTextureIndices[1]]
+#define sampler2 textures[material.mTextureIndices[2]]
+#define sampler3 textures[material.mTextureIndices[3]]
+#endif
+#else
 layout(set = 2, binding = 0) uniform MaterialUniformBuffer
 {
     MaterialUniforms material;
@@ -22,6 +58,7 @@ layout(set = 2, binding = 1) uniform sampler2D sampler0;
 layout(set = 2, binding = 2) uniform sampler2D sampler1;
 layout(set = 2, binding = 3) uniform sampler2D sampler2;
 layout(set = 2, binding = 4) uniform sampler2D sampler3;
+#endif
 
 layout(location = 0) in vec2 inTexcoord;
 
@@ -3,15 +3,37 @@
 
 #include "Common.glsl"
 
+layout (set = 0, binding = 0) uniform GlobalUniformBuffer 
+{
+    GlobalUniforms global;
+};
+
+#ifdef INDIRECT
+layout (std430, set = 1, binding = 0) readonly buffer DrawBuffer
+{
+    DrawUniforms draws[];
+};
+
+#define geometry draws[gl_InstanceIndex].mGeometry
+#else
 layout (set = 1, binding = 0) uniform GeometryUniformBuffer 
 {
 	GeometryUniforms geometry;
 };
+#endif
+
+layout (push_constant) uniform ShadowConstants
+{
+    uint mCascade;
+} shadow;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inTexcoord;
 
 layout(location = 0) out vec2 outTexcoord;
+#ifdef INDIRECT
+layout(location = 1) flat out uint outMaterialIndex;
+#endif
 
 out gl_PerVertex 
 {
@@ -20,6 +42,10 @@ out gl_PerVertex
 
 void main()
 {
-    gl_Position = geometry.mLightWVP * vec4(inPosition, 1.0);
+    gl_Position = global.mShadowCascadeVP[shadow.mCascade] * geometry.mWorldMatrix * vec4(inPosition, 1.0);
     outTexcoord = inTexcoord;
+
+#ifdef INDIRECT
+    outMaterialIndex = draws[gl_InstanceIndex].mMaterialIndex;
+#endif
 }
\ No newline at end of file
@@ -4,11 +4,21 @@
 #include "Common.glsl"
 #include "Skinning.glsl"
 
+layout (set = 0, binding = 0) uniform GlobalUniformBuffer 
+{
+    GlobalUniforms global;
+};
+
 layout (set = 1, binding = 0) uniform GeometryUniformBuffer 
 {
 	SkinnedGeometryUniforms geometry;
 };
 
+layout (push_constant) uniform ShadowConstants
+{
+    uint mCascade;
+} shadow;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inTexcoord;
 layout(location = 2) in vec3 inNormal;
@@ -28,6 +38,6 @@ void main()
     vec3 skinnedNormal = inNormal;
     SkinVertex(skinnedPosition, skinnedNormal, inBoneIndices, inBoneWeights, geometry);
 
-    gl_Position = geometry.mLightWVP * vec4(skinnedPosition, 1.0);
+    gl_Position = global.mShadowCascadeVP[shadow.mCascade] * geometry.mWorldMatrix * vec4(skinnedPosition, 1.0);
     outTexcoord = inTexcoord;
 }
\ No newline at end of file
@@ -8,13 +8,7 @@ layout (set = 0, binding = 0) uniform GlobalUniformBuffer
     GlobalUniforms global;
 };
 
-layout (set = 1, binding = 0) uniform QuadUniformBuffer
-{
-    mat4 mTransform;
-    vec4 mTint;
-
-} quadData;
-layout (set = 1, binding = 1) uniform sampler2D quadSampler;
+layout (set = 1, binding = 0) uniform sampler2D uiSampler;
 
 layout (location = 0) in vec2 inTexcoord;
 layout (location = 1) in vec4 inColor;
@@ -23,6 +17,6 @@ layout (location = 0) out vec4 outFinalColor;
 
 void main()
 {
-    vec4 textureColor = texture(quadSampler, inTexcoord).rgba;
-    outFinalColor = textureColor * inColor * quadData.mTint;
-}
\ No newline at end of file
+    vec4 textureColor = texture(uiSampler, inTexcoord).rgba;
+    outFinalColor = textureColor * inColor;
+}
@@ -8,14 +8,6 @@ layout (set = 0, binding = 0) uniform GlobalUniformBuffer
     GlobalUniforms global;
 };
 
-layout (set = 1, binding = 0) uniform QuadUniformBuffer
-{    
-    mat4 mTransform;
-    vec4 mTint;
-
-} quadData;
-layout (set = 1, binding = 1) uniform sampler2D quadSampler;
-
 layout (location = 0) in vec2 inPosition;
 layout (location = 1) in vec2 inTexcoord;
 layout (location = 2) in vec4 inColor;
@@ -30,10 +22,9 @@ out gl_PerVertex
 
 void main() 
 {    
+    // Widget transforms and tints are applied on the CPU when the vertices are batched.
     outTexcoord = inTexcoord;
     outColor = inColor;
-    mat3 transform = mat3(quadData.mTransform);
-    vec2 outPos = (transform * vec3(inPosition, 1.0)).xy;
-    outPos = (outPos / global.mInterfaceResolution) * 2.0f - 1.0f ;
+    vec2 outPos = (inPosition / global.mInterfaceResolution) * 2.0f - 1.0f;
     gl_Position = vec4(outPos, 0.0, 1.0);
 }
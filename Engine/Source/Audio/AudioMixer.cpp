@@ -0,0 +1,406 @@
+#include "Audio/AudioMixer.h"
+#include "System/System.h"
+#include "Log.h"
+
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define AUDIO_MIX_AVX 1
+#define AUDIO_MIX_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUDIO_MIX_AVX 0
+#define AUDIO_MIX_SSE 1
+#else
+#define AUDIO_MIX_AVX 0
+#define AUDIO_MIX_SSE 0
+#endif
+
+// Enough source frames to resample a full block at up to 4x the output rate (+2 for interpolation).
+// Faster voices are resampled in smaller sub-blocks.
+#define MIX_DECODE_CAPACITY (AUDIO_MIX_BLOCK_FRAMES * 4 + 2)
+
+alignas(32) static float sBusL[AUDIO_MIX_BLOCK_FRAMES];
+alignas(32) static float sBusR[AUDIO_MIX_BLOCK_FRAMES];
+alignas(32) static float sVoiceL[AUDIO_MIX_BLOCK_FRAMES];
+alignas(32) static float sVoiceR[AUDIO_MIX_BLOCK_FRAMES];
+alignas(32) static float sDecodeL[MIX_DECODE_CAPACITY];
+alignas(32) static float sDecodeR[MIX_DECODE_CAPACITY];
+
+typedef void(*DecodeFramesFP)(MixVoice& voice, int64_t startFrame, uint32_t numFrames, float* outL, float* outR);
+
+static inline float SampleToFloat(uint8_t sample)
+{
+    return (float(sample) - 128.0f) * (1.0f / 128.0f);
+}
+
+static inline float SampleToFloat(int16_t sample)
+{
+    return float(sample) * (1.0f / 32768.0f);
+}
+
+// Converts a run of source frames to deinterleaved float. The format is resolved once per voice
+// through the template parameters, so the inner loop has no channel / sample size branches.
+template<typename SampleType, uint32_t NumChannels>
+static void DecodeFrames(MixVoice& voice, int64_t startFrame, uint32_t numFrames, float* outL, float* outR)
+{
+    const SampleType* src = (const SampleType*) voice.mSrcBuffer;
+    const int64_t srcFrames = int64_t(voice.mSrcFrames);
+    int64_t frame = voice.mLoop ? (startFrame % srcFrames) : startFrame;
+
+    uint32_t i = 0;
+    while (i < numFrames)
+    {
+        if (frame >= srcFrames)
+        {
+            if (!voice.mLoop)
+            {
+                memset(outL + i, 0, (numFrames - i) * sizeof(float));
+                memset(outR + i, 0, (numFrames - i) * sizeof(float));
+                break;
+            }
+
+            frame = 0;
+        }
+
+        uint32_t run = uint32_t(glm::min(int64_t(numFrames - i), srcFrames - frame));
+        const SampleType* srcFrame = src + frame * NumChannels;
+
+        for (uint32_t r = 0; r < run; ++r)
+        {
+            outL[i + r] = SampleToFloat(srcFrame[0]);
+            outR[i + r] = SampleToFloat(srcFrame[NumChannels - 1]);
+            srcFrame += NumChannels;
+        }
+
+        i += run;
+        frame += run;
+    }
+}
+
+// Streamed voices keep their data IMA-ADPCM compressed and decode whole blocks into the
+// voice's ring the first time a frame from that block is needed.
+template<uint32_t NumChannels>
+static void DecodeFramesAdpcm(MixVoice& voice, int64_t startFrame, uint32_t numFrames, float* outL, float* outR)
+{
+    const int64_t srcFrames = int64_t(voice.mSrcFrames);
+    const uint32_t blockSize = AUD_GetImaAdpcmBlockSize(NumChannels);
+    int64_t frame = voice.mLoop ? (startFrame % srcFrames) : startFrame;
+
+    uint32_t i = 0;
+    while (i < numFrames)
+    {
+        if (frame >= srcFrames)
+        {
+            if (!voice.mLoop)
+            {
+                memset(outL + i, 0, (numFrames - i) * sizeof(float));
+                memset(outR + i, 0, (numFrames - i) * sizeof(float));
+                break;
+            }
+
+            frame = 0;
+        }
+
+        int64_t block = frame / IMA_ADPCM_FRAMES_PER_BLOCK;
+        uint32_t blockFrame = uint32_t(frame % IMA_ADPCM_FRAMES_PER_BLOCK);
+        uint32_t slot = uint32_t(block % AUDIO_STREAM_RING_BLOCKS);
+        int16_t* ringBlock = voice.mStreamRing + slot * IMA_ADPCM_FRAMES_PER_BLOCK * NumChannels;
+
+        if (voice.mStreamRingBlocks[slot] != block)
+        {
+            AUD_DecodeImaAdpcmBlock(voice.mSrcBuffer + block * blockSize, NumChannels, ringBlock);
+            voice.mStreamRingBlocks[slot] = block;
+        }
+
+        uint32_t run = uint32_t(glm::min(int64_t(numFrames - i), srcFrames - frame));
+        run = glm::min(run, IMA_ADPCM_FRAMES_PER_BLOCK - blockFrame);
+        const int16_t* srcFrame = ringBlock + blockFrame * NumChannels;
+
+        for (uint32_t r = 0; r < run; ++r)
+        {
+            outL[i + r] = SampleToFloat(srcFrame[0]);
+            outR[i + r] = SampleToFloat(srcFrame[NumChannels - 1]);
+            srcFrame += NumChannels;
+        }
+
+        i += run;
+        frame += run;
+    }
+}
+
+static DecodeFramesFP GetDecodeFunc(const MixVoice& voice)
+{
+    if (voice.mAdpcm)
+    {
+        return (voice.mNumChannels == 1) ? DecodeFramesAdpcm<1> : DecodeFramesAdpcm<2>;
+    }
+    else if (voice.mBytesPerSample == 1)
+    {
+        return (voice.mNumChannels == 1) ? DecodeFrames<uint8_t, 1> : DecodeFrames<uint8_t, 2>;
+    }
+    else
+    {
+        return (voice.mNumChannels == 1) ? DecodeFrames<int16_t, 1> : DecodeFrames<int16_t, 2>;
+    }
+}
+
+static void Accumulate(float* bus, const float* src, float volume, uint32_t numFrames)
+{
+    uint32_t i = 0;
+
+#if AUDIO_MIX_AVX
+    const __m256 vol8 = _mm256_set1_ps(volume);
+    for (; i + 8 <= numFrames; i += 8)
+    {
+        __m256 acc = _mm256_load_ps(bus + i);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_load_ps(src + i), vol8));
+        _mm256_store_ps(bus + i, acc);
+    }
+#endif
+
+#if AUDIO_MIX_SSE
+    const __m128 vol4 = _mm_set1_ps(volume);
+    for (; i + 4 <= numFrames; i += 4)
+    {
+        __m128 acc = _mm_load_ps(bus + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(src + i), vol4));
+        _mm_store_ps(bus + i, acc);
+    }
+#endif
+
+    for (; i < numFrames; ++i)
+    {
+        bus[i] += src[i] * volume;
+    }
+}
+
+static void WriteOutput(const float* busL, const float* busR, int16_t* out, uint32_t numFrames)
+{
+    uint32_t i = 0;
+
+#if AUDIO_MIX_SSE
+    const __m128 minVal = _mm_set1_ps(-1.0f);
+    const __m128 maxVal = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (; i + 4 <= numFrames; i += 4)
+    {
+        __m128 l = _mm_min_ps(_mm_max_ps(_mm_load_ps(busL + i), minVal), maxVal);
+        __m128 r = _mm_min_ps(_mm_max_ps(_mm_load_ps(busR + i), minVal), maxVal);
+        __m128i li = _mm_cvtps_epi32(_mm_mul_ps(l, scale));
+        __m128i ri = _mm_cvtps_epi32(_mm_mul_ps(r, scale));
+
+        // Interleave to L0 R0 L1 R1 | L2 R2 L3 R3 and pack down to int16
+        __m128i lr0 = _mm_unpacklo_epi32(li, ri);
+        __m128i lr1 = _mm_unpackhi_epi32(li, ri);
+        _mm_storeu_si128((__m128i*)(out + i * 2), _mm_packs_epi32(lr0, lr1));
+    }
+#endif
+
+    for (; i < numFrames; ++i)
+    {
+        out[i * 2 + 0] = int16_t(glm::clamp(busL[i], -1.0f, 1.0f) * 32767.0f);
+        out[i * 2 + 1] = int16_t(glm::clamp(busR[i], -1.0f, 1.0f) * 32767.0f);
+    }
+}
+
+static void MixVoiceBlock(MixVoice& voice, uint32_t numFrames, uint32_t outSampleRate)
+{
+    float srcStep = voice.mPitch * (voice.mSampleRate / float(outSampleRate));
+    srcStep = glm::clamp(srcStep, 0.0f, float(MIX_DECODE_CAPACITY - 2));
+
+    if (voice.mVolumeL == 0.0f && voice.mVolumeR == 0.0f)
+    {
+        // Silent voices (e.g. spatial sounds before their first attenuation update) just advance.
+        voice.mCurFrame += double(numFrames) * srcStep;
+        return;
+    }
+
+    DecodeFramesFP decodeFunc = GetDecodeFunc(voice);
+    uint32_t maxSubFrames = glm::max(1u, uint32_t(float(MIX_DECODE_CAPACITY - 2) / glm::max(srcStep, 0.0001f)));
+    uint32_t dstFrame = 0;
+
+    while (dstFrame < numFrames)
+    {
+        uint32_t subFrames = glm::min(numFrames - dstFrame, maxSubFrames);
+
+        int64_t baseFrame = int64_t(voice.mCurFrame);
+        float frac = float(voice.mCurFrame - double(baseFrame));
+        uint32_t numSrcFrames = glm::min(uint32_t(frac + (subFrames - 1) * srcStep) + 2, uint32_t(MIX_DECODE_CAPACITY));
+
+        decodeFunc(voice, baseFrame, numSrcFrames, sDecodeL, sDecodeR);
+
+        float* dstL = sVoiceL + dstFrame;
+        float* dstR = sVoiceR + dstFrame;
+
+        if (srcStep == 1.0f && frac == 0.0f)
+        {
+            memcpy(dstL, sDecodeL, subFrames * sizeof(float));
+            memcpy(dstR, sDecodeR, subFrames * sizeof(float));
+        }
+        else
+        {
+            float pos = frac;
+            for (uint32_t i = 0; i < subFrames; ++i)
+            {
+                int32_t idx = int32_t(pos);
+                float alpha = pos - float(idx);
+                dstL[i] = sDecodeL[idx] + alpha * (sDecodeL[idx + 1] - sDecodeL[idx]);
+                dstR[i] = sDecodeR[idx] + alpha * (sDecodeR[idx + 1] - sDecodeR[idx]);
+                pos += srcStep;
+            }
+        }
+
+        voice.mCurFrame += double(subFrames) * srcStep;
+        dstFrame += subFrames;
+    }
+
+    Accumulate(sBusL, sVoiceL, voice.mVolumeL, numFrames);
+    Accumulate(sBusR, sVoiceR, voice.mVolumeR, numFrames);
+}
+
+void AUD_MixVoices(
+    MixVoice* voices,
+    uint32_t numVoices,
+    int16_t* outBuffer,
+    uint32_t numFrames,
+    uint32_t outSampleRate)
+{
+    uint32_t frame = 0;
+
+    while (frame < numFrames)
+    {
+        uint32_t blockFrames = glm::min(numFrames - frame, uint32_t(AUDIO_MIX_BLOCK_FRAMES));
+
+        memset(sBusL, 0, sizeof(sBusL));
+        memset(sBusR, 0, sizeof(sBusR));
+
+        for (uint32_t i = 0; i < numVoices; ++i)
+        {
+            MixVoice& voice = voices[i];
+
+            if (voice.mActive &&
+                voice.mSrcFrames > 0 &&
+                !AUD_IsVoiceFinished(voice))
+            {
+                MixVoiceBlock(voice, blockFrames, outSampleRate);
+
+                if (voice.mLoop)
+                {
+                    voice.mCurFrame = fmod(voice.mCurFrame, double(voice.mSrcFrames));
+                }
+            }
+        }
+
+        WriteOutput(sBusL, sBusR, outBuffer + frame * 2, blockFrames);
+        frame += blockFrames;
+    }
+}
+
+bool AUD_IsVoiceFinished(const MixVoice& voice)
+{
+    return !voice.mLoop && voice.mCurFrame >= double(voice.mSrcFrames);
+}
+
+float AUD_BenchmarkMixer(uint32_t numVoices, float seconds)
+{
+    struct BenchSource
+    {
+        uint32_t mSampleRate;
+        uint32_t mNumChannels;
+        uint32_t mBytesPerSample;
+        std::vector<uint8_t> mData;
+    };
+
+    // One second of a sine tone in each supported PCM source format.
+    BenchSource sources[4] =
+    {
+        { 44100, 2, 2, {} },
+        { 22050, 1, 2, {} },
+        { 22050, 1, 1, {} },
+        { 32000, 2, 1, {} },
+    };
+
+    for (uint32_t s = 0; s < 4; ++s)
+    {
+        BenchSource& src = sources[s];
+        uint32_t numSamples = src.mSampleRate * src.mNumChannels;
+        src.mData.resize(numSamples * src.mBytesPerSample);
+
+        for (uint32_t i = 0; i < numSamples; ++i)
+        {
+            float value = sinf(float(i / src.mNumChannels) * 440.0f * 6.2831853f / src.mSampleRate);
+
+            if (src.mBytesPerSample == 1)
+            {
+                src.mData[i] = uint8_t(128.0f + value * 127.0f);
+            }
+            else
+            {
+                ((int16_t*)src.mData.data())[i] = int16_t(value * 32767.0f);
+            }
+        }
+    }
+
+    // A streamed copy of the stereo source exercises the IMA-ADPCM decode path.
+    std::vector<uint8_t> adpcmData;
+    AUD_EncodeImaAdpcm((const int16_t*)sources[0].mData.data(), sources[0].mSampleRate, 2, adpcmData);
+    std::vector<int16_t> streamRings;
+    streamRings.resize(numVoices * AUDIO_STREAM_RING_SAMPLES);
+
+    std::vector<MixVoice> voices(numVoices);
+    for (uint32_t i = 0; i < numVoices; ++i)
+    {
+        BenchSource& src = sources[i % 4];
+        voices[i].mSrcBuffer = src.mData.data();
+        voices[i].mSrcFrames = src.mSampleRate;
+        voices[i].mNumChannels = src.mNumChannels;
+        voices[i].mBytesPerSample = src.mBytesPerSample;
+        voices[i].mSampleRate = src.mSampleRate;
+        voices[i].mPitch = 0.75f + (i % 5) * 0.125f;
+        voices[i].mVolumeL = 0.5f;
+        voices[i].mVolumeR = 0.25f;
+        voices[i].mCurFrame = double(i * 97 % src.mSampleRate);
+        voices[i].mLoop = true;
+        voices[i].mActive = true;
+
+        if (i % 5 == 4)
+        {
+            voices[i].mSrcBuffer = adpcmData.data();
+            voices[i].mSrcFrames = sources[0].mSampleRate;
+            voices[i].mNumChannels = 2;
+            voices[i].mBytesPerSample = 2;
+            voices[i].mSampleRate = sources[0].mSampleRate;
+            voices[i].mAdpcm = true;
+            voices[i].mStreamRing = streamRings.data() + i * AUDIO_STREAM_RING_SAMPLES;
+        }
+    }
+
+    const uint32_t chunkFrames = 1024;
+    uint32_t totalFrames = uint32_t(seconds * AUDIO_MIX_OUTPUT_RATE);
+    std::vector<int16_t> output(chunkFrames * 2);
+
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+
+    for (uint32_t frame = 0; frame < totalFrames; frame += chunkFrames)
+    {
+        uint32_t numFrames = glm::min(chunkFrames, totalFrames - frame);
+        AUD_MixVoices(voices.data(), numVoices, output.data(), numFrames);
+    }
+
+    uint64_t endTime = SYS_GetTimeMicroseconds();
+    float elapsedMs = (endTime - startTime) / 1000.0f;
+
+    LogDebug("Mixed %u voices for %.1f sec in %.2f ms (%.1fx realtime)",
+        numVoices,
+        seconds,
+        elapsedMs,
+        (elapsedMs > 0.0f) ? (seconds * 1000.0f / elapsedMs) : 0.0f);
+
+    return elapsedMs;
+}
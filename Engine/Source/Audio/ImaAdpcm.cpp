@@ -0,0 +1,151 @@
+#include "Audio/ImaAdpcm.h"
+
+#include <string.h>
+#include <assert.h>
+
+static const int32_t sStepTable[89] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int32_t sIndexTable[16] =
+{
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+struct AdpcmState
+{
+    int32_t mPredictor = 0;
+    int32_t mIndex = 0;
+};
+
+static inline int32_t ClampInt(int32_t value, int32_t minVal, int32_t maxVal)
+{
+    return (value < minVal) ? minVal : ((value > maxVal) ? maxVal : value);
+}
+
+static inline int16_t DecodeNibble(AdpcmState& state, uint8_t code)
+{
+    int32_t step = sStepTable[state.mIndex];
+    int32_t delta = step >> 3;
+
+    if (code & 4) { delta += step; }
+    if (code & 2) { delta += step >> 1; }
+    if (code & 1) { delta += step >> 2; }
+
+    state.mPredictor += (code & 8) ? -delta : delta;
+    state.mPredictor = ClampInt(state.mPredictor, -32768, 32767);
+    state.mIndex = ClampInt(state.mIndex + sIndexTable[code], 0, 88);
+
+    return int16_t(state.mPredictor);
+}
+
+static inline uint8_t EncodeSample(AdpcmState& state, int16_t sample)
+{
+    int32_t diff = int32_t(sample) - state.mPredictor;
+    uint8_t code = 0;
+
+    if (diff < 0)
+    {
+        code = 8;
+        diff = -diff;
+    }
+
+    int32_t step = sStepTable[state.mIndex];
+
+    if (diff >= step) { code |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 1; }
+
+    // Run the decoder so the encoder tracks exactly what playback will reconstruct.
+    DecodeNibble(state, code);
+
+    return code;
+}
+
+uint32_t AUD_GetImaAdpcmBlockSize(uint32_t numChannels)
+{
+    return IMA_ADPCM_CHANNEL_BLOCK_SIZE * numChannels;
+}
+
+uint32_t AUD_GetImaAdpcmNumBlocks(uint32_t numFrames)
+{
+    return (numFrames + IMA_ADPCM_FRAMES_PER_BLOCK - 1) / IMA_ADPCM_FRAMES_PER_BLOCK;
+}
+
+void AUD_EncodeImaAdpcm(
+    const int16_t* samples,
+    uint32_t numFrames,
+    uint32_t numChannels,
+    std::vector<uint8_t>& outData)
+{
+    assert(numChannels == 1 || numChannels == 2);
+
+    uint32_t numBlocks = AUD_GetImaAdpcmNumBlocks(numFrames);
+    uint32_t blockSize = AUD_GetImaAdpcmBlockSize(numChannels);
+    outData.clear();
+    outData.resize(numBlocks * blockSize, 0);
+
+    AdpcmState states[2];
+
+    for (uint32_t b = 0; b < numBlocks; ++b)
+    {
+        uint32_t firstFrame = b * IMA_ADPCM_FRAMES_PER_BLOCK;
+
+        for (uint32_t c = 0; c < numChannels; ++c)
+        {
+            AdpcmState& state = states[c];
+            uint8_t* dst = outData.data() + b * blockSize + c * IMA_ADPCM_CHANNEL_BLOCK_SIZE;
+
+            // Header holds the decoder state at the start of the block
+            dst[0] = uint8_t(state.mPredictor & 0xff);
+            dst[1] = uint8_t((state.mPredictor >> 8) & 0xff);
+            dst[2] = uint8_t(state.mIndex);
+            dst[3] = 0;
+            dst += IMA_ADPCM_CHANNEL_HEADER_SIZE;
+
+            for (uint32_t f = 0; f < IMA_ADPCM_FRAMES_PER_BLOCK; ++f)
+            {
+                uint32_t frame = firstFrame + f;
+                int16_t sample = (frame < numFrames) ? samples[frame * numChannels + c] : 0;
+                uint8_t code = EncodeSample(state, sample);
+
+                dst[f / 2] |= (f & 1) ? (code << 4) : code;
+            }
+        }
+    }
+}
+
+void AUD_DecodeImaAdpcmBlock(const uint8_t* block, uint32_t numChannels, int16_t* outSamples)
+{
+    for (uint32_t c = 0; c < numChannels; ++c)
+    {
+        const uint8_t* src = block + c * IMA_ADPCM_CHANNEL_BLOCK_SIZE;
+
+        AdpcmState state;
+        state.mPredictor = int16_t(uint16_t(src[0]) | (uint16_t(src[1]) << 8));
+        state.mIndex = ClampInt(src[2], 0, 88);
+        src += IMA_ADPCM_CHANNEL_HEADER_SIZE;
+
+        int16_t* dst = outSamples + c;
+
+        for (uint32_t i = 0; i < IMA_ADPCM_FRAMES_PER_BLOCK / 2; ++i)
+        {
+            uint8_t byte = src[i];
+            dst[0] = DecodeNibble(state, byte & 0x0f);
+            dst[numChannels] = DecodeNibble(state, byte >> 4);
+            dst += numChannels * 2;
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "Audio/Audio.h"
 #include "Audio/AudioConstants.h"
+#include "Audio/AudioMixer.h"
 #include "System/System.h"
 
 #include "Assets/SoundWave.h"
@@ -15,23 +16,8 @@ snd_pcm_uframes_t sPlaybackFrames = 0;
 uint32_t sMixBufferLen = 0;
 int16_t* sMixBuffer = nullptr;
 
-struct SoundVoice
-{
-    int32_t mSampleRate = 44100;
-    float mPitch = 1.0f;
-    float mVolumeL = 1.0f;
-    float mVolumeR = 1.0f;
-    uint8_t* mSrcBuffer = nullptr;
-    uint32_t mSrcBufferLen = 0;
-    uint32_t mSrcFrames = 0;
-    float mCurFrame = 0;
-    uint32_t mNumChannels = 2;
-    uint32_t mBytesPerSample = 2;
-    bool mLoop = false;
-    bool mActive = false;
-};
-
-static SoundVoice sVoices[AUDIO_MAX_VOICES];
+static MixVoice sVoices[AUDIO_MAX_VOICES];
+static int16_t sStreamRings[AUDIO_MAX_VOICES][AUDIO_STREAM_RING_SAMPLES];
 
 void AUD_Initialize()
 {
@@ -121,112 +107,8 @@ void AUD_Update()
 
     if (frames > 0)
     {
-        // We need to mix an audio buffer
-        //assert(frames * 4  <= int32_t(sMixBufferLen));
-        memset(sMixBuffer, 0, frames * 4);
-
-        for (uint32_t i = 0; i < AUDIO_MAX_VOICES; ++i)
-        {
-            if (sVoices[i].mActive)
-            {
-                SoundVoice& voice = sVoices[i];
-                assert(voice.mSrcFrames > 0);
-
-                // If the voice is active, that means we need to mix *frames* number of frames
-                // into the mix buffer. The src voice may move at a faster or slower pace based on the 
-                // pitch value, so we will need to interpolate between frames.
-
-                // TODO: Handle pitch
-                float srcDeltaFrame = 1 * voice.mPitch * (voice.mSampleRate / 44100.0f);
-
-                for (int32_t dstFrame = 0; dstFrame < frames; ++dstFrame)
-                {
-                    float srcFrameFloat = voice.mCurFrame + (dstFrame * srcDeltaFrame);
-
-                    int32_t srcFrames[2] = { int32_t(srcFrameFloat), int32_t(srcFrameFloat) + 1 };
-                    float frameInterpAlpha = fmod(srcFrameFloat, 1.0f);
-
-                    int16_t srcSampleL[2] = { 0, 0 };
-                    int16_t srcSampleR[2] = { 0, 0 };
-
-                    if (voice.mLoop)
-                    {
-                        if (srcFrames[0] >= int32_t(voice.mSrcFrames))
-                            srcFrames[0] = srcFrames[0] % voice.mSrcFrames;
-                        if (srcFrames[1] >= int32_t(voice.mSrcFrames))
-                            srcFrames[1] = srcFrames[1] % voice.mSrcFrames;
-                    }
-
-                    // Interpolate between the two src frames
-                    for (int32_t f = 0; f < 2; ++f)
-                    {
-                        int32_t frameIndex = srcFrames[f];
-
-                        if (frameIndex >= int32_t(voice.mSrcFrames))
-                        {
-                            srcSampleL[f] = 0;
-                            srcSampleR[f] = 0;
-                        }
-                        else if (voice.mNumChannels == 1)
-                        {
-                            // Use same src sample for left and right dst samples
-
-                            if (voice.mBytesPerSample == 1)
-                            {
-                                // uint8 samples
-                                // Convert from uint8_t to int16_t
-                                srcSampleL[f] = *((uint8_t*) (voice.mSrcBuffer + (frameIndex * 1 * 1)));
-                                srcSampleL[f] = srcSampleL[f] * 256 - 32767;
-                                srcSampleR[f] = srcSampleL[f];   
-                            }
-                            else
-                            {
-                                // int16 samples
-                                srcSampleL[f] = *((int16_t*) (voice.mSrcBuffer + (frameIndex * 1 * 2)));
-                                srcSampleR[f] = srcSampleL[f];
-                            }
-                        }
-                        else
-                        {
-                            if (voice.mBytesPerSample == 1)
-                            {
-                                // uint8 samples
-                                srcSampleL[f] = *((uint8_t*) (voice.mSrcBuffer + (frameIndex * 2 * 1)));
-                                srcSampleR[f] = *((uint8_t*) (voice.mSrcBuffer + (frameIndex * 2 * 1 + 1)));
-                                srcSampleL[f] = srcSampleL[f] * 256 - 32767;
-                                srcSampleR[f] = srcSampleR[f] * 256 - 32767;
-                            }
-                            else
-                            {
-                                // int16 samples
-                                srcSampleL[f] = *((int16_t*) (voice.mSrcBuffer + (frameIndex * 2 * 2)));
-                                srcSampleR[f] = *((int16_t*) (voice.mSrcBuffer + (frameIndex * 2 * 2 + 2)));
-                            }
-                        }
-                    }
-
-                    // We have four samples now, so now we need to linearly interpolate between the left and right channels
-                    // to get a final 2 samples that we will accumulate into the mix buffer.
-                    int16_t finalSampleL = glm::mix(srcSampleL[0], srcSampleL[1], frameInterpAlpha);
-                    int16_t finalSampleR = glm::mix(srcSampleR[0], srcSampleR[1], frameInterpAlpha);
-                    finalSampleL *= voice.mVolumeL;
-                    finalSampleR *= voice.mVolumeR;
-                    sMixBuffer[dstFrame * 2 + 0] = glm::clamp(finalSampleL + sMixBuffer[dstFrame * 2 + 0], -32768, 32767);
-                    sMixBuffer[dstFrame * 2 + 1] = glm::clamp(finalSampleR + sMixBuffer[dstFrame * 2 + 1], -32768, 32767);
-                }
-
-                // We've finished getting all of the samples for this voice. Increase the current sample value
-                // to keep track of where to pick up next frame. If the sound is looping we need to mod the frame value
-                // otherwise let the curFrame exceed the *voice.mSrcFrames* count so we can determine that it is finished playing.
-
-                voice.mCurFrame += (frames * srcDeltaFrame);
-
-                if (voice.mLoop)
-                {
-                    voice.mCurFrame = fmod(voice.mCurFrame, (float) voice.mSrcFrames);
-                }
-            }
-        }
+        // Voices are mixed into a float bus and only converted/clamped to int16 once at the end.
+        AUD_MixVoices(sVoices, AUDIO_MAX_VOICES, sMixBuffer, uint32_t(frames));
     }
 
     snd_pcm_sframes_t framesWritten = 0;
@@ -257,22 +139,35 @@ void AUD_Play(
 
     sVoices[voiceIndex].mActive = true;
     sVoices[voiceIndex].mBytesPerSample = soundWave->GetBitsPerSample() / 8;
-    sVoices[voiceIndex].mCurFrame = 0.0f;
+    sVoices[voiceIndex].mCurFrame = double(startTime) * soundWave->GetSampleRate();
     sVoices[voiceIndex].mLoop = loop;
     sVoices[voiceIndex].mNumChannels = soundWave->GetNumChannels();
     sVoices[voiceIndex].mPitch = pitch;
     sVoices[voiceIndex].mSampleRate = soundWave->GetSampleRate();
     sVoices[voiceIndex].mSrcBuffer = soundWave->GetWaveData();
-    sVoices[voiceIndex].mSrcBufferLen = soundWave->GetWaveDataSize();
     sVoices[voiceIndex].mVolumeL = spatial ? 0.0f : volume;
     sVoices[voiceIndex].mVolumeR = spatial ? 0.0f : volume;
-    
-    int32_t bytesPerFrame = sVoices[voiceIndex].mBytesPerSample * sVoices[voiceIndex].mNumChannels;
-    sVoices[voiceIndex].mSrcFrames = sVoices[voiceIndex].mSrcBufferLen / bytesPerFrame;
+    sVoices[voiceIndex].mAdpcm = (soundWave->GetWaveFormat() == SoundWaveFormat::ImaAdpcm);
+    sVoices[voiceIndex].mStreamRing = sStreamRings[voiceIndex];
+
+    for (uint32_t i = 0; i < AUDIO_STREAM_RING_BLOCKS; ++i)
+    {
+        sVoices[voiceIndex].mStreamRingBlocks[i] = -1;
+    }
 
-    assert(sVoices[voiceIndex].mSrcBufferLen % bytesPerFrame == 0);
+    int32_t bytesPerFrame = sVoices[voiceIndex].mBytesPerSample * sVoices[voiceIndex].mNumChannels;
     assert(bytesPerFrame > 0 &&
            bytesPerFrame <= 4);
+
+    if (sVoices[voiceIndex].mAdpcm)
+    {
+        sVoices[voiceIndex].mSrcFrames = soundWave->GetNumFrames();
+    }
+    else
+    {
+        sVoices[voiceIndex].mSrcFrames = soundWave->GetWaveDataSize() / bytesPerFrame;
+        assert(soundWave->GetWaveDataSize() % bytesPerFrame == 0);
+    }
 }
 
 void AUD_Stop(uint32_t voiceIndex)
@@ -283,7 +178,7 @@ void AUD_Stop(uint32_t voiceIndex)
 bool AUD_IsPlaying(uint32_t voiceIndex)
 {
     return sVoices[voiceIndex].mActive &&
-           sVoices[voiceIndex].mCurFrame < sVoices[voiceIndex].mSrcFrames;
+           !AUD_IsVoiceFinished(sVoices[voiceIndex]);
 }
 
 void AUD_SetVolume(uint32_t voiceIndex, float leftVolume, float rightVolume)
@@ -1,6 +1,7 @@
 #if EDITOR
 
 #include "ActionManager.h"
+#include "AssetCooker.h"
 
 #if PLATFORM_WINDOWS
 #include <Windows.h>
@@ -173,23 +174,9 @@ void ActionManager::ShowBuildDataPrompt()
     GetActionList()->SetActions(actions, HandleBuildButtonPressed);
 }
 
-void ActionManager::BuildData(Platform platform, bool embedded)
+std::string ActionManager::CookAssets(Platform platform, std::vector<std::pair<AssetStub*, std::string> >& outPackFiles)
 {
-    const EngineState* engineState = GetEngineState();
-    bool standalone = engineState->mStandalone;
-    const std::string& projectDir = engineState->mProjectDirectory;
-    const std::string& projectName = engineState->mProjectName;
-
-    std::vector<std::pair<AssetStub*, std::string> > embeddedAssets;
-
-    if (projectDir == "")
-    {
-        LogError("Project directory not set?");
-        return;
-    }
-
-    // Build Data is responsible for 3 things
-    // (1) Create a Packaged directory in ProjectDir/Packaged. Erase previous packaged first.
+    const std::string& projectDir = GetEngineState()->mProjectDirectory;
     std::string packagedDir = projectDir + "Packaged/";
 
     // Create top level Packaged dir first.
@@ -198,77 +185,14 @@ void ActionManager::BuildData(Platform platform, bool embedded)
         CreateDir(packagedDir.c_str());
     }
 
-    // Create platform-specific packaged dir. Delete old platform dir if it exists.
+    // Create platform-specific packaged dir. Previous outputs are kept so the cook can skip up-to-date assets.
     packagedDir += GetPlatformString(platform);
     packagedDir += "/";
-    if (DoesDirExist(packagedDir.c_str()))
+    if (!DoesDirExist(packagedDir.c_str()))
     {
-        RemoveDir(packagedDir.c_str());
+        CreateDir(packagedDir.c_str());
     }
 
-    CreateDir(packagedDir.c_str());
-
-    // (2) Iterate over AssetDirs and save each file (platform-specific save) to the Packaged folder.
-    std::function<void(AssetDir*, bool)> saveDir = [&](AssetDir* dir, bool engine)
-    {
-        std::string packDir;
-        if (engine)
-        {
-            packDir = packagedDir + dir->mPath + "/";
-        }
-        else
-        {
-            packDir = dir->mPath;
-            packDir = packDir.substr(projectDir.length());
-            packDir = packagedDir + projectName + "/" + packDir;
-        }
-
-        if (!DoesDirExist(packDir.c_str()))
-        {
-            CreateDir(packDir.c_str());
-        }
-
-        // Cook the assets into our packaged folder
-        for (uint32_t i = 0; i < dir->mAssetStubs.size(); ++i)
-        {
-            AssetStub* stub = dir->mAssetStubs[i];
-            bool alreadyLoaded = (stub->mAsset != nullptr);
-
-            if (!alreadyLoaded)
-            {
-                AssetManager::Get()->LoadAsset(*stub);
-            }
-
-            std::string packFile = packDir + stub->mAsset->GetName() + ".oct";
-            stub->mAsset->SaveFile(packFile.c_str(), platform);
-
-            if (true)
-            {
-                // Save the asset in the src location. There is probably a better time and place for this.
-                AssetManager::Get()->SaveAsset(*stub);
-            }
-
-            // Currently either embed everything or embed nothing...
-            // Embed flag on Asset does nothing, but if we want to keep that feature, then 
-            // we need to load the asset if it's not loaded, add to embedded list if it's flagged and then probably unload it after.
-            if (embedded)
-            {
-                embeddedAssets.push_back({ stub, packFile });
-            }
-
-            if (!alreadyLoaded)
-            {
-                AssetManager::Get()->UnloadAsset(*stub);
-            }
-        }
-
-        // Cook child dirs
-        for (uint32_t i = 0; i < dir->mChildDirs.size(); ++i)
-        {
-            saveDir(dir->mChildDirs[i], engine);
-        }
-    };
-
     AssetDir* engineAssetDir = AssetManager::Get()->FindEngineDirectory();
     AssetDir* projectAssetDir = AssetManager::Get()->FindProjectDirectory();
     std::string packEngineDir = packagedDir + engineAssetDir->mName + "/";
@@ -276,8 +200,40 @@ void ActionManager::BuildData(Platform platform, bool embedded)
     CreateDir(packEngineDir.c_str());
     CreateDir(packProjectDir.c_str());
 
-    saveDir(engineAssetDir, true);
-    saveDir(projectAssetDir, false);
+    AssetCooker cooker(platform, packagedDir);
+    cooker.Cook(outPackFiles);
+
+    return packagedDir;
+}
+
+void ActionManager::BuildData(Platform platform, bool embedded)
+{
+    const EngineState* engineState = GetEngineState();
+    bool standalone = engineState->mStandalone;
+    const std::string& projectDir = engineState->mProjectDirectory;
+    const std::string& projectName = engineState->mProjectName;
+
+    std::vector<std::pair<AssetStub*, std::string> > embeddedAssets;
+
+    if (projectDir == "")
+    {
+        LogError("Project directory not set?");
+        return;
+    }
+
+    // Build Data is responsible for 3 things
+    // (1) Create a Packaged directory in ProjectDir/Packaged.
+    // (2) Cook each asset (platform-specific save) into the Packaged folder.
+    std::vector<std::pair<AssetStub*, std::string> > packFiles;
+    std::string packagedDir = CookAssets(platform, packFiles);
+
+    // Currently either embed everything or embed nothing...
+    // Embed flag on Asset does nothing, but if we want to keep that feature, then 
+    // we need to load the asset if it's not loaded, add to embedded list if it's flagged and then probably unload it after.
+    if (embedded)
+    {
+        embeddedAssets = packFiles;
+    }
 
     // (3) Generate .cpp / .h files (empty if not embedded) using the .oct files in the Packaged folder.
     // (4) Create and save an asset registry file with simple list of asset paths into Packaged folder.
@@ -323,7 +279,8 @@ void ActionManager::BuildData(Platform platform, bool embedded)
 
     std::string embeddedHeaderPath = projectDir + "Generated/EmbeddedAssets.h";
     std::string embeddedSourcePath = projectDir + "Generated/EmbeddedAssets.cpp";
-    GenerateEmbeddedAssetFiles(embeddedAssets, embeddedHeaderPath.c_str(), embeddedSourcePath.c_str());
+    std::string embeddedBlobPath = projectDir + "Generated/EmbeddedAssets.bin";
+    GenerateEmbeddedAssetFiles(embeddedAssets, embeddedHeaderPath.c_str(), embeddedSourcePath.c_str(), embeddedBlobPath.c_str());
 
     // Generate embedded script source files. If not doing an embedded build, copy over the script folders.
     std::vector<std::string> scriptFiles;
@@ -335,6 +292,11 @@ void ActionManager::BuildData(Platform platform, bool embedded)
     }
     else
     {
+        // The packaged dir isn't wiped between builds anymore, so clear out the old script copies first.
+        std::string packEngineScripts = packagedDir + "Engine/Scripts";
+        std::string packProjectScripts = packagedDir + projectName + "/Scripts";
+        if (DoesDirExist(packEngineScripts.c_str())) { RemoveDir(packEngineScripts.c_str()); }
+        if (DoesDirExist(packProjectScripts.c_str())) { RemoveDir(packProjectScripts.c_str()); }
         SYS_Exec(std::string("cp -R Engine/Scripts " + packagedDir + "Engine/Scripts").c_str());
         SYS_Exec(std::string("cp -R " + projectDir + "Scripts " + packagedDir + projectName + "/Scripts").c_str());
     }
@@ -1195,14 +1157,16 @@ void ActionManager::ImportScene()
 
 void ActionManager::GenerateEmbeddedAssetFiles(std::vector<std::pair<AssetStub*, std::string> >& assets,
     const char* headerPath,
-    const char* sourcePath)
+    const char* sourcePath,
+    const char* blobPath)
 {
     FILE* headerFile = fopen(headerPath, "w");
     FILE* sourceFile = fopen(sourcePath, "w");
+    FILE* blobFile = fopen(blobPath, "wb");
 
-    assert(headerFile != nullptr && sourceFile != nullptr);
+    assert(headerFile != nullptr && sourceFile != nullptr && blobFile != nullptr);
 
-    if (headerFile != nullptr && sourceFile != nullptr)
+    if (headerFile != nullptr && sourceFile != nullptr && blobFile != nullptr)
     {
         fprintf(headerFile, "#include <stdint.h>\n");
         fprintf(headerFile, "#include \"EmbeddedFile.h\"\n\n");
@@ -1213,7 +1177,10 @@ void ActionManager::GenerateEmbeddedAssetFiles(std::vector<std::pair<AssetStub*,
         fprintf(sourceFile, "#include <stdint.h>\n");
         fprintf(sourceFile, "#include \"EmbeddedFile.h\"\n\n");
 
+        // All packaged assets are appended to one binary blob which the assembler pulls in with .incbin,
+        // so the generated source only holds a small index table instead of every byte as a char literal.
         std::string initializer;
+        uint32_t blobSize = 0;
 
         for (int32_t i = 0; i < int32_t(assets.size()); ++i)
         {
@@ -1221,62 +1188,84 @@ void ActionManager::GenerateEmbeddedAssetFiles(std::vector<std::pair<AssetStub*,
             const std::string& packPath = assets[i].second;
 
             Stream stream;
-            
-            // Handle special case for level
             stream.ReadFile(packPath.c_str());
             uint32_t size = uint32_t(stream.GetSize());
-            char* data = stream.GetData();
-
-            std::string sourceString;
-            sourceString.reserve(2048);
-
-            std::string assetDataVar = stub->mName + "_Data";
-            sourceString += "const char ";
-            sourceString += assetDataVar;
-            sourceString += "[] = \n{\n";
 
-            for (uint32_t byte = 0; byte < size; ++byte)
+            // Keep each asset aligned in case the data is handed to hardware directly.
+            uint32_t padding = (EMBEDDED_ASSET_ALIGNMENT - (blobSize % EMBEDDED_ASSET_ALIGNMENT)) % EMBEDDED_ASSET_ALIGNMENT;
+            for (uint32_t p = 0; p < padding; ++p)
             {
-                char byteString[8] = {};
-                sprintf(byteString, "'\\x%02X',", uint8_t(data[byte]));
-
-                sourceString += byteString;
-
-                if (byte % 8 == 7)
-                {
-                    sourceString += "\n";
-                }
+                fputc(0, blobFile);
             }
+            blobSize += padding;
 
-            sourceString += "\n};\n\n";
-
-            fprintf(sourceFile, "%s", sourceString.c_str());
+            fwrite(stream.GetData(), 1, size, blobFile);
 
             initializer += "{" + ("\"" + stub->mName + "\",") +
-                                 (assetDataVar + ",") +
+                                 ("gEmbeddedAssetBlob + " + std::to_string(blobSize) + ",") +
                                  (std::to_string(size) + ",") +
                                  (stub->mEngineAsset ? "true" : "false") +
                                  "}, \n";
+
+            blobSize += size;
         }
 
-        fprintf(sourceFile, "\n\nuint32_t gNumEmbeddedAssets = %d;\n", uint32_t(assets.size()));
+        fclose(blobFile);
+        blobFile = nullptr;
+
+        fprintf(sourceFile, "uint32_t gNumEmbeddedAssets = %d;\n", uint32_t(assets.size()));
 
         if (assets.size() > 0)
         {
-            fprintf(sourceFile, "\n\nEmbeddedFile gEmbeddedAssets[] = \n{\n");
+            // The blob sits next to the generated source, the project makefiles add Generated/ to the assembler's
+            // include path (-Wa,-I) so the file name alone keeps the source independent of where it was packaged.
+            std::string incbinPath = blobPath;
+            std::replace(incbinPath.begin(), incbinPath.end(), '\\', '/');
+            incbinPath = incbinPath.substr(incbinPath.find_last_of('/') + 1);
+
+            fprintf(sourceFile, "\n#if defined(_MSC_VER)\n");
+            fprintf(sourceFile, "#error \"Embedded asset blobs require a GCC compatible toolchain (.incbin)\"\n");
+            fprintf(sourceFile, "#endif\n\n");
+
+            fprintf(sourceFile, "extern \"C\" const char gEmbeddedAssetBlob[];\n\n");
+            fprintf(sourceFile, "__asm__(\n");
+            fprintf(sourceFile, "    \".section .rodata\\n\"\n");
+            fprintf(sourceFile, "    \".global gEmbeddedAssetBlob\\n\"\n");
+            fprintf(sourceFile, "    \".balign %d\\n\"\n", EMBEDDED_ASSET_ALIGNMENT);
+            fprintf(sourceFile, "    \"gEmbeddedAssetBlob:\\n\"\n");
+            fprintf(sourceFile, "    \".incbin \\\"%s\\\"\\n\"\n", incbinPath.c_str());
+            fprintf(sourceFile, "    \".previous\\n\"\n");
+            fprintf(sourceFile, ");\n");
+
+            fprintf(sourceFile, "\nEmbeddedFile gEmbeddedAssets[] = \n{\n");
             fprintf(sourceFile, "%s", initializer.c_str());
             fprintf(sourceFile, "\n};\n");
         }
         else
         {
-            fprintf(sourceFile, "\n\nEmbeddedFile gEmbeddedAssets[] = { {} };\n");
+            fprintf(sourceFile, "\nEmbeddedFile gEmbeddedAssets[] = { {} };\n");
         }
 
+        LogDebug("Embedded %d assets into a %d byte blob", uint32_t(assets.size()), blobSize);
+    }
+
+    if (headerFile != nullptr)
+    {
         fclose(headerFile);
         headerFile = nullptr;
+    }
+
+    if (sourceFile != nullptr)
+    {
         fclose(sourceFile);
         sourceFile = nullptr;
     }
+
+    if (blobFile != nullptr)
+    {
+        fclose(blobFile);
+        blobFile = nullptr;
+    }
 }
 
 void ActionManager::GenerateEmbeddedScriptFiles(
@@ -0,0 +1,326 @@
+#if EDITOR
+
+#include "AssetCooker.h"
+#include "AssetManager.h"
+#include "AssetDir.h"
+#include "Asset.h"
+#include "Engine.h"
+#include "Utilities.h"
+#include "Log.h"
+
+#include "System/System.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <algorithm>
+
+static uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size)
+{
+    // 64-bit FNV-1a
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+AssetCooker::AssetCooker(Platform platform, const std::string& packagedDir) :
+    mPlatform(platform),
+    mPackagedDir(packagedDir)
+{
+
+}
+
+CookStats AssetCooker::Cook(std::vector<std::pair<AssetStub*, std::string> >& outPackFiles)
+{
+    CookStats stats;
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+
+    LoadManifest();
+
+    AssetDir* engineAssetDir = AssetManager::Get()->FindEngineDirectory();
+    AssetDir* projectAssetDir = AssetManager::Get()->FindProjectDirectory();
+    GatherJobs(engineAssetDir, true);
+    GatherJobs(projectAssetDir, false);
+
+    // Remove outputs of assets that no longer exist.
+    std::unordered_map<std::string, uint64_t> newManifest;
+
+    for (uint32_t i = 0; i < mJobs.size(); ++i)
+    {
+        newManifest[mJobs[i].mManifestKey] = 0;
+    }
+
+    for (auto& pair : mManifest)
+    {
+        if (newManifest.find(pair.first) == newManifest.end())
+        {
+            std::string stalePath = mPackagedDir + pair.first;
+
+            if (DoesFileExist(stalePath.c_str()))
+            {
+                SYS_RemoveFile(stalePath.c_str());
+                stats.mNumRemoved++;
+            }
+        }
+    }
+
+    // Figure out which assets actually need cooking.
+    std::vector<CookJob*> pendingJobs;
+
+    for (uint32_t i = 0; i < mJobs.size(); ++i)
+    {
+        CookJob& job = mJobs[i];
+        auto it = mManifest.find(job.mManifestKey);
+
+        job.mSourceHash = HashSource(job.mStub);
+        job.mUpToDate = (job.mSourceHash != 0 &&
+            it != mManifest.end() &&
+            it->second == job.mSourceHash &&
+            DoesFileExist(job.mPackFile.c_str()));
+
+        if (job.mUpToDate)
+        {
+            newManifest[job.mManifestKey] = job.mSourceHash;
+            stats.mNumSkipped++;
+        }
+        else
+        {
+            pendingJobs.push_back(&job);
+        }
+
+        outPackFiles.push_back({ job.mStub, job.mPackFile });
+    }
+
+    // Cook in batches so only a bounded number of assets are loaded at once.
+    uint32_t numThreads = glm::clamp(std::thread::hardware_concurrency(), 1u, uint32_t(COOK_MAX_THREADS));
+    uint32_t batchSize = numThreads * COOK_BATCH_JOBS_PER_THREAD;
+    mMutex = SYS_CreateMutex();
+
+    for (uint32_t start = 0; start < pendingJobs.size(); start += batchSize)
+    {
+        uint32_t end = glm::min(start + batchSize, uint32_t(pendingJobs.size()));
+        std::vector<CookJob*> batch(pendingJobs.begin() + start, pendingJobs.begin() + end);
+        std::vector<bool> alreadyLoaded(batch.size());
+
+        for (uint32_t i = 0; i < batch.size(); ++i)
+        {
+            AssetStub* stub = batch[i]->mStub;
+            alreadyLoaded[i] = (stub->mAsset != nullptr);
+
+            if (!alreadyLoaded[i])
+            {
+                AssetManager::Get()->LoadAsset(*stub);
+            }
+        }
+
+        CookBatch(batch);
+
+        for (uint32_t i = 0; i < batch.size(); ++i)
+        {
+            AssetStub* stub = batch[i]->mStub;
+
+            // Save the asset in the src location. There is probably a better time and place for this.
+            // The manifest hash is taken afterwards so the resave doesn't look like a change next time.
+            AssetManager::Get()->SaveAsset(*stub);
+            newManifest[batch[i]->mManifestKey] = HashSource(stub);
+
+            if (!alreadyLoaded[i])
+            {
+                AssetManager::Get()->UnloadAsset(*stub);
+            }
+        }
+
+        stats.mNumCooked += uint32_t(batch.size());
+    }
+
+    SYS_DestroyMutex(mMutex);
+    mMutex = {};
+
+    mManifest = newManifest;
+    SaveManifest();
+
+    float seconds = (SYS_GetTimeMicroseconds() - startTime) / 1000000.0f;
+    LogDebug("Cook finished in %.2f seconds. %d cooked, %d up to date, %d removed.", seconds, stats.mNumCooked, stats.mNumSkipped, stats.mNumRemoved);
+
+    return stats;
+}
+
+ThreadFuncRet AssetCooker::CookThreadFunc(void* in)
+{
+    AssetCooker& cooker = *((AssetCooker*)in);
+
+    while (true)
+    {
+        CookJob* job = nullptr;
+
+        SYS_LockMutex(cooker.mMutex);
+        if (cooker.mNextBatchJob < cooker.mBatch->size())
+        {
+            job = (*cooker.mBatch)[cooker.mNextBatchJob];
+            cooker.mNextBatchJob++;
+        }
+        SYS_UnlockMutex(cooker.mMutex);
+
+        if (job == nullptr)
+        {
+            break;
+        }
+
+        job->mStub->mAsset->SaveFile(job->mPackFile.c_str(), cooker.mPlatform);
+    }
+
+    THREAD_RETURN();
+}
+
+void AssetCooker::GatherJobs(AssetDir* dir, bool engine)
+{
+    const std::string& projectDir = GetEngineState()->mProjectDirectory;
+    const std::string& projectName = GetEngineState()->mProjectName;
+
+    std::string relDir;
+    if (engine)
+    {
+        relDir = dir->mPath + "/";
+    }
+    else
+    {
+        relDir = dir->mPath;
+        relDir = relDir.substr(projectDir.length());
+        relDir = projectName + "/" + relDir;
+    }
+
+    std::string packDir = mPackagedDir + relDir;
+
+    if (!DoesDirExist(packDir.c_str()))
+    {
+        CreateDir(packDir.c_str());
+    }
+
+    for (uint32_t i = 0; i < dir->mAssetStubs.size(); ++i)
+    {
+        AssetStub* stub = dir->mAssetStubs[i];
+
+        CookJob job;
+        job.mStub = stub;
+        job.mManifestKey = relDir + stub->mName + ".oct";
+        job.mPackFile = mPackagedDir + job.mManifestKey;
+        mJobs.push_back(job);
+    }
+
+    for (uint32_t i = 0; i < dir->mChildDirs.size(); ++i)
+    {
+        GatherJobs(dir->mChildDirs[i], engine);
+    }
+}
+
+void AssetCooker::CookBatch(const std::vector<CookJob*>& batch)
+{
+    uint32_t numThreads = glm::min(std::thread::hardware_concurrency(), uint32_t(batch.size()));
+    numThreads = glm::clamp(numThreads, 1u, uint32_t(COOK_MAX_THREADS));
+
+    mBatch = &batch;
+    mNextBatchJob = 0;
+
+    std::vector<ThreadHandle> threads;
+
+    for (uint32_t i = 0; i < numThreads; ++i)
+    {
+        threads.push_back(SYS_CreateThread(CookThreadFunc, this));
+    }
+
+    for (uint32_t i = 0; i < threads.size(); ++i)
+    {
+        SYS_JoinThread(threads[i]);
+        SYS_DestroyThread(threads[i]);
+    }
+
+    mBatch = nullptr;
+}
+
+uint64_t AssetCooker::HashSource(AssetStub* stub) const
+{
+    // A hash of 0 means the source couldn't be read and the asset always gets cooked.
+    FILE* file = stub->mPath.empty() ? nullptr : fopen(stub->mPath.c_str(), "rb");
+
+    if (file == nullptr)
+    {
+        return 0;
+    }
+
+    // Cook settings: anything that changes the output for the same source bytes.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    uint32_t settings[2] = { uint32_t(mPlatform), ASSET_CURRENT_VERSION };
+    hash = HashBytes(hash, (const uint8_t*)settings, sizeof(settings));
+
+    uint8_t buffer[16384];
+    size_t bytesRead = 0;
+
+    while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        hash = HashBytes(hash, buffer, bytesRead);
+    }
+
+    fclose(file);
+
+    return (hash != 0) ? hash : 1;
+}
+
+void AssetCooker::LoadManifest()
+{
+    mManifest.clear();
+
+    std::string manifestPath = mPackagedDir + COOK_MANIFEST_FILE;
+    FILE* file = fopen(manifestPath.c_str(), "r");
+
+    if (file != nullptr)
+    {
+        char line[1024];
+
+        // Each line is "<hash> <packaged path>"
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            char* path = nullptr;
+            uint64_t hash = strtoull(line, &path, 16);
+
+            if (path != nullptr && *path == ' ')
+            {
+                std::string key = path + 1;
+
+                while (!key.empty() && (key.back() == '\n' || key.back() == '\r'))
+                {
+                    key.pop_back();
+                }
+
+                mManifest[key] = hash;
+            }
+        }
+
+        fclose(file);
+    }
+}
+
+void AssetCooker::SaveManifest()
+{
+    std::string manifestPath = mPackagedDir + COOK_MANIFEST_FILE;
+    FILE* file = fopen(manifestPath.c_str(), "w");
+
+    if (file != nullptr)
+    {
+        for (auto& pair : mManifest)
+        {
+            fprintf(file, "%016llx %s\n", (unsigned long long)pair.second, pair.first.c_str());
+        }
+
+        fclose(file);
+    }
+    else
+    {
+        LogError("Failed to write cook manifest %s", manifestPath.c_str());
+    }
+}
+
+#endif
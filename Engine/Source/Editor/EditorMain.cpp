@@ -13,6 +13,7 @@
 #include "World.h"
 #include "Renderer.h"
 #include "Log.h"
+#include "Utilities.h"
 
 #include "Widgets/Quad.h"
 #include "Widgets/Button.h"
@@ -86,6 +87,40 @@ void EditorMain(int32_t argc, char** argv)
         ActionManager::Get()->OpenProject(gCommandLineOptions.mProjectPath.c_str());
     }
 
+    // Cook only, without running the editor loop. e.g. -project MyGame/MyGame.octp -cook GameCube
+    if (gCommandLineOptions.mCookPlatform != "")
+    {
+        Platform cookPlatform = Platform::Count;
+
+        for (uint32_t i = 0; i < uint32_t(Platform::Count); ++i)
+        {
+            if (gCommandLineOptions.mCookPlatform == GetPlatformString(Platform(i)))
+            {
+                cookPlatform = Platform(i);
+                break;
+            }
+        }
+
+        if (cookPlatform == Platform::Count)
+        {
+            LogError("Unknown cook platform %s", gCommandLineOptions.mCookPlatform.c_str());
+        }
+        else if (GetEngineState()->mProjectDirectory == "")
+        {
+            LogError("Cooking requires a -project");
+        }
+        else
+        {
+            std::vector<std::pair<AssetStub*, std::string> > packFiles;
+            ActionManager::Get()->CookAssets(cookPlatform, packFiles);
+        }
+
+        PanelManager::Destroy();
+        DestroyEditorState();
+        Shutdown();
+        return;
+    }
+
     // Update asset panel to reflect our current project.
     PanelManager::Get()->GetAssetsPanel()->OnProjectDirectorySet();
 
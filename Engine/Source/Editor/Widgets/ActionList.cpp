@@ -9,6 +9,9 @@ static const float kListWidth = 200.0f;
 
 ActionList::ActionList()
 {
+    // The list counts down its visible delay in Update().
+    mAnimated = true;
+
     SetDimensions(kListWidth, 500.0f);
 
     mBg = new Quad();
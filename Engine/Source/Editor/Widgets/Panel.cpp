@@ -29,6 +29,9 @@ Panel::Panel() :
     mMinScroll(0),
     mMaxScroll(10)
 {
+    // Panels refresh their contents from the editor state in Update().
+    mAnimated = true;
+
     mHeaderCanvas = new Canvas();
     mBodyCanvas = new Canvas();
     mHeaderText = new Text();
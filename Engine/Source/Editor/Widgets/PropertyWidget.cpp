@@ -148,6 +148,9 @@ PropertyWidget::PropertyWidget() :
     AddChild(mNameText);
 
     SetDimensions(Panel::sDefaultWidth, GetHeight());
+
+    // Property values are refreshed from their owner in Update().
+    mAnimated = true;
 }
 
 void PropertyWidget::Update()
@@ -9,6 +9,7 @@
 #include "Engine.h"
 #include "ObjectRef.h"
 #include "NetworkManager.h"
+#include "ObjectPool.h"
 #include "Assets/Blueprint.h"
 
 #include "Components/PrimitiveComponent.h"
@@ -94,6 +95,16 @@ Actor::~Actor()
 
 }
 
+void* Actor::operator new(size_t size)
+{
+    return ObjectPool::Alloc(size);
+}
+
+void Actor::operator delete(void* object, size_t size)
+{
+    ObjectPool::Free(object, size);
+}
+
 void Actor::Create()
 {
 #if LUA_ENABLED
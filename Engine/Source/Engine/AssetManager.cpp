@@ -213,9 +213,17 @@ void AssetManager::Discover(const char* directoryName, const char* directoryPath
     // and register an Asset to the map. At this point, we also want to read the oct 
     // header and determine the asset type so we can instantiate the correct Asset derived class.
 
+    // Packaged games may run from a read-only directory, so only the editor keeps an index.
+    std::string indexPath = GetDiscoveryIndexPath(dirPath);
+    std::unordered_map<std::string, AssetIndexEntry> index;
+    std::unordered_map<std::string, AssetIndexEntry> newIndex;
+    uint32_t numHeadersRead = 0;
+#if EDITOR
+    LoadDiscoveryIndex(indexPath, index);
+#endif
+
     std::function<void(AssetDir*, bool)> searchDirectory = [&](AssetDir* directory, bool engineDir)
     {
-
         std::vector<std::string> subDirectories;
         DirEntry dirEntry = { };
 
@@ -239,12 +247,32 @@ void AssetManager::Discover(const char* directoryName, const char* directoryPath
                 if (extension != nullptr &&
                     strcmp(extension, ".oct") == 0)
                 {
-                    Stream stream;
                     std::string path = directory->mPath + dirEntry.mFilename;
-                    stream.ReadFile(path.c_str(), sizeof(AssetHeader));
+                    std::string indexKey = path.substr(dirPath.size());
 
-                    AssetHeader header = Asset::ReadHeader(stream);
-                    RegisterAsset(dirEntry.mFilename, header.mType, directory, nullptr, engineDir);
+                    AssetIndexEntry entry;
+                    SYS_GetFileInfo(path.c_str(), entry.mModifiedTime, entry.mSize);
+
+                    auto it = index.find(indexKey);
+
+                    if (it != index.end() &&
+                        it->second.mModifiedTime == entry.mModifiedTime &&
+                        it->second.mSize == entry.mSize)
+                    {
+                        entry.mType = it->second.mType;
+                    }
+                    else
+                    {
+                        Stream stream;
+                        stream.ReadFile(path.c_str(), sizeof(AssetHeader));
+
+                        AssetHeader header = Asset::ReadHeader(stream);
+                        entry.mType = header.mType;
+                        numHeadersRead++;
+                    }
+
+                    newIndex[indexKey] = entry;
+                    RegisterAsset(dirEntry.mFilename, entry.mType, directory, nullptr, engineDir);
                 }
             }
 
@@ -263,6 +291,108 @@ void AssetManager::Discover(const char* directoryName, const char* directoryPath
     };
 
     searchDirectory(newDir, isEngineDir);
+
+#if EDITOR
+    // Only rewrite the index if something was added, changed or removed.
+    if (numHeadersRead > 0 ||
+        newIndex.size() != index.size())
+    {
+        SaveDiscoveryIndex(indexPath, newIndex);
+    }
+#endif
+
+    LogDebug("Discovered %d assets in %s (%d headers read)", uint32_t(newIndex.size()), directoryName, numHeadersRead);
+}
+
+std::string AssetManager::GetDiscoveryIndexPath(const std::string& dirPath) const
+{
+    // Keep the index next to the Assets folder in Intermediate/ so it doesn't get picked up with the assets.
+    std::string rootPath = dirPath;
+    const std::string assetsFolder = "Assets/";
+
+    if (rootPath.size() >= assetsFolder.size() &&
+        rootPath.compare(rootPath.size() - assetsFolder.size(), assetsFolder.size(), assetsFolder) == 0)
+    {
+        rootPath = rootPath.substr(0, rootPath.size() - assetsFolder.size());
+    }
+
+    return rootPath + "Intermediate/" + ASSET_INDEX_FILE;
+}
+
+void AssetManager::LoadDiscoveryIndex(const std::string& indexPath, std::unordered_map<std::string, AssetIndexEntry>& outIndex)
+{
+    outIndex.clear();
+
+    if (!DoesFileExist(indexPath.c_str()))
+        return;
+
+    Stream stream;
+    stream.ReadFile(indexPath.c_str());
+
+    if (stream.GetSize() < 3 * sizeof(uint32_t) ||
+        stream.ReadUint32() != ASSET_INDEX_MAGIC ||
+        stream.ReadUint32() != ASSET_INDEX_VERSION)
+    {
+        LogWarning("Ignoring out of date asset index %s", indexPath.c_str());
+        return;
+    }
+
+    uint32_t numEntries = stream.ReadUint32();
+
+    for (uint32_t i = 0; i < numEntries; ++i)
+    {
+        std::string path;
+        AssetIndexEntry entry;
+
+        stream.ReadString(path);
+        entry.mModifiedTime = uint64_t(stream.ReadUint32());
+        entry.mModifiedTime |= uint64_t(stream.ReadUint32()) << 32;
+        entry.mSize = uint64_t(stream.ReadUint32());
+        entry.mSize |= uint64_t(stream.ReadUint32()) << 32;
+        entry.mType = (TypeId)stream.ReadUint32();
+
+        outIndex[path] = entry;
+    }
+}
+
+void AssetManager::SaveDiscoveryIndex(const std::string& indexPath, const std::unordered_map<std::string, AssetIndexEntry>& index)
+{
+    std::string indexDir = indexPath.substr(0, indexPath.find_last_of('/'));
+
+    if (!DoesDirExist(indexDir.c_str()))
+    {
+        CreateDir(indexDir.c_str());
+    }
+
+    Stream stream;
+    stream.WriteUint32(ASSET_INDEX_MAGIC);
+    stream.WriteUint32(ASSET_INDEX_VERSION);
+    stream.WriteUint32(uint32_t(index.size()));
+
+    for (auto& pair : index)
+    {
+        const AssetIndexEntry& entry = pair.second;
+        stream.WriteString(pair.first);
+        stream.WriteUint32(uint32_t(entry.mModifiedTime));
+        stream.WriteUint32(uint32_t(entry.mModifiedTime >> 32));
+        stream.WriteUint32(uint32_t(entry.mSize));
+        stream.WriteUint32(uint32_t(entry.mSize >> 32));
+        stream.WriteUint32(uint32_t(entry.mType));
+    }
+
+    // The index is only a cache, failing to write it shouldn't stop discovery.
+    FILE* file = fopen(indexPath.c_str(), "wb");
+
+    if (file != nullptr)
+    {
+        fwrite(stream.GetData(), stream.GetSize(), 1, file);
+        fclose(file);
+        file = nullptr;
+    }
+    else
+    {
+        LogWarning("Failed to write asset index %s", indexPath.c_str());
+    }
 }
 
 void AssetManager::DiscoverAssetRegistry(const char* registryPath)
@@ -4,6 +4,7 @@
 #include "Log.h"
 #include "Engine.h"
 #include "NetworkManager.h"
+#include "ObjectPool.h"
 
 FORCE_LINK_DEF(Blueprint);
 DEFINE_ASSET(Blueprint);
@@ -22,6 +23,8 @@ void Blueprint::LoadStream(Stream& stream, Platform platform)
 {
     Asset::LoadStream(stream, platform);
 
+    InvalidatePlan();
+
     mActorType = (TypeId)stream.ReadUint32();
     mActorProps.resize(stream.ReadUint32());
 
@@ -109,6 +112,8 @@ const char* Blueprint::GetTypeName()
 
 void Blueprint::Create(Actor* srcActor)
 {
+    InvalidatePlan();
+
     mActorType = INVALID_TYPE_ID;
     mActorProps.clear();
     mComponents.clear();
@@ -171,10 +176,26 @@ Actor* Blueprint::Instantiate(World* world)
         retActor = world->SpawnActor(mActorType, false);
         retActor->SetBlueprintSource(this);
 
+        // The first instantiation matches the saved properties against the new actor by name
+        // and records where each one is written. Later instantiations just replay those writes.
         std::vector<Property> dstProps;
-        retActor->GatherProperties(dstProps);
 
-        CopyPropertyValues(dstProps, mActorProps);
+        if (!mPlanCompiled)
+        {
+            retActor->GatherProperties(dstProps);
+            CompileObjectPlan(mActorPlan, retActor, FindFactoryClassSize(Actor::GetFactoryList(), mActorType), dstProps, mActorProps);
+        }
+
+        if (mActorPlan.mGatherProperties)
+        {
+            dstProps.clear();
+            retActor->GatherProperties(dstProps);
+            CopyPropertyValues(dstProps, mActorProps);
+        }
+        else
+        {
+            ApplyObjectPlan(mActorPlan, retActor, mActorProps);
+        }
 
         // Now we need to add components to the new actor. It is assumed that the native components
         // created by an actor's class are the first components in the Actor::mComponent array.
@@ -189,14 +210,34 @@ Actor* Blueprint::Instantiate(World* world)
         const std::vector<Component*>& dstComps = retActor->GetComponents();
         assert(mComponents.size() == dstComps.size());
 
-        uint32_t i = 0;
-        for (i = 0; i < dstComps.size(); ++i)
+        if (!mPlanCompiled)
+        {
+            mComponentPlans.resize(dstComps.size());
+
+            for (uint32_t i = 0; i < dstComps.size(); ++i)
+            {
+                dstProps.clear();
+                dstComps[i]->GatherProperties(dstProps);
+                CompileObjectPlan(mComponentPlans[i], dstComps[i], FindFactoryClassSize(Component::GetFactoryList(), mComponents[i].mType), dstProps, mComponents[i].mProperties);
+            }
+
+            mPlanCompiled = true;
+        }
+
+        for (uint32_t i = 0; i < dstComps.size(); ++i)
         {
             assert(mComponents[i].mType == dstComps[i]->GetType());
-            std::vector<Property> dstProps;
-            dstComps[i]->GatherProperties(dstProps);
 
-            CopyPropertyValues(dstProps, mComponents[i].mProperties);
+            if (mComponentPlans[i].mGatherProperties)
+            {
+                dstProps.clear();
+                dstComps[i]->GatherProperties(dstProps);
+                CopyPropertyValues(dstProps, mComponents[i].mProperties);
+            }
+            else
+            {
+                ApplyObjectPlan(mComponentPlans[i], dstComps[i], mComponents[i].mProperties);
+            }
         }
 
         // Setup transform hierarchy.
@@ -233,6 +274,124 @@ Actor* Blueprint::Instantiate(World* world)
     return retActor;
 }
 
+void Blueprint::CompileObjectPlan(
+    BlueprintObjectPlan& plan,
+    void* object,
+    uint32_t objectSize,
+    const std::vector<Property>& dstProps,
+    const std::vector<Property>& srcProps)
+{
+    plan.mWrites.clear();
+    plan.mGatherProperties = (objectSize == 0);
+
+    const uint8_t* objectBegin = reinterpret_cast<const uint8_t*>(object);
+    const uint8_t* objectEnd = objectBegin + objectSize;
+
+    // Same matching rules as CopyPropertyValues(), but it only runs once per blueprint.
+    for (uint32_t i = 0; i < srcProps.size() && !plan.mGatherProperties; ++i)
+    {
+        const Property& srcProp = srcProps[i];
+        const Property* dstProp = nullptr;
+
+        for (uint32_t j = 0; j < dstProps.size(); ++j)
+        {
+            if (dstProps[j].mName == srcProp.mName &&
+                dstProps[j].mType == srcProp.mType)
+            {
+                dstProp = &dstProps[j];
+                break;
+            }
+        }
+
+        if (dstProp == nullptr)
+            continue;
+
+        const uint8_t* owner = reinterpret_cast<const uint8_t*>(dstProp->mOwner);
+        const uint8_t* dataBegin = reinterpret_cast<const uint8_t*>(dstProp->mData.vp);
+        const uint8_t* dataEnd = dataBegin + dstProp->GetDataTypeSize() * dstProp->GetCount();
+
+        // Only data stored inside the object itself sits at the same offset in every instance.
+        if (!dstProp->IsExternal() ||
+            dstProp->IsVector() ||
+            owner < objectBegin || owner >= objectEnd ||
+            dataBegin < objectBegin || dataEnd > objectEnd ||
+            dstProp->GetCount() != srcProp.GetCount())
+        {
+            plan.mGatherProperties = true;
+            break;
+        }
+
+        // Copy constructed, since Property::operator=() doesn't copy the name that change handlers check.
+        plan.mWrites.push_back({ i, uint32_t(owner - objectBegin), uint32_t(dataBegin - objectBegin), *dstProp });
+    }
+
+    if (plan.mGatherProperties)
+    {
+        plan.mWrites.clear();
+    }
+}
+
+void Blueprint::ApplyObjectPlan(BlueprintObjectPlan& plan, void* object, const std::vector<Property>& srcProps)
+{
+    uint8_t* base = reinterpret_cast<uint8_t*>(object);
+
+    for (uint32_t i = 0; i < plan.mWrites.size(); ++i)
+    {
+        BlueprintPropWrite& write = plan.mWrites[i];
+        const Property& srcProp = srcProps[write.mSrcIndex];
+
+        // Point the cached property at the new object. SetValue() still goes through
+        // the change handler when there is one, so setters behave the same as before.
+        Property& dstProp = write.mDstProp;
+        dstProp.mOwner = base + write.mOwnerOffset;
+        dstProp.mData.vp = base + write.mDataOffset;
+        dstProp.SetValue(srcProp.mData.vp, 0, srcProp.mCount);
+    }
+}
+
+void Blueprint::InvalidatePlan()
+{
+    mActorPlan.mWrites.clear();
+    mActorPlan.mGatherProperties = false;
+    mComponentPlans.clear();
+    mPlanCompiled = false;
+}
+
+void Blueprint::PrewarmPools(uint32_t count)
+{
+    // Objects of the same size class share a pool, so count the blocks each size needs.
+    std::vector<std::pair<uint32_t, uint32_t> > sizeCounts;
+
+    auto addSize = [&](uint32_t size)
+    {
+        if (size == 0)
+            return;
+
+        for (uint32_t i = 0; i < sizeCounts.size(); ++i)
+        {
+            if (sizeCounts[i].first == size)
+            {
+                sizeCounts[i].second += count;
+                return;
+            }
+        }
+
+        sizeCounts.push_back({ size, count });
+    };
+
+    addSize(FindFactoryClassSize(Actor::GetFactoryList(), mActorType));
+
+    for (uint32_t i = 0; i < mComponents.size(); ++i)
+    {
+        addSize(FindFactoryClassSize(Component::GetFactoryList(), mComponents[i].mType));
+    }
+
+    for (uint32_t i = 0; i < sizeCounts.size(); ++i)
+    {
+        ObjectPool::Prewarm(sizeCounts[i].first, sizeCounts[i].second);
+    }
+}
+
 const Property* Blueprint::GetActorProperty(const char* name)
 {
     const Property* ret = nullptr;
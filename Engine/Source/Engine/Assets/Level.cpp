@@ -7,6 +7,8 @@
 #include "NetworkManager.h"
 #include "Assets/Blueprint.h"
 
+#include "System/System.h"
+
 #include <glm/gtx/euler_angles.hpp>
 #include <algorithm>
 
@@ -30,9 +32,21 @@ void Level::LoadStream(Stream& stream, Platform platform)
 
     mNetLoad = stream.ReadBool();
 
+    if (mVersion >= ASSET_VERSION_LEVEL_RECORD_SIZE)
+    {
+        mRecordSizes = stream.ReadBool();
+    }
+
+    if (mVersion >= ASSET_VERSION_LEVEL_REPLICATED_FLAG)
+    {
+        mReplicatedFlags = stream.ReadBool();
+    }
+
     uint32_t dataSize = stream.ReadUint32();
     mData.resize(dataSize);
     stream.ReadBytes(mData.data(), dataSize);
+
+    StageActorRecords(stream.GetAsyncRequest());
 }
 
 // Save entire world as a level.
@@ -42,6 +56,8 @@ void Level::SaveStream(Stream& stream, Platform platform)
 
 #if EDITOR
     stream.WriteBool(mNetLoad);
+    stream.WriteBool(mRecordSizes);
+    stream.WriteBool(mReplicatedFlags);
     stream.WriteUint32((uint32_t)mData.size());
     stream.WriteBytes(mData.data(), (uint32_t)mData.size());
 #endif
@@ -101,6 +117,7 @@ void Level::CaptureWorld(World* world)
         {
             bool bp = (actors[i]->GetBlueprintSource() != nullptr);
             captureStream.WriteBool(bp);
+            captureStream.WriteBool(actors[i]->IsReplicated());
 
             if (bp)
             {
@@ -120,70 +137,126 @@ void Level::CaptureWorld(World* world)
             else
             {
                 captureStream.WriteUint32(actors[i]->GetType());
+
+                // Write the record size first so the actor data can be skipped over while staging.
+                uint32_t sizePos = captureStream.GetPos();
+                captureStream.WriteUint32(0);
                 actors[i]->SaveStream(captureStream);
+
+                uint32_t endPos = captureStream.GetPos();
+                captureStream.SetPos(sizePos);
+                captureStream.WriteUint32(endPos - sizePos - sizeof(uint32_t));
+                captureStream.SetPos(endPos);
             }
         }
     }
 
     mData.resize(captureStream.GetSize());
     memcpy(mData.data(), captureStream.GetData(), captureStream.GetSize());
+    mRecordSizes = true;
+    mReplicatedFlags = true;
+
+    StageActorRecords(nullptr);
 #endif
 }
 
 void Level::LoadIntoWorld(World* world, glm::vec3 offset, glm::vec3 rotation)
 {
-    Stream stream((const char*)mData.data(), (uint32_t)mData.size());
+    LevelStreamState state;
+    BeginStreamIntoWorld(state, offset, rotation);
+    StreamIntoWorld(world, state, 0.0f);
+}
 
-    uint32_t numActors;
-    numActors = stream.ReadUint32();
-    LogDebug("Loading Level... %d Actors", numActors);
+void Level::UnloadFromWorld(World* world)
+{
+    // Erase this level from the loaded level list.
+    std::vector<LevelRef>& loadedLevels = world->GetLoadedLevels();
+    for (uint32_t i = 0; i < loadedLevels.size(); ++i)
+    {
+        if (loadedLevels[i] == this)
+        {
+            loadedLevels.erase(loadedLevels.begin() + i);
+        }
+    }
 
-    glm::vec3 rotRadians = rotation * DEGREES_TO_RADIANS;
-    glm::mat4 transform = glm::mat4(1);
-    transform = glm::translate(transform, offset);
-    transform *= glm::eulerAngleYXZ(rotRadians.y, rotRadians.x, rotRadians.z);
+    // World can be null when shutting down.
+    if (world != nullptr)
+    {
+        const std::vector<Actor*>& actors = world->GetActors();
+        for (int32_t i = int32_t(actors.size() - 1); i >= 0; --i)
+        {
+            if (actors[i]->GetLevel() == this)
+            {
+                world->DestroyActor(i);
+            }
+        }
+    }
+}
 
-    for (uint32_t i = 0; i < numActors; ++i)
+void Level::BeginStreamIntoWorld(LevelStreamState& state, glm::vec3 offset, glm::vec3 rotation)
+{
+    glm::vec3 rotRadians = rotation * DEGREES_TO_RADIANS;
+    state.mTransform = glm::mat4(1);
+    state.mTransform = glm::translate(state.mTransform, offset);
+    state.mTransform *= glm::eulerAngleYXZ(rotRadians.y, rotRadians.x, rotRadians.z);
+    state.mRotation = rotation;
+    state.mNextActor = 0;
+    state.mNumActors = 0;
+    state.mStreamPos = 0;
+
+    if (mRecordSizes)
+    {
+        state.mNumActors = (uint32_t)mActorRecords.size();
+    }
+    else if (mData.size() >= sizeof(uint32_t))
     {
-        bool bp = stream.ReadBool();
+        Stream stream((const char*)mData.data(), (uint32_t)mData.size());
+        state.mNumActors = stream.ReadUint32();
+        state.mStreamPos = stream.GetPos();
+    }
+
+    LogDebug("Loading Level... %d Actors", state.mNumActors);
+}
+
+bool Level::StreamIntoWorld(World* world, LevelStreamState& state, float budgetMs)
+{
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+    uint64_t budgetUs = uint64_t(budgetMs * 1000.0f);
+
+    Stream stream((const char*)mData.data(), (uint32_t)mData.size());
+    stream.SetPos(state.mStreamPos);
 
+    while (state.mNextActor < state.mNumActors)
+    {
         Actor* newActor = nullptr;
 
-        if (bp)
+        if (mRecordSizes)
         {
-            AssetRef bpRef;
-            stream.ReadAsset(bpRef);
-            Blueprint* bp = bpRef.Get<Blueprint>();
-            uint32_t numOverrides = stream.ReadUint32();
-
-            std::vector<PropertyOverride> overs;
-            overs.resize(numOverrides);
+            const LevelActorRecord& record = mActorRecords[state.mNextActor];
 
-            for (uint32_t o = 0; o < numOverrides; ++o)
+            if (record.mReplicated &&
+                !NetIsAuthority())
             {
-                overs[o].mIndex = stream.ReadInt32();
-                overs[o].mProperty.ReadStream(stream, false);
+                // The server will send down a spawn message for this actor.
+                state.mNextActor++;
+                continue;
             }
 
-            if (bp != nullptr)
-            {
-                newActor = bp->Instantiate(GetWorld());
-                newActor->ApplyPropertyOverrides(overs);
-            }
+            newActor = InstantiateRecord(world, record);
         }
         else
         {
-            TypeId actorType = (TypeId)stream.ReadUint32();
-            newActor = GetWorld()->SpawnActor(actorType, false);
-            newActor->LoadStream(stream);
+            newActor = InstantiateFromStream(world, stream);
         }
 
+        state.mNextActor++;
+
         if (newActor != nullptr)
         {
             newActor->SetLevel(this);
 
-            glm::vec3 transformedPos = transform * glm::vec4(newActor->GetPosition(), 1.0f);
-            glm::vec3 transformedRot = rotation + newActor->GetRotationEuler();
+            glm::vec3 transformedPos = state.mTransform * glm::vec4(newActor->GetPosition(), 1.0f);
+            glm::vec3 transformedRot = state.mRotation + newActor->GetRotationEuler();
             newActor->SetPosition(transformedPos);
             newActor->SetRotation(transformedRot);
 
@@ -195,48 +268,37 @@ void Level::LoadIntoWorld(World* world, glm::vec3 offset, glm::vec3 rotation)
             }
             else if (newActor->IsReplicated())
             {
-                // There should be a better way to do this, but the client should not 
-                // instantiate network actors. Let the server send down the SpawnActor messages.
-                GetWorld()->DestroyActor(newActor);
+                // Levels saved without replicated flags can't skip these ahead of time.
+                // The client should not keep network actors. Let the server send down the SpawnActor messages.
+                world->DestroyActor(newActor);
             }
         }
         else
         {
             LogWarning("Failed to instantiate in Level::LoadIntoWorld()");
         }
-    }
 
-    std::vector<LevelRef>& loadedLevels = world->GetLoadedLevels();
-    if (std::find(loadedLevels.begin(), loadedLevels.end(), this) == loadedLevels.end())
-    {
-        loadedLevels.push_back(this);
-    }
-}
-
-void Level::UnloadFromWorld(World* world)
-{
-    // Erase this level from the loaded level list.
-    std::vector<LevelRef>& loadedLevels = world->GetLoadedLevels();
-    for (uint32_t i = 0; i < loadedLevels.size(); ++i)
-    {
-        if (loadedLevels[i] == this)
+        if (budgetMs > 0.0f &&
+            SYS_GetTimeMicroseconds() - startTime >= budgetUs)
         {
-            loadedLevels.erase(loadedLevels.begin() + i);
+            break;
         }
     }
 
-    // World can be null when shutting down.
-    if (world != nullptr)
+    state.mStreamPos = stream.GetPos();
+
+    bool finished = (state.mNextActor >= state.mNumActors);
+
+    if (finished)
     {
-        const std::vector<Actor*>& actors = world->GetActors();
-        for (int32_t i = int32_t(actors.size() - 1); i >= 0; --i)
+        std::vector<LevelRef>& loadedLevels = world->GetLoadedLevels();
+        if (std::find(loadedLevels.begin(), loadedLevels.end(), this) == loadedLevels.end())
         {
-            if (actors[i]->GetLevel() == this)
-            {
-                world->DestroyActor(i);
-            }
+            loadedLevels.push_back(this);
         }
     }
+
+    return finished;
 }
 
 bool Level::GetNetLoad() const
@@ -251,4 +313,112 @@ bool Level::ShouldSaveActor(Actor* actor) const
         return false;
 
     return true;
+}
+
+void Level::StageActorRecords(AsyncLoadRequest* request)
+{
+    mActorRecords.clear();
+
+    if (!mRecordSizes ||
+        mData.size() < sizeof(uint32_t))
+    {
+        return;
+    }
+
+    Stream stream((const char*)mData.data(), (uint32_t)mData.size());
+
+    // Blueprint dependencies get async loaded along with the level when possible.
+    stream.SetAsyncRequest(request);
+
+    // Size the vector up front. A pending async load keeps a pointer to each record's blueprint ref.
+    uint32_t numActors = stream.ReadUint32();
+    mActorRecords.resize(numActors);
+
+    for (uint32_t i = 0; i < numActors; ++i)
+    {
+        LevelActorRecord& record = mActorRecords[i];
+        record.mIsBlueprint = stream.ReadBool();
+        record.mReplicated = mReplicatedFlags ? stream.ReadBool() : false;
+
+        if (record.mIsBlueprint)
+        {
+            stream.ReadAsset(record.mBlueprint);
+            uint32_t numOverrides = stream.ReadUint32();
+            record.mOverrides.resize(numOverrides);
+
+            for (uint32_t o = 0; o < numOverrides; ++o)
+            {
+                record.mOverrides[o].mIndex = stream.ReadInt32();
+                record.mOverrides[o].mProperty.ReadStream(stream, false);
+            }
+        }
+        else
+        {
+            record.mActorType = (TypeId)stream.ReadUint32();
+            record.mDataSize = stream.ReadUint32();
+            record.mDataOffset = stream.GetPos();
+            stream.SetPos(record.mDataOffset + record.mDataSize);
+        }
+    }
+}
+
+Actor* Level::InstantiateRecord(World* world, const LevelActorRecord& record)
+{
+    Actor* newActor = nullptr;
+
+    if (record.mIsBlueprint)
+    {
+        Blueprint* bp = record.mBlueprint.Get<Blueprint>();
+
+        if (bp != nullptr)
+        {
+            newActor = bp->Instantiate(world);
+            newActor->ApplyPropertyOverrides(record.mOverrides);
+        }
+    }
+    else
+    {
+        Stream actorStream((const char*)mData.data() + record.mDataOffset, record.mDataSize);
+        newActor = world->SpawnActor(record.mActorType, false);
+        newActor->LoadStream(actorStream);
+    }
+
+    return newActor;
+}
+
+Actor* Level::InstantiateFromStream(World* world, Stream& stream)
+{
+    Actor* newActor = nullptr;
+    bool bp = stream.ReadBool();
+
+    if (bp)
+    {
+        AssetRef bpRef;
+        stream.ReadAsset(bpRef);
+        Blueprint* bp = bpRef.Get<Blueprint>();
+        uint32_t numOverrides = stream.ReadUint32();
+
+        std::vector<PropertyOverride> overs;
+        overs.resize(numOverrides);
+
+        for (uint32_t o = 0; o < numOverrides; ++o)
+        {
+            overs[o].mIndex = stream.ReadInt32();
+            overs[o].mProperty.ReadStream(stream, false);
+        }
+
+        if (bp != nullptr)
+        {
+            newActor = bp->Instantiate(world);
+            newActor->ApplyPropertyOverrides(overs);
+        }
+    }
+    else
+    {
+        TypeId actorType = (TypeId)stream.ReadUint32();
+        newActor = world->SpawnActor(actorType, false);
+        newActor->LoadStream(stream);
+    }
+
+    return newActor;
 }
\ No newline at end of file
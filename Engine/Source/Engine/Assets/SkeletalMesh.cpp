@@ -1,5 +1,6 @@
 #include "Assets/SkeletalMesh.h"
 #include "Renderer.h"
+#include "MeshOptimizer.h"
 #include "Vertex.h"
 #include "AssetManager.h"
 #include "Log.h"
@@ -915,6 +916,19 @@ void SkeletalMesh::SetupResource(const aiMesh& meshData,
         mIndices[i * 3 + 2] = faces[i].mIndices[2];
     }
 
+    MeshOptimizeStats optStats;
+    mNumVertices = MeshOpt_OptimizeMesh(
+        reinterpret_cast<uint8_t*>(mVertices.data()),
+        sizeof(VertexSkinned),
+        offsetof(VertexSkinned, mPosition),
+        mNumVertices,
+        mIndices.data(),
+        mNumIndices,
+        &optStats);
+    mVertices.resize(mNumVertices);
+
+    LogDebug("Optimized mesh %s: ACMR %.3f -> %.3f", GetName().c_str(), optStats.mAcmrBefore, optStats.mAcmrAfter);
+
     Create();
 }
 #endif // EDITOR
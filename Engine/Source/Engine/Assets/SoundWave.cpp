@@ -6,11 +6,36 @@
 #include "AudioManager.h"
 
 #include "Audio/Audio.h"
+#include "Audio/AudioConstants.h"
+#include "Audio/ImaAdpcm.h"
 #include "System/System.h"
 
 FORCE_LINK_DEF(SoundWave);
 DEFINE_ASSET(SoundWave);
 
+static void DecodeImaAdpcmToPcm(const uint8_t* srcData, uint32_t numFrames, uint32_t numChannels, uint8_t* dstData)
+{
+    uint32_t numBlocks = AUD_GetImaAdpcmNumBlocks(numFrames);
+    uint32_t blockSize = AUD_GetImaAdpcmBlockSize(numChannels);
+    std::vector<int16_t> blockSamples(IMA_ADPCM_FRAMES_PER_BLOCK * numChannels);
+
+    for (uint32_t b = 0; b < numBlocks; ++b)
+    {
+        AUD_DecodeImaAdpcmBlock(srcData + b * blockSize, numChannels, blockSamples.data());
+
+        uint32_t firstSample = b * IMA_ADPCM_FRAMES_PER_BLOCK * numChannels;
+        uint32_t blockFrames = glm::min(numFrames - b * IMA_ADPCM_FRAMES_PER_BLOCK, uint32_t(IMA_ADPCM_FRAMES_PER_BLOCK));
+
+        // Write little endian samples to match the layout of imported wav data.
+        for (uint32_t i = 0; i < blockFrames * numChannels; ++i)
+        {
+            uint16_t sample = uint16_t(blockSamples[i]);
+            dstData[(firstSample + i) * 2 + 0] = uint8_t(sample & 0xff);
+            dstData[(firstSample + i) * 2 + 1] = uint8_t(sample >> 8);
+        }
+    }
+}
+
 SoundWave::SoundWave()
 {
     mType = SoundWave::GetStaticType();
@@ -29,6 +54,12 @@ void SoundWave::LoadStream(Stream& stream, Platform platform)
     mVolumeMultiplier = stream.ReadFloat();
     mPitchMultiplier = stream.ReadFloat();
 
+    if (mVersion >= ASSET_VERSION_SOUNDWAVE_COMPRESSION)
+    {
+        mCompress = stream.ReadBool();
+        mStream = stream.ReadBool();
+    }
+
     // Waveform Format
     mNumChannels = stream.ReadUint32();
     mBitsPerSample = stream.ReadUint32();
@@ -38,11 +69,32 @@ void SoundWave::LoadStream(Stream& stream, Platform platform)
     mByteRate = stream.ReadUint32();
 
     // Waveform
+    SoundWaveFormat dataFormat = SoundWaveFormat::Pcm;
+    if (mVersion >= ASSET_VERSION_SOUNDWAVE_COMPRESSION)
+    {
+        dataFormat = (SoundWaveFormat)stream.ReadUint8();
+    }
+
     mWaveDataSize = stream.ReadUint32();
-    mWaveData = AUD_AllocWaveBuffer(mWaveDataSize);
-    for (uint32_t i = 0; i < mWaveDataSize; ++i)
+
+    if (dataFormat == SoundWaveFormat::ImaAdpcm &&
+        !(mStream && AUDIO_STREAMING_SUPPORTED))
+    {
+        // This platform can't play compressed data directly, so decode it all up front.
+        std::vector<uint8_t> compressedData(mWaveDataSize);
+        stream.ReadBytes(compressedData.data(), mWaveDataSize);
+
+        mWaveDataSize = mNumSamples * sizeof(int16_t);
+        mWaveData = AUD_AllocWaveBuffer(mWaveDataSize);
+        DecodeImaAdpcmToPcm(compressedData.data(), GetNumFrames(), mNumChannels, mWaveData);
+        mWaveFormat = SoundWaveFormat::Pcm;
+    }
+    else
     {
-        mWaveData[i] = stream.ReadUint8();
+        // PCM data, or IMA-ADPCM blocks that will be decoded as they are mixed.
+        mWaveData = AUD_AllocWaveBuffer(mWaveDataSize);
+        stream.ReadBytes(mWaveData, mWaveDataSize);
+        mWaveFormat = dataFormat;
     }
 
     AUD_ProcessWaveBuffer(this);
@@ -55,20 +107,65 @@ void SoundWave::SaveStream(Stream& stream, Platform platform)
     // Properties
     stream.WriteFloat(mVolumeMultiplier);
     stream.WriteFloat(mPitchMultiplier);
+    stream.WriteBool(mCompress);
+    stream.WriteBool(mStream);
 
-    // Waveform Format
-    stream.WriteUint32(mNumChannels);
-    stream.WriteUint32(mBitsPerSample);
-    stream.WriteUint32(mSampleRate);
-    stream.WriteUint32(mNumSamples);
-    stream.WriteUint32(mBlockAlign);
-    stream.WriteUint32(mByteRate);
+    // Compression only happens when cooking for a platform. Editor saves (Platform::Count) keep
+    // the source PCM so re-saving doesn't accumulate ADPCM error.
+    bool compress = (mCompress &&
+        platform != Platform::Count &&
+        mWaveFormat == SoundWaveFormat::Pcm &&
+        mNumChannels >= 1 && mNumChannels <= 2);
 
-    // Waveform
-    stream.WriteUint32(mWaveDataSize);
-    for (uint32_t i = 0; i < mWaveDataSize; ++i)
+    if (compress)
     {
-        stream.WriteUint8(mWaveData[i]);
+        uint32_t numFrames = GetNumFrames();
+        std::vector<int16_t> pcm16(numFrames * mNumChannels);
+
+        for (uint32_t i = 0; i < pcm16.size(); ++i)
+        {
+            if (mBitsPerSample == 8)
+            {
+                pcm16[i] = int16_t((int32_t(mWaveData[i]) - 128) * 256);
+            }
+            else
+            {
+                pcm16[i] = int16_t(uint16_t(mWaveData[i * 2]) | (uint16_t(mWaveData[i * 2 + 1]) << 8));
+            }
+        }
+
+        std::vector<uint8_t> compressedData;
+        AUD_EncodeImaAdpcm(pcm16.data(), numFrames, mNumChannels, compressedData);
+
+        // Compressed data always decodes to 16 bit samples.
+        uint32_t blockAlign = mNumChannels * sizeof(int16_t);
+        stream.WriteUint32(mNumChannels);
+        stream.WriteUint32(16);
+        stream.WriteUint32(mSampleRate);
+        stream.WriteUint32(numFrames * mNumChannels);
+        stream.WriteUint32(blockAlign);
+        stream.WriteUint32(mSampleRate * blockAlign);
+
+        stream.WriteUint8(uint8_t(SoundWaveFormat::ImaAdpcm));
+        stream.WriteUint32((uint32_t)compressedData.size());
+        stream.WriteBytes(compressedData.data(), (uint32_t)compressedData.size());
+
+        LogDebug("Compressed SoundWave %s: %u -> %u bytes", mName.c_str(), mWaveDataSize, (uint32_t)compressedData.size());
+    }
+    else
+    {
+        // Waveform Format
+        stream.WriteUint32(mNumChannels);
+        stream.WriteUint32(mBitsPerSample);
+        stream.WriteUint32(mSampleRate);
+        stream.WriteUint32(mNumSamples);
+        stream.WriteUint32(mBlockAlign);
+        stream.WriteUint32(mByteRate);
+
+        // Waveform
+        stream.WriteUint8(uint8_t(mWaveFormat));
+        stream.WriteUint32(mWaveDataSize);
+        stream.WriteBytes(mWaveData, mWaveDataSize);
     }
 }
 
@@ -152,6 +249,8 @@ void SoundWave::GatherProperties(std::vector<Property>& outProps)
 
     outProps.push_back(Property(DatumType::Float, "Volume Multiplier", this, &mVolumeMultiplier));
     outProps.push_back(Property(DatumType::Float, "Pitch Multiplier", this, &mPitchMultiplier));
+    outProps.push_back(Property(DatumType::Bool, "Compress", this, &mCompress));
+    outProps.push_back(Property(DatumType::Bool, "Stream", this, &mStream));
 }
 
 glm::vec4 SoundWave::GetTypeColor()
@@ -189,6 +288,31 @@ float SoundWave::GetVolumeMultiplier() const
     return mVolumeMultiplier;
 }
 
+void SoundWave::SetCompress(bool compress)
+{
+    mCompress = compress;
+}
+
+bool SoundWave::GetCompress() const
+{
+    return mCompress;
+}
+
+void SoundWave::SetStream(bool stream)
+{
+    mStream = stream;
+}
+
+bool SoundWave::GetStream() const
+{
+    return mStream;
+}
+
+SoundWaveFormat SoundWave::GetWaveFormat() const
+{
+    return mWaveFormat;
+}
+
 uint8_t* SoundWave::GetWaveData() const
 {
     return mWaveData;
@@ -219,9 +343,15 @@ uint32_t SoundWave::GetNumSamples() const
     return mNumSamples;
 }
 
+uint32_t SoundWave::GetNumFrames() const
+{
+    return (mNumChannels > 0) ? (mNumSamples / mNumChannels) : 0;
+}
+
 float SoundWave::GetDuration() const
 {
-    return float(mNumSamples) / mSampleRate;
+    // mNumSamples counts every channel, a stereo wave plays one frame per sample period.
+    return (mSampleRate > 0) ? (float(GetNumFrames()) / mSampleRate) : 0.0f;
 }
 
 uint32_t SoundWave::GetBlockAlign() const
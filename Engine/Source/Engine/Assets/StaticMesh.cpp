@@ -1,5 +1,6 @@
 #include "Assets/StaticMesh.h"
 #include "Renderer.h"
+#include "MeshOptimizer.h"
 #include "Vertex.h"
 #include "AssetManager.h"
 #include "Utilities.h"
@@ -21,6 +22,38 @@ using namespace std;
 FORCE_LINK_DEF(StaticMesh);
 DEFINE_ASSET(StaticMesh);
 
+static const float sDefaultLodScreenSizes[MAX_MESH_LODS] = { 1.0f, 0.5f, 0.2f, 0.08f };
+
+static bool HandlePropChange(Datum* datum, const void* newValue)
+{
+    Property* prop = static_cast<Property*>(datum);
+
+    assert(prop != nullptr);
+    StaticMesh* mesh = static_cast<StaticMesh*>(prop->mOwner);
+    bool success = false;
+
+    if (prop->mName == "Max LODs" ||
+        prop->mName == "LOD Reduction")
+    {
+        // Let the datum assign the new value first, then rebuild the LOD chain from LOD 0.
+        datum->SetValueRaw(newValue);
+        mesh->GenerateLods();
+
+        GFX_DestroyStaticMeshResource(mesh);
+        GFX_CreateStaticMeshResource(
+            mesh,
+            mesh->HasVertexColor(),
+            mesh->GetNumVertices(),
+            mesh->HasVertexColor() ? (void*)mesh->GetColorVertices() : (void*)mesh->GetVertices(),
+            mesh->GetNumIndices(),
+            mesh->GetIndices());
+
+        success = true;
+    }
+
+    return success;
+}
+
 StaticMesh::StaticMesh() :
     mMaterial(nullptr),
     mNumVertices(0),
@@ -28,6 +61,9 @@ StaticMesh::StaticMesh() :
     mNumUvMaps(1),
     mVertices(nullptr),
     mIndices(nullptr),
+    mNumLods(1),
+    mMaxLods(MAX_MESH_LODS),
+    mLodReduction(DEFAULT_LOD_REDUCTION),
     mCollisionShape(nullptr),
     mTriangleCollisionShape(nullptr),
     mTriangleIndexVertexArray(nullptr),
@@ -36,6 +72,11 @@ StaticMesh::StaticMesh() :
     mHasVertexColor(false)
 {
     mType = StaticMesh::GetStaticType();
+
+    for (uint32_t i = 0; i < MAX_MESH_LODS; ++i)
+    {
+        mLods[i].mScreenSize = sDefaultLodScreenSizes[i];
+    }
 }
 
 StaticMesh::~StaticMesh()
@@ -58,6 +99,9 @@ void StaticMesh::CreateRaw(
     memcpy(mVertices, vertices, numVertices * GetVertexSize());
     memcpy(mIndices, indices, numIndices * sizeof(IndexType));
 
+    mLodIndices.clear();
+    mNumLods = 1;
+
     Create();
 }
 
@@ -126,6 +170,44 @@ void StaticMesh::LoadStream(Stream& stream, Platform platform)
         mIndices[i] = (IndexType) stream.ReadUint32();
     }
 
+    mLodIndices.clear();
+    mNumLods = 1;
+
+    if (mVersion >= ASSET_VERSION_STATIC_MESH_LODS)
+    {
+        mMaxLods = stream.ReadInt32();
+        mLodReduction = stream.ReadFloat();
+
+        for (uint32_t i = 0; i < MAX_MESH_LODS; ++i)
+        {
+            mLods[i].mScreenSize = stream.ReadFloat();
+        }
+
+        mNumLods = stream.ReadUint32();
+        assert(mNumLods >= 1 && mNumLods <= MAX_MESH_LODS);
+
+        uint32_t firstIndex = mNumIndices;
+        for (uint32_t i = 1; i < mNumLods; ++i)
+        {
+            mLods[i].mFirstIndex = firstIndex;
+            mLods[i].mNumIndices = stream.ReadUint32();
+            firstIndex += mLods[i].mNumIndices;
+        }
+
+        mLodIndices.resize(firstIndex - mNumIndices);
+        for (uint32_t i = 0; i < mLodIndices.size(); ++i)
+        {
+            mLodIndices[i] = (IndexType) stream.ReadUint32();
+        }
+    }
+#if EDITOR
+    else
+    {
+        // Older meshes get their LODs the first time they are loaded (and saved/cooked) by the editor.
+        GenerateLods();
+    }
+#endif
+
     // Collision shapes
     bool compound = stream.ReadBool();
     uint32_t numCollisionShapes = stream.ReadUint32();
@@ -242,6 +324,25 @@ void StaticMesh::SaveStream(Stream& stream, Platform platform)
         stream.WriteUint32(mIndices[i]);
     }
 
+    stream.WriteInt32(mMaxLods);
+    stream.WriteFloat(mLodReduction);
+
+    for (uint32_t i = 0; i < MAX_MESH_LODS; ++i)
+    {
+        stream.WriteFloat(mLods[i].mScreenSize);
+    }
+
+    stream.WriteUint32(mNumLods);
+    for (uint32_t i = 1; i < mNumLods; ++i)
+    {
+        stream.WriteUint32(mLods[i].mNumIndices);
+    }
+
+    for (uint32_t i = 0; i < mLodIndices.size(); ++i)
+    {
+        stream.WriteUint32(mLodIndices[i]);
+    }
+
     // Collision shapes
     uint32_t numCollisionShapes = 0;
     btCollisionShape* collisionShapes[MAX_COLLISION_SHAPES] = {};
@@ -342,6 +443,10 @@ void StaticMesh::Create()
     Asset::Create();
 
     assert(mNumVertices <= MAX_MESH_VERTEX_COUNT); // Vertex index must fit into IndexType width.
+
+    mLods[0].mFirstIndex = 0;
+    mLods[0].mNumIndices = mNumIndices;
+
     GFX_CreateStaticMeshResource(
         this,
         mHasVertexColor,
@@ -396,6 +501,8 @@ void StaticMesh::Destroy()
 
     ResizeVertexArray(0);
     ResizeIndexArray(0);
+    mLodIndices.clear();
+    mNumLods = 1;
 
     mMaterial = nullptr;
 }
@@ -470,6 +577,11 @@ void StaticMesh::GatherProperties(std::vector<Property>& outProps)
     Asset::GatherProperties(outProps);
     outProps.push_back(Property(DatumType::Asset, "Material", this, &mMaterial, 1, nullptr, int32_t(Material::GetStaticType())));
     outProps.push_back(Property(DatumType::Bool, "Generate Triangle Collision Mesh", this, &mGenerateTriangleCollisionMesh));
+    outProps.push_back(Property(DatumType::Integer, "Max LODs", this, &mMaxLods, 1, HandlePropChange));
+    outProps.push_back(Property(DatumType::Float, "LOD Reduction", this, &mLodReduction, 1, HandlePropChange));
+    outProps.push_back(Property(DatumType::Float, "LOD 1 Screen Size", this, &mLods[1].mScreenSize));
+    outProps.push_back(Property(DatumType::Float, "LOD 2 Screen Size", this, &mLods[2].mScreenSize));
+    outProps.push_back(Property(DatumType::Float, "LOD 3 Screen Size", this, &mLods[3].mScreenSize));
 }
 
 glm::vec4 StaticMesh::GetTypeColor()
@@ -529,6 +641,86 @@ Bounds StaticMesh::GetBounds() const
     return mBounds;
 }
 
+uint32_t StaticMesh::GetNumLods() const
+{
+    return mNumLods;
+}
+
+const StaticMeshLod& StaticMesh::GetLod(uint32_t lod) const
+{
+    assert(lod < mNumLods);
+    return mLods[lod];
+}
+
+const std::vector<IndexType>& StaticMesh::GetLodIndices() const
+{
+    return mLodIndices;
+}
+
+uint32_t StaticMesh::SelectLod(float screenSize) const
+{
+    uint32_t lod = 0;
+
+    for (uint32_t i = 1; i < mNumLods; ++i)
+    {
+        if (screenSize < mLods[i].mScreenSize)
+        {
+            lod = i;
+        }
+    }
+
+    return lod;
+}
+
+void StaticMesh::GenerateLods()
+{
+    mLodIndices.clear();
+    mNumLods = 1;
+    mLods[0].mFirstIndex = 0;
+    mLods[0].mNumIndices = mNumIndices;
+
+    uint32_t maxLods = (uint32_t)glm::clamp<int32_t>(mMaxLods, 1, MAX_MESH_LODS);
+    float reduction = glm::clamp(mLodReduction, 0.01f, 0.95f);
+
+    if (mVertices == nullptr ||
+        mNumIndices / 3 < MIN_LOD_TRIANGLES * 2)
+    {
+        return;
+    }
+
+    const uint8_t* positions = reinterpret_cast<const uint8_t*>(mVertices) +
+        (mHasVertexColor ? offsetof(VertexColor, mPosition) : offsetof(Vertex, mPosition));
+
+    // Each LOD is simplified from the previous one, which is faster and keeps the LODs nested.
+    std::vector<IndexType> lodIndices(mIndices, mIndices + mNumIndices);
+    uint32_t prevNumIndices = mNumIndices;
+
+    for (uint32_t i = 1; i < maxLods; ++i)
+    {
+        uint32_t targetTris = uint32_t((prevNumIndices / 3) * reduction);
+
+        if (targetTris < MIN_LOD_TRIANGLES)
+            break;
+
+        uint32_t numIndices = MeshOpt_Simplify(lodIndices.data(), prevNumIndices, positions, GetVertexSize(), mNumVertices, targetTris * 3);
+
+        // Stop once the simplifier is stuck on locked borders/seams.
+        if (numIndices > prevNumIndices * 0.9f)
+            break;
+
+        MeshOpt_OptimizeVertexCache(lodIndices.data(), numIndices, mNumVertices);
+
+        mLods[i].mFirstIndex = mNumIndices + uint32_t(mLodIndices.size());
+        mLods[i].mNumIndices = numIndices;
+        mLodIndices.insert(mLodIndices.end(), lodIndices.begin(), lodIndices.begin() + numIndices);
+        mNumLods++;
+
+        prevNumIndices = numIndices;
+    }
+
+    LogDebug("Generated %d LODs for %s (%d -> %d triangles)", mNumLods, GetName().c_str(), mNumIndices / 3, mLods[mNumLods - 1].mNumIndices / 3);
+}
+
 btBvhTriangleMeshShape* StaticMesh::GetTriangleCollisionShape()
 {
     return mGenerateTriangleCollisionMesh ? mTriangleCollisionShape : nullptr;
@@ -809,6 +1001,21 @@ void StaticMesh::Create(
         mIndices[i * 3 + 2] = (IndexType) faces[i].mIndices[2];
     }
 
+    // Reorder for the vertex cache, overdraw and vertex fetch before anything else reads the buffers.
+    MeshOptimizeStats optStats;
+    mNumVertices = MeshOpt_OptimizeMesh(
+        reinterpret_cast<uint8_t*>(mVertices),
+        GetVertexSize(),
+        mHasVertexColor ? offsetof(VertexColor, mPosition) : offsetof(Vertex, mPosition),
+        mNumVertices,
+        mIndices,
+        mNumIndices,
+        &optStats);
+
+    LogDebug("Optimized mesh %s: ACMR %.3f -> %.3f", GetName().c_str(), optStats.mAcmrBefore, optStats.mAcmrAfter);
+
+    GenerateLods();
+
     // Next, create collision objects for the collision meshes.
     uint32_t numCollisionShapes = 0;
     btCollisionShape* collisionShapes[MAX_COLLISION_SHAPES] = {};
@@ -3,6 +3,7 @@
 #include "Log.h"
 #include "AssetManager.h"
 #include "Engine.h"
+#include "BlockCompressor.h"
 
 #include <malloc.h>
 
@@ -49,6 +50,17 @@ static const char* sWrapEnumStrings[] =
 };
 static_assert(uint32_t(WrapMode::Count) == 3, "Need to update wrap mode enum string table");
 
+static const char* sCompressionEnumStrings[] =
+{
+    "None",
+    "Auto",
+    "BC1",
+    "BC3",
+    "BC5",
+    "BC7"
+};
+static_assert(uint32_t(TextureCompression::Count) == 6, "Need to update compression enum string table");
+
 FORCE_LINK_DEF(Texture);
 DEFINE_ASSET(Texture);
 
@@ -105,13 +117,46 @@ bool UseCookedTextures(Platform platform)
     return cook;
 }
 
+bool UseBlockCompression(Platform platform)
+{
+    return (platform == Platform::Windows ||
+        platform == Platform::Linux);
+}
+
+void CookBlockCompressedTexture(Texture* texture, PixelFormat format, const std::vector<uint8_t>& srcPixels, std::vector<uint8_t>& outData)
+{
+#if EDITOR
+    // Mips are box filtered from the previous level and compressed one after another.
+    uint32_t width = texture->GetWidth();
+    uint32_t height = texture->GetHeight();
+    uint32_t numMips = texture->IsMipmapped() ? texture->GetMipLevels() : 1;
+
+    std::vector<uint8_t> mipPixels = srcPixels;
+    std::vector<uint8_t> nextMipPixels;
+
+    for (uint32_t mip = 0; mip < numMips; ++mip)
+    {
+        BC_CompressImage(format, mipPixels.data(), width, height, outData);
+
+        if (mip + 1 < numMips)
+        {
+            BC_DownsampleImage(mipPixels.data(), width, height, nextMipPixels);
+            mipPixels.swap(nextMipPixels);
+            width = glm::max(width / 2, 1u);
+            height = glm::max(height / 2, 1u);
+        }
+    }
+#endif
+}
+
 void CookTexture(Texture* texture, Platform platform, const std::vector<uint8_t>& srcPixels, std::vector<uint8_t>& outData)
 {
 #if EDITOR
     // (1) Save a temporary PNG in the Intermediate directory.
+    // Temp files are named after the texture since several textures can be cooking at once.
     std::string tempDir = GetEngineState()->mProjectDirectory + "Intermediate";
-    const char* tempPng = "Temp.png";
-    const char* tempOut = "Temp.tex";
+    std::string tempPng = "Temp_" + texture->GetName() + ".png";
+    std::string tempOut = "Temp_" + texture->GetName() + ".tex";
 
     std::string pngPath = tempDir + "/" + tempPng;
     std::string outPath = tempDir + "/" + tempOut;
@@ -245,6 +290,9 @@ void CookTexture(Texture* texture, Platform platform, const std::vector<uint8_t>
     stream.ReadFile(outPath.c_str());
     outData.resize(stream.GetSize());
     memcpy(outData.data(), stream.GetData(), stream.GetSize());
+
+    SYS_RemoveFile(pngPath.c_str());
+    SYS_RemoveFile(outPath.c_str());
 #endif
 }
 
@@ -257,6 +305,8 @@ Texture::Texture() :
     mFormat(PixelFormat::RGBA8),
     mFilterType(FilterType::Linear),
     mWrapMode(WrapMode::Repeat),
+    mCompression(TextureCompression::Auto),
+    mCookedFormat(PixelFormat::RGBA8),
     mMipmapped(true),
     mRenderTarget(false)
 {
@@ -288,6 +338,13 @@ void Texture::LoadStream(Stream& stream, Platform platform)
     mMipmapped = stream.ReadBool();
     mRenderTarget = stream.ReadBool();
 
+    mCookedFormat = PixelFormat::RGBA8;
+
+    if (mVersion >= ASSET_VERSION_TEXTURE_COMPRESSION)
+    {
+        mCompression = (TextureCompression)stream.ReadUint32();
+    }
+
     if (UseCookedTextures(platform))
     {
         uint32_t cookedDataSize = stream.ReadUint32();
@@ -296,12 +353,27 @@ void Texture::LoadStream(Stream& stream, Platform platform)
     }
     else
     {
-        int32_t size = (mWidth * mHeight * RGBA8_SIZE);
-        mPixels.resize(size);
+        if (mVersion >= ASSET_VERSION_TEXTURE_COMPRESSION)
+        {
+            mCookedFormat = (PixelFormat)stream.ReadUint32();
+        }
 
-        for (int32_t i = 0; i < size; ++i)
+        if (mCookedFormat != PixelFormat::RGBA8)
         {
-            mPixels[i] = stream.ReadUint8();
+            assert(BC_IsBlockFormat(mCookedFormat));
+            uint32_t cookedDataSize = stream.ReadUint32();
+            mPixels.resize(cookedDataSize);
+            stream.ReadBytes(mPixels.data(), cookedDataSize);
+        }
+        else
+        {
+            int32_t size = (mWidth * mHeight * RGBA8_SIZE);
+            mPixels.resize(size);
+
+            for (int32_t i = 0; i < size; ++i)
+            {
+                mPixels[i] = stream.ReadUint8();
+            }
         }
     }
 }
@@ -324,6 +396,10 @@ void Texture::SaveStream(Stream& stream, Platform platform)
     stream.WriteBool(mMipmapped);
     stream.WriteBool(mRenderTarget);
 
+    stream.WriteUint32(uint32_t(mCompression));
+
+    PixelFormat blockFormat = UseBlockCompression(platform) ? GetBlockFormat() : PixelFormat::RGBA8;
+
     if (UseCookedTextures(platform))
     {
         std::vector<uint8_t> cookedData;
@@ -332,8 +408,19 @@ void Texture::SaveStream(Stream& stream, Platform platform)
         stream.WriteUint32(cookedDataSize);
         stream.WriteBytes(cookedData.data(), cookedDataSize);
     }
+    else if (blockFormat != PixelFormat::RGBA8)
+    {
+        std::vector<uint8_t> cookedData;
+        CookBlockCompressedTexture(this, blockFormat, mPixels, cookedData);
+        uint32_t cookedDataSize = (uint32_t)cookedData.size();
+        stream.WriteUint32(uint32_t(blockFormat));
+        stream.WriteUint32(cookedDataSize);
+        stream.WriteBytes(cookedData.data(), cookedDataSize);
+    }
     else
     {
+        stream.WriteUint32(uint32_t(PixelFormat::RGBA8));
+
         // If not using an custom formats, just write out the raw RGBA8 pixels, uncompressed.
         assert(mPixels.size() == (mWidth * mHeight * RGBA8_SIZE));
         for (int32_t i = 0; i < int32_t(mPixels.size()); ++i)
@@ -411,6 +498,7 @@ void Texture::GatherProperties(std::vector<Property>& outProps)
     outProps.push_back(Property(DatumType::Enum, "Format", this, &mFormat, 1, Texture::HandlePropChange, 0, 5, sPixelFormatEnumStrings));
     outProps.push_back(Property(DatumType::Enum, "Filter Type", this, &mFilterType, 1, Texture::HandlePropChange, 0, int32_t(FilterType::Count), sFilterEnumStrings));
     outProps.push_back(Property(DatumType::Enum, "Wrap Mode", this, &mWrapMode, 1, Texture::HandlePropChange, 0, int32_t(WrapMode::Count), sWrapEnumStrings));
+    outProps.push_back(Property(DatumType::Enum, "Compression", this, &mCompression, 1, nullptr, 0, int32_t(TextureCompression::Count), sCompressionEnumStrings));
 }
 
 glm::vec4 Texture::GetTypeColor()
@@ -486,3 +574,54 @@ WrapMode Texture::GetWrapMode() const
 {
     return mWrapMode;
 }
+
+TextureCompression Texture::GetCompression() const
+{
+    return mCompression;
+}
+
+PixelFormat Texture::GetCookedFormat() const
+{
+    return mCookedFormat;
+}
+
+PixelFormat Texture::GetBlockFormat() const
+{
+    PixelFormat format = PixelFormat::RGBA8;
+
+    // Render targets and textures without source pixels can't be compressed.
+    if (mRenderTarget ||
+        mPixels.size() != mWidth * mHeight * RGBA8_SIZE)
+    {
+        return format;
+    }
+
+    switch (mCompression)
+    {
+    case TextureCompression::BC1: format = PixelFormat::BC1; break;
+    case TextureCompression::BC3: format = PixelFormat::BC3; break;
+    case TextureCompression::BC5: format = PixelFormat::BC5; break;
+    case TextureCompression::BC7: format = PixelFormat::BC7; break;
+    case TextureCompression::Auto:
+    {
+        // Opaque textures only need BC1, anything with alpha gets the separate BC3 alpha block.
+        bool opaque = true;
+        for (uint32_t i = 3; i < mPixels.size(); i += RGBA8_SIZE)
+        {
+            if (mPixels[i] != 0xff)
+            {
+                opaque = false;
+                break;
+            }
+        }
+
+        format = opaque ? PixelFormat::BC1 : PixelFormat::BC3;
+        break;
+    }
+    case TextureCompression::None:
+    default:
+        break;
+    }
+
+    return format;
+}
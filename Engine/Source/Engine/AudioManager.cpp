@@ -13,10 +13,24 @@
 #include "Audio/AudioConstants.h"
 
 #include <glm/glm.hpp>
+#include <float.h>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
 
 // TODO: define max audio sources as AUDIO_MAX_VOICES
 #define MAX_AUDIO_SOURCES AUDIO_MAX_VOICES
 
+// Playing components are bucketed into a uniform grid. Each component is inserted into every cell
+// overlapped by the bounds of its outer radius, so the listener's cell holds every component that could be heard.
+// Components that would cover too many cells are kept in a separate list that is always checked.
+#define AUDIO_GRID_CELL_SIZE 32.0f
+#define AUDIO_GRID_MAX_CELLS 64
+
+// A new sound must score this much higher than the quietest real voice to take it over.
+// Stops two similarly loud sounds from trading the same voice back and forth every frame.
+#define AUDIO_EVICTION_HYSTERESIS 1.25f
+
 struct AudioSource
 {
     SoundWaveRef mSoundWave;
@@ -28,6 +42,9 @@ struct AudioSource
     float mInnerRadius;
     float mOuterRadius;
     AttenuationFunc mAttenuationFunc;
+    bool mLoop;
+    float mPlayTime;
+    float mScore;
 
     AudioSource()
     {
@@ -43,7 +60,9 @@ struct AudioSource
         glm::vec3 position,
         float innerRadius,
         float outerRadius,
-        AttenuationFunc attenFunc)
+        AttenuationFunc attenFunc,
+        bool loop,
+        float playTime)
     {
         mSoundWave = soundWave;
         mComponent = component;
@@ -54,6 +73,9 @@ struct AudioSource
         mInnerRadius = innerRadius;
         mOuterRadius = outerRadius;
         mAttenuationFunc = attenFunc;
+        mLoop = loop;
+        mPlayTime = playTime;
+        mScore = 0.0f;
     }
 
     void Reset()
@@ -67,11 +89,41 @@ struct AudioSource
         mInnerRadius = -1.0f;
         mOuterRadius = -1.0f;
         mAttenuationFunc = AttenuationFunc::Count;
+        mLoop = false;
+        mPlayTime = 0.0f;
+        mScore = 0.0f;
     }
 };
 
+struct AudioGridEntry
+{
+    glm::ivec3 mMin = {};
+    glm::ivec3 mMax = {};
+    bool mUnbounded = false;
+};
+
+struct VoiceCandidate
+{
+    AudioComponent* mComponent = nullptr;
+    int32_t mVirtualIndex = -1;
+    float mLoudness = 0.0f;
+    float mScore = 0.0f;
+};
+
 static AudioSource sAudioSources[MAX_AUDIO_SOURCES];
 
+// One-shot sounds (PlaySound2D/3D) that currently don't have a real voice.
+// Components don't need an entry here because they track their own play time.
+static std::vector<AudioSource> sVirtualSounds;
+
+static std::unordered_map<uint64_t, std::vector<AudioComponent*>> sComponentGrid;
+static std::unordered_map<AudioComponent*, AudioGridEntry> sComponentEntries;
+static std::vector<AudioComponent*> sUnboundedComponents;
+
+static std::vector<VoiceCandidate> sCandidates;
+static uint32_t sNumRealVoices = 0;
+static uint32_t sNumVirtualVoices = 0;
+
 float CalcVolumeAttenuation(AttenuationFunc func, float innerRadius, float outerRadius, float distance)
 {
     float ret = 1.0f;
@@ -93,54 +145,99 @@ float CalcVolumeAttenuation(AttenuationFunc func, float innerRadius, float outer
     return ret;
 }
 
-void PlayAudio(
-    uint32_t sourceIndex,
-    SoundWave* soundWave,
-    AudioComponent* component,
-    float volumeMult,
-    float pitchMult,
-    int32_t priority,
-    glm::vec3 position,
-    float innerRadius,
-    float outerRadius,
-    AttenuationFunc attenFunc,
-    bool loop,
-    float startTime)
+static bool IsSpatial(const AudioSource& source)
+{
+    return (source.mInnerRadius >= 0.0f &&
+        source.mOuterRadius > 0.0f &&
+        source.mAttenuationFunc != AttenuationFunc::Count);
+}
+
+static float CalcPriorityWeight(int32_t priority)
+{
+    // Each priority level above 0 adds another multiple of loudness, each level below 0 divides it.
+    return (priority >= 0) ? float(1 + priority) : (1.0f / float(1 - priority));
+}
+
+static float CalcLoudness(const AudioSource& source, glm::vec3 listenerPos)
+{
+    SoundWave* soundWave = source.mSoundWave.Get<SoundWave>();
+    float loudness = source.mVolumeMult * soundWave->GetVolumeMultiplier();
+
+    if (IsSpatial(source))
+    {
+        float dist = glm::distance(listenerPos, source.mPosition);
+
+        if (dist > source.mOuterRadius)
+        {
+            loudness = 0.0f;
+        }
+        else
+        {
+            loudness *= CalcVolumeAttenuation(
+                source.mAttenuationFunc,
+                source.mInnerRadius,
+                source.mOuterRadius,
+                dist);
+        }
+    }
+
+    return loudness;
+}
+
+static glm::vec3 GetListenerPosition()
+{
+    World* world = GetWorld();
+    TransformComponent* listener = world ? world->GetAudioReceiver() : nullptr;
+    return listener ? listener->GetAbsolutePosition() : glm::vec3(0, 0, 0);
+}
+
+static void InitComponentSource(AudioSource& source, AudioComponent* comp)
+{
+    source.Set(
+        comp->GetSoundWave(),
+        comp,
+        comp->GetVolume(),
+        comp->GetPitch(),
+        comp->GetPriority(),
+        comp->GetAbsolutePosition(),
+        comp->GetInnerRadius(),
+        comp->GetOuterRadius(),
+        comp->GetAttenuationFunc(),
+        comp->GetLoop(),
+        comp->GetStartOffset() + comp->GetPlayTime());
+}
+
+void PlayAudio(uint32_t sourceIndex, const AudioSource& source, float loudness)
 {
     assert(sourceIndex < MAX_AUDIO_SOURCES);
+    SoundWave* soundWave = source.mSoundWave.Get<SoundWave>();
     assert(soundWave != nullptr);
 
-    sAudioSources[sourceIndex].Set(
-        soundWave,
-        component,
-        volumeMult,
-        pitchMult,
-        priority,
-        position,
-        innerRadius,
-        outerRadius,
-        attenFunc);
+    sAudioSources[sourceIndex] = source;
 
-    float volume = volumeMult * soundWave->GetVolumeMultiplier();
-    float pitch = pitchMult * soundWave->GetPitchMultiplier();
+    float pitch = source.mPitchMult * soundWave->GetPitchMultiplier();
 
-    if (component != nullptr)
+    if (source.mComponent != nullptr)
     {
-        component->NotifyAudible(true);
+        source.mComponent->NotifyAudible(true);
     }
 
-    bool spatial = (innerRadius >= 0.0f &&
-        outerRadius > 0.0f &&
-        attenFunc != AttenuationFunc::Count);
+    // Resume at the point the sound would have reached if it had been audible all along.
+    float soundDuration = soundWave->GetDuration();
+    float startTime = (soundDuration > 0.0f) ? glm::mod(source.mPlayTime, soundDuration) : 0.0f;
+    if (startTime >= soundDuration)
+    {
+        startTime = 0.0f;
+    }
 
     AUD_Play(
         sourceIndex,
         soundWave,
-        volume,
+        loudness,
         pitch,
-        loop,
+        source.mLoop,
         startTime,
-        spatial);
+        IsSpatial(source));
 }
 
 void StopAudio(uint32_t sourceIndex)
@@ -155,194 +252,392 @@ void StopAudio(uint32_t sourceIndex)
     sAudioSources[sourceIndex].Reset();
 }
 
-uint32_t FindAvailableAudioSourceIndex(int32_t inPriority)
+// Stops the real voice but keeps tracking the sound so it can be promoted again later.
+void DemoteAudio(uint32_t sourceIndex)
+{
+    if (sAudioSources[sourceIndex].mComponent == nullptr)
+    {
+        sVirtualSounds.push_back(sAudioSources[sourceIndex]);
+    }
+
+    StopAudio(sourceIndex);
+}
+
+uint32_t FindAvailableAudioSourceIndex(float score)
 {
-    uint32_t availableIndex = MAX_AUDIO_SOURCES;
-    int32_t lowestPriority = 0x7fffffff;
-    uint32_t lowestPriorityIndex = 0;
+    float lowestScore = FLT_MAX;
+    uint32_t lowestScoreIndex = MAX_AUDIO_SOURCES;
 
     for (uint32_t i = 0; i < MAX_AUDIO_SOURCES; ++i)
     {
         if (sAudioSources[i].mSoundWave.Get() == nullptr)
         {
-            availableIndex = i;
-            break;
+            return i;
         }
 
-        if (sAudioSources[i].mPriority < lowestPriority)
+        if (sAudioSources[i].mScore < lowestScore)
         {
-            lowestPriority = sAudioSources[i].mPriority;
-            lowestPriorityIndex = i;
+            lowestScore = sAudioSources[i].mScore;
+            lowestScoreIndex = i;
         }
     }
 
-    // All sources are being used. But see if we can evict one with lower priority
-    if (availableIndex == MAX_AUDIO_SOURCES &&
-        lowestPriority < inPriority)
+    // All sources are being used. But see if this sound should take over the quietest one.
+    if (lowestScoreIndex < MAX_AUDIO_SOURCES &&
+        score > lowestScore * AUDIO_EVICTION_HYSTERESIS)
     {
-        LogWarning("Evicting lower priority sound");
-        StopAudio(lowestPriorityIndex);
-        availableIndex = lowestPriorityIndex;
+        DemoteAudio(lowestScoreIndex);
+        return lowestScoreIndex;
     }
 
-    return availableIndex;
+    return MAX_AUDIO_SOURCES;
 }
 
-void AudioManager::Initialize()
+static void PlayOrVirtualize(AudioSource& source)
 {
+    float loudness = CalcLoudness(source, GetListenerPosition());
+    source.mScore = loudness * CalcPriorityWeight(source.mPriority);
+
+    uint32_t sourceIndex = (loudness > 0.0f) ? FindAvailableAudioSourceIndex(source.mScore) : MAX_AUDIO_SOURCES;
 
+    if (sourceIndex < MAX_AUDIO_SOURCES)
+    {
+        PlayAudio(sourceIndex, source, loudness);
+    }
+    else
+    {
+        sVirtualSounds.push_back(source);
+    }
 }
 
-void AudioManager::Shutdown()
+static uint64_t GetGridCellKey(int32_t x, int32_t y, int32_t z)
 {
+    const uint64_t mask = 0x1fffff;
+    return ((uint64_t(x) & mask) << 42) | ((uint64_t(y) & mask) << 21) | (uint64_t(z) & mask);
+}
 
+static glm::ivec3 GetGridCell(glm::vec3 position)
+{
+    return glm::ivec3(glm::floor(position / AUDIO_GRID_CELL_SIZE));
 }
 
-void AudioManager::Update(float deltaTime)
+static AudioGridEntry CalcGridEntry(AudioComponent* comp)
 {
-    SCOPED_CPU_STAT("Audio");
+    glm::vec3 position = comp->GetAbsolutePosition();
+    glm::vec3 radius = glm::vec3(glm::max(0.0f, comp->GetOuterRadius()));
 
-    // TODO:
-    // (1) -- Update Active Sources --
-    //     Iterate through audio sources and update volume for any 3D sounds (including components)
-    //     If an source has finished playing, Reset the source (and notify the component if applicable).
-    //     Do not evict 3D sounds that are out of range. We want to hear them when we return.
-    //     Evict components if out of hearing range.
-    // (2) -- Play New Sounds --
-    //     Iterate over AudioComponent list. If any component is playing and in range, but has no audio source active,
-    //     then find an available audio source and Play(). Use component's mPlayTime var to start at correct time.
+    AudioGridEntry entry;
+    entry.mMin = GetGridCell(position - radius);
+    entry.mMax = GetGridCell(position + radius);
 
+    glm::ivec3 extent = entry.mMax - entry.mMin + glm::ivec3(1);
+    entry.mUnbounded = (int64_t(extent.x) * extent.y * extent.z > AUDIO_GRID_MAX_CELLS);
 
-    // (1) Update Active Sources
-    TransformComponent* listener = GetWorld()->GetAudioReceiver();
-    glm::vec3 listenerPos = listener ? listener->GetAbsolutePosition() : glm::vec3(0,0,0);
+    return entry;
+}
 
-    for (uint32_t i = 0; i < MAX_AUDIO_SOURCES; ++i)
+static void RemoveFromList(std::vector<AudioComponent*>& list, AudioComponent* comp)
+{
+    for (uint32_t i = 0; i < list.size(); ++i)
     {
-        if (sAudioSources[i].mSoundWave.Get() != nullptr)
+        if (list[i] == comp)
         {
-            SoundWave* soundWave = sAudioSources[i].mSoundWave.Get<SoundWave>();
-            bool stopped = false;
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
+}
+
+static void InsertIntoGrid(AudioComponent* comp, const AudioGridEntry& entry)
+{
+    if (entry.mUnbounded)
+    {
+        sUnboundedComponents.push_back(comp);
+        return;
+    }
 
-            if (sAudioSources[i].mComponent != nullptr &&
-                !sAudioSources[i].mComponent->IsPlaying())
+    for (int32_t x = entry.mMin.x; x <= entry.mMax.x; ++x)
+    {
+        for (int32_t y = entry.mMin.y; y <= entry.mMax.y; ++y)
+        {
+            for (int32_t z = entry.mMin.z; z <= entry.mMax.z; ++z)
             {
-                // If the component has been stopped, then stop the source!
-                StopAudio(i);
-                stopped = true;
+                sComponentGrid[GetGridCellKey(x, y, z)].push_back(comp);
             }
-            else if (!AUD_IsPlaying(i))
-            {
-                // If the audio engine has finished the sound wave, then stop it.
-                if (sAudioSources[i].mComponent != nullptr &&
-                    !sAudioSources[i].mComponent->GetLoop())
-                {
-                    sAudioSources[i].mComponent->Stop();
-                }
+        }
+    }
+}
 
-                StopAudio(i);
-                stopped = true;
-            }
-            else if (sAudioSources[i].mInnerRadius >= 0.0f &&
-                sAudioSources[i].mOuterRadius > 0.0f &&
-                sAudioSources[i].mAttenuationFunc != AttenuationFunc::Count)
-            {
-                // Update attenuation of the 3D sound
-                if (sAudioSources[i].mComponent != nullptr)
-                {
-                    sAudioSources[i].mPosition = sAudioSources[i].mComponent->GetAbsolutePosition();
-                }
+static void RemoveFromGrid(AudioComponent* comp, const AudioGridEntry& entry)
+{
+    if (entry.mUnbounded)
+    {
+        RemoveFromList(sUnboundedComponents, comp);
+        return;
+    }
 
-                float dist = glm::distance(listenerPos, sAudioSources[i].mPosition);
+    for (int32_t x = entry.mMin.x; x <= entry.mMax.x; ++x)
+    {
+        for (int32_t y = entry.mMin.y; y <= entry.mMax.y; ++y)
+        {
+            for (int32_t z = entry.mMin.z; z <= entry.mMax.z; ++z)
+            {
+                auto it = sComponentGrid.find(GetGridCellKey(x, y, z));
 
-                if (sAudioSources[i].mComponent != nullptr && 
-                    dist > sAudioSources[i].mOuterRadius)
-                {
-                    // Sound is no longer in hearing range.
-                    // If this belongs to a component, Stop() the sound.
-                    StopAudio(i);
-                    stopped = true;
-                }
-                else
+                if (it != sComponentGrid.end())
                 {
-                    // Otherwise update the new volume
-                    float volume = CalcVolumeAttenuation(
-                        sAudioSources[i].mAttenuationFunc,
-                        sAudioSources[i].mInnerRadius,
-                        sAudioSources[i].mOuterRadius,
-                        dist);
-
-                    volume = volume * sAudioSources[i].mVolumeMult * soundWave->GetVolumeMultiplier();
-                    AUD_SetVolume(i, volume, volume);
-                }
+                    RemoveFromList(it->second, comp);
 
-                if (!stopped &&
-                    sAudioSources[i].mComponent != nullptr)
-                {
-                    if (sAudioSources[i].mPitchMult != sAudioSources[i].mComponent->GetPitch())
+                    if (it->second.empty())
                     {
-                        sAudioSources[i].mPitchMult = sAudioSources[i].mComponent->GetPitch();
-                        AUD_SetPitch(i, sAudioSources[i].mPitchMult);
+                        sComponentGrid.erase(it);
                     }
                 }
             }
         }
     }
+}
 
-    // (2) Play New Sounds
-    World* world = GetWorld();
-    if (world != nullptr)
+static void AddComponentCandidate(AudioComponent* comp, glm::vec3 listenerPos)
+{
+    // Only components that are playing but not currently assigned to a real voice.
+    if (comp->IsPlaying() &&
+        !comp->IsAudible() &&
+        comp->GetVolume() > 0.0f &&
+        comp->GetSoundWave() != nullptr)
+    {
+        AudioSource source;
+        InitComponentSource(source, comp);
+        float loudness = CalcLoudness(source, listenerPos);
+
+        if (loudness > 0.0f)
+        {
+            VoiceCandidate candidate;
+            candidate.mComponent = comp;
+            candidate.mLoudness = loudness;
+            candidate.mScore = loudness * CalcPriorityWeight(comp->GetPriority());
+            sCandidates.push_back(candidate);
+        }
+    }
+}
+
+void AudioManager::Initialize()
+{
+
+}
+
+void AudioManager::Shutdown()
+{
+    sVirtualSounds.clear();
+    sComponentGrid.clear();
+    sComponentEntries.clear();
+    sUnboundedComponents.clear();
+    sCandidates.clear();
+}
+
+void AudioManager::Update(float deltaTime)
+{
+    SCOPED_CPU_STAT("Audio");
+
+    // (1) -- Update Real Voices --
+    //     Update volume/pitch of active sources and compute their loudness x priority score.
+    //     Finished sources are reset. Sources that fall out of hearing range are demoted to virtual voices.
+    // (2) -- Update Virtual Voices --
+    //     Advance the play time of virtual one-shots and gather the audible ones as candidates,
+    //     along with playing components found in the listener's grid cell.
+    // (3) -- Promote --
+    //     Sort candidates by score and give them free sources, or take over sources with a lower score.
+
+    glm::vec3 listenerPos = GetListenerPosition();
+    uint32_t numRealComponents = 0;
+
+    // (1) Update Real Voices
+    for (uint32_t i = 0; i < MAX_AUDIO_SOURCES; ++i)
     {
-        const std::vector<AudioComponent*>& components = GetWorld()->GetAudioComponents();
+        AudioSource& source = sAudioSources[i];
 
-        for (uint32_t i = 0; i < components.size(); ++i)
+        if (source.mSoundWave.Get() == nullptr)
         {
-            AudioComponent* comp = components[i];
-
-            // In the case that the component is playing, but it is inaudible (not a current sound source)
-            // Then we need to check if it should be audible
-            if (comp->IsPlaying() &&
-                !comp->IsAudible() &&
-                comp->GetVolume() > 0.0f &&
-                comp->GetSoundWave() != nullptr)
+            continue;
+        }
+
+        if (source.mComponent != nullptr &&
+            !source.mComponent->IsPlaying())
+        {
+            // If the component has been stopped, then stop the source!
+            StopAudio(i);
+            continue;
+        }
+
+        if (!AUD_IsPlaying(i))
+        {
+            // If the audio engine has finished the sound wave, then stop it.
+            if (source.mComponent != nullptr &&
+                !source.mComponent->GetLoop())
             {
-                // We need to check the distance to the listener. Should it be audible?
-                glm::vec3 compPosition = comp->GetAbsolutePosition();
-                float dist = glm::distance(listenerPos, compPosition);
-                float outerRadius = glm::max(0.0f, comp->GetOuterRadius());
+                source.mComponent->Stop();
+            }
+
+            StopAudio(i);
+            continue;
+        }
+
+        source.mPlayTime += deltaTime;
+
+        if (source.mComponent != nullptr)
+        {
+            source.mPosition = source.mComponent->GetAbsolutePosition();
+            source.mVolumeMult = source.mComponent->GetVolume();
+            source.mPriority = source.mComponent->GetPriority();
+
+            if (source.mPitchMult != source.mComponent->GetPitch())
+            {
+                source.mPitchMult = source.mComponent->GetPitch();
+                AUD_SetPitch(i, source.mPitchMult);
+            }
+        }
+
+        float loudness = CalcLoudness(source, listenerPos);
+
+        if (IsSpatial(source))
+        {
+            if (loudness <= 0.0f)
+            {
+                // Out of hearing range. Keep tracking it virtually so we hear it when we return.
+                DemoteAudio(i);
+                continue;
+            }
+
+            AUD_SetVolume(i, loudness, loudness);
+        }
+
+        source.mScore = loudness * CalcPriorityWeight(source.mPriority);
+
+        if (source.mComponent != nullptr)
+        {
+            numRealComponents++;
+        }
+    }
+
+    // (2) Update Virtual Voices
+    sCandidates.clear();
+
+    for (uint32_t i = 0; i < sVirtualSounds.size();)
+    {
+        AudioSource& virtualSound = sVirtualSounds[i];
+        SoundWave* soundWave = virtualSound.mSoundWave.Get<SoundWave>();
+        virtualSound.mPlayTime += deltaTime;
+
+        if (soundWave == nullptr ||
+            (!virtualSound.mLoop && virtualSound.mPlayTime >= soundWave->GetDuration()))
+        {
+            // Finished while virtual
+            virtualSound = sVirtualSounds.back();
+            sVirtualSounds.pop_back();
+            continue;
+        }
+
+        float loudness = CalcLoudness(virtualSound, listenerPos);
+
+        if (loudness > 0.0f)
+        {
+            VoiceCandidate candidate;
+            candidate.mVirtualIndex = int32_t(i);
+            candidate.mLoudness = loudness;
+            candidate.mScore = loudness * CalcPriorityWeight(virtualSound.mPriority);
+            sCandidates.push_back(candidate);
+        }
+
+        ++i;
+    }
+
+    glm::ivec3 listenerCell = GetGridCell(listenerPos);
+    auto cellIt = sComponentGrid.find(GetGridCellKey(listenerCell.x, listenerCell.y, listenerCell.z));
+
+    if (cellIt != sComponentGrid.end())
+    {
+        for (uint32_t i = 0; i < cellIt->second.size(); ++i)
+        {
+            AddComponentCandidate(cellIt->second[i], listenerPos);
+        }
+    }
+
+    for (uint32_t i = 0; i < sUnboundedComponents.size(); ++i)
+    {
+        AddComponentCandidate(sUnboundedComponents[i], listenerPos);
+    }
+
+    // (3) Promote
+    std::sort(sCandidates.begin(), sCandidates.end(),
+        [](const VoiceCandidate& a, const VoiceCandidate& b)
+        {
+            return a.mScore > b.mScore;
+        });
+
+    bool promotedVirtualSound = false;
+
+    for (uint32_t i = 0; i < sCandidates.size(); ++i)
+    {
+        const VoiceCandidate& candidate = sCandidates[i];
+        uint32_t sourceIndex = FindAvailableAudioSourceIndex(candidate.mScore);
+
+        if (sourceIndex == MAX_AUDIO_SOURCES)
+        {
+            // Candidates are sorted, so nothing after this will win a voice either.
+            break;
+        }
+
+        if (candidate.mComponent != nullptr)
+        {
+            AudioSource source;
+            InitComponentSource(source, candidate.mComponent);
+            source.mScore = candidate.mScore;
+            PlayAudio(sourceIndex, source, candidate.mLoudness);
+            numRealComponents++;
+        }
+        else
+        {
+            // Promoting may have demoted another sound into sVirtualSounds, so index after finding the source.
+            AudioSource& virtualSound = sVirtualSounds[candidate.mVirtualIndex];
+            virtualSound.mScore = candidate.mScore;
+            PlayAudio(sourceIndex, virtualSound, candidate.mLoudness);
+            virtualSound.mSoundWave = nullptr;
+            promotedVirtualSound = true;
+        }
+    }
 
-                if (dist < outerRadius)
+    if (promotedVirtualSound)
+    {
+        sVirtualSounds.erase(
+            std::remove_if(sVirtualSounds.begin(), sVirtualSounds.end(),
+                [](const AudioSource& source)
                 {
-                    // It should be audible, so attempt to add it as a sound source.
-                    uint32_t sourceIndex = FindAvailableAudioSourceIndex(comp->GetPriority());
+                    return source.mSoundWave.Get() == nullptr;
+                }),
+            sVirtualSounds.end());
+    }
 
-                    float soundDuration = comp->GetSoundWave()->GetDuration();
-                    float startTime = glm::mod(comp->GetStartOffset() + comp->GetPlayTime(), soundDuration);
-                    if (startTime >= soundDuration)
-                    {
-                        startTime = 0.0f;
-                    }
+    // Demoting a component during promotion would leave numRealComponents too high, so recount.
+    sNumRealVoices = 0;
+    numRealComponents = 0;
 
-                    if (sourceIndex < MAX_AUDIO_SOURCES)
-                    {
-                        PlayAudio(
-                            sourceIndex,
-                            comp->GetSoundWave(),
-                            comp,
-                            comp->GetVolume(),
-                            comp->GetPitch(),
-                            comp->GetPriority(),
-                            compPosition,
-                            comp->GetInnerRadius(),
-                            comp->GetOuterRadius(),
-                            comp->GetAttenuationFunc(),
-                            comp->GetLoop(),
-                            startTime);
-                    }
-                }
+    for (uint32_t i = 0; i < MAX_AUDIO_SOURCES; ++i)
+    {
+        if (sAudioSources[i].mSoundWave.Get() != nullptr)
+        {
+            sNumRealVoices++;
+
+            if (sAudioSources[i].mComponent != nullptr)
+            {
+                numRealComponents++;
             }
         }
     }
+
+    uint32_t numTrackedComponents = uint32_t(sComponentEntries.size());
+    sNumVirtualVoices = uint32_t(sVirtualSounds.size()) +
+        ((numTrackedComponents > numRealComponents) ? (numTrackedComponents - numRealComponents) : 0);
 }
 
 void AudioManager::PlaySound2D(
@@ -353,24 +648,24 @@ void AudioManager::PlaySound2D(
     bool loop,
     int32_t priority)
 {
-    uint32_t sourceIndex = FindAvailableAudioSourceIndex(priority);
+    if (soundWave == nullptr)
+        return;
 
-    if (sourceIndex < MAX_AUDIO_SOURCES)
-    {
-        PlayAudio(
-            sourceIndex,
-            soundWave,
-            nullptr,
-            volumeMult,
-            pitchMult,
-            priority,
-            glm::vec3(0, 0, 0),
-            -1.0f,
-            -1.0f,
-            AttenuationFunc::Count,
-            loop,
-            startTime);
-    }
+    AudioSource source;
+    source.Set(
+        soundWave,
+        nullptr,
+        volumeMult,
+        pitchMult,
+        priority,
+        glm::vec3(0, 0, 0),
+        -1.0f,
+        -1.0f,
+        AttenuationFunc::Count,
+        loop,
+        startTime);
+
+    PlayOrVirtualize(source);
 }
 
 void AudioManager::PlaySound3D(
@@ -385,24 +680,24 @@ void AudioManager::PlaySound3D(
     bool loop,
     int32_t priority)
 {
-    uint32_t sourceIndex = FindAvailableAudioSourceIndex(priority);
+    if (soundWave == nullptr)
+        return;
 
-    if (sourceIndex != MAX_AUDIO_SOURCES)
-    {
-        PlayAudio(
-            sourceIndex,
-            soundWave,
-            nullptr,
-            volumeMult,
-            pitchMult,
-            priority,
-            worldPosition,
-            innerRadius,
-            outerRadius,
-            attenFunc,
-            loop,
-            startTime);
-    }
+    AudioSource source;
+    source.Set(
+        soundWave,
+        nullptr,
+        volumeMult,
+        pitchMult,
+        priority,
+        worldPosition,
+        innerRadius,
+        outerRadius,
+        attenFunc,
+        loop,
+        startTime);
+
+    PlayOrVirtualize(source);
 }
 
 void AudioManager::StopComponent(AudioComponent* comp)
@@ -429,6 +724,14 @@ void AudioManager::StopSounds(SoundWave* soundWave)
             StopAudio(i);
         }
     }
+
+    sVirtualSounds.erase(
+        std::remove_if(sVirtualSounds.begin(), sVirtualSounds.end(),
+            [soundWave](const AudioSource& source)
+            {
+                return source.mSoundWave.Get() == soundWave;
+            }),
+        sVirtualSounds.end());
 }
 
 void AudioManager::StopAllSounds()
@@ -440,4 +743,56 @@ void AudioManager::StopAllSounds()
             StopAudio(i);
         }
     }
+
+    sVirtualSounds.clear();
+}
+
+void AudioManager::TrackComponent(AudioComponent* comp)
+{
+    if (sComponentEntries.find(comp) == sComponentEntries.end())
+    {
+        AudioGridEntry entry = CalcGridEntry(comp);
+        InsertIntoGrid(comp, entry);
+        sComponentEntries[comp] = entry;
+    }
+}
+
+void AudioManager::UntrackComponent(AudioComponent* comp)
+{
+    auto it = sComponentEntries.find(comp);
+
+    if (it != sComponentEntries.end())
+    {
+        RemoveFromGrid(comp, it->second);
+        sComponentEntries.erase(it);
+    }
+}
+
+void AudioManager::UpdateComponentBounds(AudioComponent* comp)
+{
+    auto it = sComponentEntries.find(comp);
+
+    if (it != sComponentEntries.end())
+    {
+        AudioGridEntry newEntry = CalcGridEntry(comp);
+        AudioGridEntry& oldEntry = it->second;
+
+        if (newEntry.mUnbounded != oldEntry.mUnbounded ||
+            (!newEntry.mUnbounded && (newEntry.mMin != oldEntry.mMin || newEntry.mMax != oldEntry.mMax)))
+        {
+            RemoveFromGrid(comp, oldEntry);
+            InsertIntoGrid(comp, newEntry);
+            oldEntry = newEntry;
+        }
+    }
+}
+
+uint32_t AudioManager::GetNumRealVoices()
+{
+    return sNumRealVoices;
+}
+
+uint32_t AudioManager::GetNumVirtualVoices()
+{
+    return sNumVirtualVoices;
 }
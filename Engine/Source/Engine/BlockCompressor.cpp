@@ -0,0 +1,608 @@
+#include "BlockCompressor.h"
+
+#include <glm/glm.hpp>
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+
+static const uint32_t kBc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t outBlock[16][4])
+{
+    for (uint32_t y = 0; y < BC_BLOCK_DIM; ++y)
+    {
+        for (uint32_t x = 0; x < BC_BLOCK_DIM; ++x)
+        {
+            // Replicate edge pixels for partial blocks.
+            uint32_t srcX = glm::min(blockX * BC_BLOCK_DIM + x, width - 1);
+            uint32_t srcY = glm::min(blockY * BC_BLOCK_DIM + y, height - 1);
+            memcpy(outBlock[y * BC_BLOCK_DIM + x], &rgba[(srcY * width + srcX) * 4], 4);
+        }
+    }
+}
+
+// Mean and principal axis of numPoints points of the given dimension (3 or 4). Points with a false mask are skipped.
+static void ComputePrincipalAxis(const float* points, const bool* mask, uint32_t numPoints, uint32_t dim, float* outMean, float* outAxis)
+{
+    float mean[4] = {};
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < numPoints; ++i)
+    {
+        if (mask == nullptr || mask[i])
+        {
+            for (uint32_t c = 0; c < dim; ++c)
+            {
+                mean[c] += points[i * dim + c];
+            }
+
+            count++;
+        }
+    }
+
+    for (uint32_t c = 0; c < dim; ++c)
+    {
+        mean[c] /= float(glm::max(count, 1u));
+        outMean[c] = mean[c];
+    }
+
+    float cov[4][4] = {};
+
+    for (uint32_t i = 0; i < numPoints; ++i)
+    {
+        if (mask == nullptr || mask[i])
+        {
+            for (uint32_t r = 0; r < dim; ++r)
+            {
+                for (uint32_t c = 0; c < dim; ++c)
+                {
+                    cov[r][c] += (points[i * dim + r] - mean[r]) * (points[i * dim + c] - mean[c]);
+                }
+            }
+        }
+    }
+
+    // Power iteration converges quickly enough for 16 points.
+    float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    for (uint32_t iter = 0; iter < 8; ++iter)
+    {
+        float next[4] = {};
+        float lengthSq = 0.0f;
+
+        for (uint32_t r = 0; r < dim; ++r)
+        {
+            for (uint32_t c = 0; c < dim; ++c)
+            {
+                next[r] += cov[r][c] * axis[c];
+            }
+
+            lengthSq += next[r] * next[r];
+        }
+
+        if (lengthSq < 1e-12f)
+        {
+            // All points are the same.
+            memset(axis, 0, sizeof(axis));
+            break;
+        }
+
+        float invLength = 1.0f / sqrtf(lengthSq);
+
+        for (uint32_t c = 0; c < dim; ++c)
+        {
+            axis[c] = next[c] * invLength;
+        }
+    }
+
+    memcpy(outAxis, axis, sizeof(float) * dim);
+}
+
+static uint16_t PackRgb565(const glm::vec3& color)
+{
+    glm::vec3 c = glm::clamp(color, 0.0f, 255.0f);
+    uint32_t r = uint32_t(c.r * 31.0f / 255.0f + 0.5f);
+    uint32_t g = uint32_t(c.g * 63.0f / 255.0f + 0.5f);
+    uint32_t b = uint32_t(c.b * 31.0f / 255.0f + 0.5f);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+static glm::vec3 UnpackRgb565(uint16_t color)
+{
+    uint32_t r = (color >> 11) & 0x1f;
+    uint32_t g = (color >> 5) & 0x3f;
+    uint32_t b = color & 0x1f;
+    return glm::vec3(float((r << 3) | (r >> 2)), float((g << 2) | (g >> 4)), float((b << 3) | (b >> 2)));
+}
+
+// Picks indices for the given 565 endpoints and returns the total squared error.
+static float FitColorIndices(const glm::vec3 colors[16], const bool* transparent, uint16_t c0, uint16_t c1, uint32_t& outIndices)
+{
+    glm::vec3 p0 = UnpackRgb565(c0);
+    glm::vec3 p1 = UnpackRgb565(c1);
+    glm::vec3 palette[4];
+    uint32_t numColors = 4;
+
+    palette[0] = p0;
+    palette[1] = p1;
+
+    if (c0 > c1)
+    {
+        palette[2] = (2.0f * p0 + p1) / 3.0f;
+        palette[3] = (p0 + 2.0f * p1) / 3.0f;
+    }
+    else
+    {
+        // 3 color mode, index 3 is transparent black.
+        palette[2] = (p0 + p1) * 0.5f;
+        numColors = 3;
+    }
+
+    float totalError = 0.0f;
+    outIndices = 0;
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        uint32_t bestIndex = 0;
+
+        if (transparent != nullptr && transparent[i])
+        {
+            bestIndex = 3;
+        }
+        else
+        {
+            float bestError = FLT_MAX;
+
+            for (uint32_t p = 0; p < numColors; ++p)
+            {
+                glm::vec3 d = colors[i] - palette[p];
+                float error = glm::dot(d, d);
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+
+            totalError += bestError;
+        }
+
+        outIndices |= (bestIndex << (2 * i));
+    }
+
+    return totalError;
+}
+
+static void EncodeColorBlock(const uint8_t block[16][4], bool punchThroughAlpha, uint8_t* out)
+{
+    glm::vec3 colors[16];
+    bool opaque[16];
+    bool transparent[16];
+    bool hasTransparent = false;
+    uint32_t numOpaque = 0;
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        colors[i] = glm::vec3(block[i][0], block[i][1], block[i][2]);
+        transparent[i] = punchThroughAlpha && block[i][3] < 128;
+        opaque[i] = !transparent[i];
+        hasTransparent = hasTransparent || transparent[i];
+        numOpaque += opaque[i] ? 1 : 0;
+    }
+
+    uint16_t c0 = 0;
+    uint16_t c1 = 0;
+    uint32_t indices = 0;
+
+    if (numOpaque > 0)
+    {
+        glm::vec3 mean;
+        glm::vec3 axis;
+        ComputePrincipalAxis(&colors[0].x, opaque, 16, 3, &mean.x, &axis.x);
+
+        float minT = 0.0f;
+        float maxT = 0.0f;
+
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            if (opaque[i])
+            {
+                float t = glm::dot(colors[i] - mean, axis);
+                minT = glm::min(minT, t);
+                maxT = glm::max(maxT, t);
+            }
+        }
+
+        c0 = PackRgb565(mean + axis * maxT);
+        c1 = PackRgb565(mean + axis * minT);
+
+        // 4 color mode is selected by c0 > c1, 3 color (with transparency) by c0 <= c1.
+        if ((!hasTransparent && c0 < c1) ||
+            (hasTransparent && c0 > c1))
+        {
+            uint16_t temp = c0;
+            c0 = c1;
+            c1 = temp;
+        }
+
+        float error = FitColorIndices(colors, hasTransparent ? transparent : nullptr, c0, c1, indices);
+
+        // One least squares pass to move the endpoints toward the colors that actually got picked.
+        if (!hasTransparent && c0 != c1)
+        {
+            static const float kWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+            float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+            glm::vec3 ax(0.0f), bx(0.0f);
+
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                float a = kWeights[(indices >> (2 * i)) & 3];
+                float b = 1.0f - a;
+                aa += a * a;
+                bb += b * b;
+                ab += a * b;
+                ax += a * colors[i];
+                bx += b * colors[i];
+            }
+
+            float det = aa * bb - ab * ab;
+
+            if (fabsf(det) > 1e-6f)
+            {
+                uint16_t r0 = PackRgb565((ax * bb - bx * ab) / det);
+                uint16_t r1 = PackRgb565((bx * aa - ax * ab) / det);
+
+                if (r0 < r1)
+                {
+                    uint16_t temp = r0;
+                    r0 = r1;
+                    r1 = temp;
+                }
+
+                uint32_t refinedIndices = 0;
+
+                if (r0 != r1 &&
+                    FitColorIndices(colors, nullptr, r0, r1, refinedIndices) < error)
+                {
+                    c0 = r0;
+                    c1 = r1;
+                    indices = refinedIndices;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Fully transparent block
+        indices = 0xffffffff;
+    }
+
+    out[0] = uint8_t(c0 & 0xff);
+    out[1] = uint8_t(c0 >> 8);
+    out[2] = uint8_t(c1 & 0xff);
+    out[3] = uint8_t(c1 >> 8);
+    out[4] = uint8_t(indices & 0xff);
+    out[5] = uint8_t((indices >> 8) & 0xff);
+    out[6] = uint8_t((indices >> 16) & 0xff);
+    out[7] = uint8_t((indices >> 24) & 0xff);
+}
+
+static void EncodeChannelBlock(const uint8_t block[16][4], uint32_t channel, uint8_t* out)
+{
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        minValue = glm::min(minValue, block[i][channel]);
+        maxValue = glm::max(maxValue, block[i][channel]);
+    }
+
+    // a0 > a1 selects the 8 value interpolation mode.
+    out[0] = maxValue;
+    out[1] = minValue;
+
+    uint64_t bits = 0;
+
+    if (maxValue != minValue)
+    {
+        float palette[8];
+        palette[0] = float(maxValue);
+        palette[1] = float(minValue);
+
+        for (uint32_t p = 2; p < 8; ++p)
+        {
+            palette[p] = ((8 - p) * float(maxValue) + (p - 1) * float(minValue)) / 7.0f;
+        }
+
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            float value = float(block[i][channel]);
+            uint64_t bestIndex = 0;
+            float bestError = FLT_MAX;
+
+            for (uint32_t p = 0; p < 8; ++p)
+            {
+                float error = fabsf(value - palette[p]);
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+
+            bits |= (bestIndex << (3 * i));
+        }
+    }
+
+    for (uint32_t b = 0; b < 6; ++b)
+    {
+        out[2 + b] = uint8_t((bits >> (8 * b)) & 0xff);
+    }
+}
+
+struct BitWriter
+{
+    uint8_t* mData;
+    uint32_t mBitPos = 0;
+
+    void Write(uint32_t value, uint32_t numBits)
+    {
+        for (uint32_t i = 0; i < numBits; ++i)
+        {
+            if (value & (1u << i))
+            {
+                mData[mBitPos >> 3] |= uint8_t(1u << (mBitPos & 7));
+            }
+
+            mBitPos++;
+        }
+    }
+};
+
+static void QuantizeBc7Endpoint(const glm::vec4& endpoint, uint32_t outQuant[4], uint32_t& outPBit)
+{
+    float bestError = FLT_MAX;
+
+    for (uint32_t p = 0; p < 2; ++p)
+    {
+        uint32_t quant[4];
+        float error = 0.0f;
+
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            float v = glm::clamp(endpoint[c], 0.0f, 255.0f);
+            int32_t q = int32_t((v - p) * 0.5f + 0.5f);
+            quant[c] = uint32_t(glm::clamp(q, 0, 127));
+
+            float recon = float((quant[c] << 1) | p);
+            error += (recon - v) * (recon - v);
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            outPBit = p;
+            memcpy(outQuant, quant, sizeof(quant));
+        }
+    }
+}
+
+static void EncodeBc7Mode6Block(const uint8_t block[16][4], uint8_t* out)
+{
+    glm::vec4 pixels[16];
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        pixels[i] = glm::vec4(block[i][0], block[i][1], block[i][2], block[i][3]);
+    }
+
+    glm::vec4 mean;
+    glm::vec4 axis;
+    ComputePrincipalAxis(&pixels[0].x, nullptr, 16, 4, &mean.x, &axis.x);
+
+    float minT = 0.0f;
+    float maxT = 0.0f;
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        float t = glm::dot(pixels[i] - mean, axis);
+        minT = glm::min(minT, t);
+        maxT = glm::max(maxT, t);
+    }
+
+    uint32_t quant[2][4];
+    uint32_t pbits[2];
+    QuantizeBc7Endpoint(mean + axis * minT, quant[0], pbits[0]);
+    QuantizeBc7Endpoint(mean + axis * maxT, quant[1], pbits[1]);
+
+    glm::vec4 e0, e1;
+
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        e0[c] = float((quant[0][c] << 1) | pbits[0]);
+        e1[c] = float((quant[1][c] << 1) | pbits[1]);
+    }
+
+    glm::vec4 palette[16];
+
+    for (uint32_t p = 0; p < 16; ++p)
+    {
+        float w = float(kBc7Weights4[p]);
+        palette[p] = glm::floor(((64.0f - w) * e0 + w * e1 + 32.0f) / 64.0f);
+    }
+
+    uint32_t indices[16];
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        float bestError = FLT_MAX;
+        indices[i] = 0;
+
+        for (uint32_t p = 0; p < 16; ++p)
+        {
+            glm::vec4 d = pixels[i] - palette[p];
+            float error = glm::dot(d, d);
+
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[i] = p;
+            }
+        }
+    }
+
+    // The most significant bit of the first index is implicit 0, so swap the endpoints if needed.
+    if (indices[0] & 0x8)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            uint32_t temp = quant[0][c];
+            quant[0][c] = quant[1][c];
+            quant[1][c] = temp;
+        }
+
+        uint32_t tempP = pbits[0];
+        pbits[0] = pbits[1];
+        pbits[1] = tempP;
+
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            indices[i] = 15 - indices[i];
+        }
+    }
+
+    memset(out, 0, 16);
+    BitWriter writer;
+    writer.mData = out;
+
+    writer.Write(1 << 6, 7); // Mode 6
+
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        writer.Write(quant[0][c], 7);
+        writer.Write(quant[1][c], 7);
+    }
+
+    writer.Write(pbits[0], 1);
+    writer.Write(pbits[1], 1);
+
+    writer.Write(indices[0], 3);
+
+    for (uint32_t i = 1; i < 16; ++i)
+    {
+        writer.Write(indices[i], 4);
+    }
+
+    assert(writer.mBitPos == 128);
+}
+
+bool BC_IsBlockFormat(PixelFormat format)
+{
+    return format == PixelFormat::BC1 ||
+        format == PixelFormat::BC3 ||
+        format == PixelFormat::BC5 ||
+        format == PixelFormat::BC7;
+}
+
+uint32_t BC_GetBlockSize(PixelFormat format)
+{
+    uint32_t size = 0;
+
+    switch (format)
+    {
+    case PixelFormat::BC1: size = 8; break;
+    case PixelFormat::BC3: size = 16; break;
+    case PixelFormat::BC5: size = 16; break;
+    case PixelFormat::BC7: size = 16; break;
+    default: assert(0); break;
+    }
+
+    return size;
+}
+
+uint32_t BC_GetCompressedSize(PixelFormat format, uint32_t width, uint32_t height)
+{
+    uint32_t blocksX = (width + BC_BLOCK_DIM - 1) / BC_BLOCK_DIM;
+    uint32_t blocksY = (height + BC_BLOCK_DIM - 1) / BC_BLOCK_DIM;
+    return blocksX * blocksY * BC_GetBlockSize(format);
+}
+
+void BC_CompressImage(PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outData)
+{
+    assert(BC_IsBlockFormat(format));
+
+    uint32_t blocksX = (width + BC_BLOCK_DIM - 1) / BC_BLOCK_DIM;
+    uint32_t blocksY = (height + BC_BLOCK_DIM - 1) / BC_BLOCK_DIM;
+    uint32_t blockSize = BC_GetBlockSize(format);
+
+    size_t offset = outData.size();
+    outData.resize(offset + size_t(blocksX) * blocksY * blockSize);
+
+    uint8_t block[16][4];
+
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+        for (uint32_t bx = 0; bx < blocksX; ++bx)
+        {
+            LoadBlock(rgba, width, height, bx, by, block);
+            uint8_t* dst = &outData[offset];
+
+            switch (format)
+            {
+            case PixelFormat::BC1:
+                EncodeColorBlock(block, true, dst);
+                break;
+            case PixelFormat::BC3:
+                EncodeChannelBlock(block, 3, dst);
+                EncodeColorBlock(block, false, dst + 8);
+                break;
+            case PixelFormat::BC5:
+                EncodeChannelBlock(block, 0, dst);
+                EncodeChannelBlock(block, 1, dst + 8);
+                break;
+            case PixelFormat::BC7:
+                EncodeBc7Mode6Block(block, dst);
+                break;
+            default:
+                break;
+            }
+
+            offset += blockSize;
+        }
+    }
+}
+
+void BC_DownsampleImage(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outPixels)
+{
+    uint32_t dstWidth = glm::max(width / 2, 1u);
+    uint32_t dstHeight = glm::max(height / 2, 1u);
+    outPixels.resize(dstWidth * dstHeight * 4);
+
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        uint32_t y0 = glm::min(y * 2, height - 1);
+        uint32_t y1 = glm::min(y * 2 + 1, height - 1);
+
+        for (uint32_t x = 0; x < dstWidth; ++x)
+        {
+            uint32_t x0 = glm::min(x * 2, width - 1);
+            uint32_t x1 = glm::min(x * 2 + 1, width - 1);
+
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                uint32_t sum =
+                    rgba[(y0 * width + x0) * 4 + c] +
+                    rgba[(y0 * width + x1) * 4 + c] +
+                    rgba[(y1 * width + x0) * 4 + c] +
+                    rgba[(y1 * width + x1) * 4 + c];
+
+                outPixels[(y * dstWidth + x) * 4 + c] = uint8_t((sum + 2) / 4);
+            }
+        }
+    }
+}
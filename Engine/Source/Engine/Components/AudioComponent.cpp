@@ -48,7 +48,7 @@ AudioComponent::AudioComponent()
 
 AudioComponent::~AudioComponent()
 {
-
+    AudioManager::UntrackComponent(this);
 }
 
 const char* AudioComponent::GetTypeName() const
@@ -96,11 +96,17 @@ void AudioComponent::Create()
 {
     TransformComponent::Create();
     GetWorld()->RegisterComponent(this);
+
+    if (mPlaying)
+    {
+        AudioManager::TrackComponent(this);
+    }
 }
 
 void AudioComponent::Destroy()
 {
     AudioManager::StopComponent(this);
+    AudioManager::UntrackComponent(this);
     GetWorld()->UnregisterComponent(this);
     TransformComponent::Destroy();
 }
@@ -112,6 +118,27 @@ void AudioComponent::Tick(float deltaTime)
     if (mPlaying)
     {
         mPlayTime += deltaTime;
+
+        // A virtual (inaudible) one-shot has to finish on its own since no voice will report it done.
+        SoundWave* soundWave = mSoundWave.Get<SoundWave>();
+        if (!mAudible &&
+            !mLoop &&
+            soundWave != nullptr &&
+            mStartOffset + mPlayTime >= soundWave->GetDuration())
+        {
+            Stop();
+        }
+    }
+}
+
+void AudioComponent::UpdateTransform(bool updateChildren)
+{
+    bool moved = mTransformDirty || (mParent != nullptr && mParent->IsTransformDirty());
+    TransformComponent::UpdateTransform(updateChildren);
+
+    if (moved && mPlaying)
+    {
+        AudioManager::UpdateComponentBounds(this);
     }
 }
 
@@ -175,6 +202,11 @@ float AudioComponent::GetInnerRadius() const
 void AudioComponent::SetOuterRadius(float outerRadius)
 {
     mOuterRadius = outerRadius;
+
+    if (mPlaying)
+    {
+        AudioManager::UpdateComponentBounds(this);
+    }
 }
 
 float AudioComponent::GetOuterRadius() const
@@ -271,11 +303,18 @@ bool AudioComponent::IsAudible() const
 void AudioComponent::Play()
 {
     mPlaying = true;
+
+    // Components that aren't in a world yet are tracked once they are created.
+    if (GetWorld() != nullptr)
+    {
+        AudioManager::TrackComponent(this);
+    }
 }
 
 void AudioComponent::Pause()
 {
     mPlaying = false;
+    AudioManager::UntrackComponent(this);
 }
 
 void AudioComponent::Reset()
@@ -289,6 +328,7 @@ void AudioComponent::Stop()
 {
     mPlaying = false;
     mPlayTime = 0.0f;
+    AudioManager::UntrackComponent(this);
 }
 
 void AudioComponent::NotifyAudible(bool audible)
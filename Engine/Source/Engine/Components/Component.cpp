@@ -3,6 +3,7 @@
 #include "Log.h"
 #include "World.h"
 #include "ObjectRef.h"
+#include "ObjectPool.h"
 
 #include "Components/TransformComponent.h"
 #include "Components/StaticMeshComponent.h"
@@ -34,6 +35,16 @@ Component::~Component()
 
 }
 
+void* Component::operator new(size_t size)
+{
+    return ObjectPool::Alloc(size);
+}
+
+void Component::operator delete(void* object, size_t size)
+{
+    ObjectPool::Free(object, size);
+}
+
 void Component::Create()
 {
 
@@ -1,6 +1,9 @@
 #include "Components/DirectionalLightComponent.h"
+#include "Components/CameraComponent.h"
+#include "CameraFrustum.h"
 #include "Renderer.h"
 #include "Constants.h"
+#include "Maths.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -12,7 +15,14 @@ DirectionalLightComponent::DirectionalLightComponent() :
     mDirection(0, -1, 0)
 {
     mName = "Directional Light";
-    mViewProjectionMatrix = glm::mat4(1);
+    mLightRight = glm::vec3(1.0f, 0.0f, 0.0f);
+    mLightUp = glm::vec3(0.0f, 0.0f, 1.0f);
+
+    for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+    {
+        mCascadeMatrices[i] = glm::mat4(1);
+        mCascadeCenters[i] = glm::vec3(0.0f);
+    }
 }
 
 DirectionalLightComponent::~DirectionalLightComponent()
@@ -45,7 +55,6 @@ void DirectionalLightComponent::Destroy()
 void DirectionalLightComponent::Tick(float deltaTime)
 {
     LightComponent::Tick(deltaTime);
-    GenerateViewProjectionMatrix();
 }
 
 const char* DirectionalLightComponent::GetTypeName() const
@@ -92,21 +101,61 @@ void DirectionalLightComponent::SetDirection(const glm::vec3& dir)
     mDirection = dir;
 }
 
-const glm::mat4& DirectionalLightComponent::GetViewProjectionMatrix() const
+void DirectionalLightComponent::UpdateShadowCascades(CameraComponent* camera)
 {
-    return mViewProjectionMatrix;
-}
+    if (camera == nullptr)
+    {
+        return;
+    }
 
-void DirectionalLightComponent::GenerateViewProjectionMatrix()
-{
-    glm::mat4 view;
-    glm::mat4 proj;
+    glm::vec3 direction = glm::normalize(mDirection);
+    glm::vec3 upVector = fabs(direction.y) > 0.5f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    // Rotation-only light view. Cascade centers are snapped in this space.
+    glm::mat4 lightRotation = glm::lookAtRH(glm::vec3(0.0f), direction, upVector);
+    glm::mat4 invLightRotation = glm::inverse(lightRotation);
+    mLightRight = glm::vec3(lightRotation[0][0], lightRotation[1][0], lightRotation[2][0]);
+    mLightUp = glm::vec3(lightRotation[0][1], lightRotation[1][1], lightRotation[2][1]);
+
+    glm::vec3 camPosition = camera->GetAbsolutePosition();
+    glm::vec3 camForward = camera->GetForwardVector();
+    glm::vec3 camRight = camera->GetRightVector();
+    glm::vec3 camUp = camera->GetUpVector();
+
+    bool ortho = (camera->GetProjectionMode() == ProjectionMode::ORTHOGRAPHIC);
+    float nearDist = 0.0f;
+    float farDist = 0.0f;
+    float tanHalfFovY = 0.0f;
+    float aspect = 1.0f;
+
+    if (ortho)
+    {
+        OrthoSettings settings = camera->GetOrthoSettings();
+        nearDist = settings.mNear;
+        farDist = settings.mFar;
+    }
+    else
+    {
+        PerspectiveSettings settings = camera->GetPerspectiveSettings();
+        nearDist = settings.mNear;
+        farDist = settings.mFar;
+        tanHalfFovY = tanf(DEGREES_TO_RADIANS * settings.mFovY * 0.5f);
+        aspect = settings.mAspectRatio;
+    }
 
-    glm::vec3 cameraPosition = GetWorld()->GetActiveCamera()->GetAbsolutePosition();
+    nearDist = glm::max(nearDist, 0.01f);
+    farDist = glm::clamp(farDist, nearDist + 0.01f, glm::max(SHADOW_DISTANCE, nearDist + 0.01f));
 
-    glm::vec3 upVector = fabs(mDirection.y) > 0.5f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
-    view = glm::lookAtRH(cameraPosition, cameraPosition + mDirection, upVector);
-    proj = glm::orthoRH(-SHADOW_RANGE, SHADOW_RANGE, -SHADOW_RANGE, SHADOW_RANGE, -SHADOW_RANGE_Z, SHADOW_RANGE_Z);
+    // Blend of logarithmic and uniform splits (the "practical" split scheme).
+    for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+    {
+        float p = float(i + 1) / SHADOW_CASCADE_COUNT;
+        float logSplit = nearDist * powf(farDist / nearDist, p);
+        float uniformSplit = nearDist + (farDist - nearDist) * p;
+        mCascadeSplits[i] = glm::mix(uniformSplit, logSplit, SHADOW_CASCADE_SPLIT_LAMBDA);
+    }
+
+    const float texelScale = 2.0f / SHADOW_CASCADE_RESOLUTION;
 
     // Needed for adjusting to NDC
     const glm::mat4 clip(1.0f, 0.0f, 0.0f, 0.0f,
@@ -114,5 +163,73 @@ void DirectionalLightComponent::GenerateViewProjectionMatrix()
         0.0f, 0.0f, 1.0f, 0.0f,
         0.0f, 0.0f, 0.0f, 1.0f);
 
-    mViewProjectionMatrix = clip * proj * view;
+    for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+    {
+        float sliceNear = (i == 0) ? nearDist : mCascadeSplits[i - 1];
+        float sliceFar = mCascadeSplits[i];
+
+        // Bounding sphere of the slice. Its radius doesn't change when the camera rotates,
+        // so the projection size stays fixed and the shadow edges don't swim.
+        glm::vec3 corners[8];
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            float dist = (c < 4) ? sliceNear : sliceFar;
+            float halfHeight = ortho ? camera->GetOrthoSettings().mHeight : dist * tanHalfFovY;
+            float halfWidth = ortho ? camera->GetOrthoSettings().mWidth : halfHeight * aspect;
+            float sx = (c & 1) ? 1.0f : -1.0f;
+            float sy = (c & 2) ? 1.0f : -1.0f;
+            corners[c] = camPosition + camForward * dist + camRight * (sx * halfWidth) + camUp * (sy * halfHeight);
+        }
+
+        glm::vec3 center = glm::vec3(0.0f);
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            center += corners[c];
+        }
+        center /= 8.0f;
+
+        float radius = 0.0f;
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            radius = glm::max(radius, glm::length(corners[c] - center));
+        }
+        radius = ceilf(radius * 16.0f) / 16.0f;
+
+        // Snap the center to whole shadow map texels so that moving the camera doesn't shimmer.
+        float texelSize = radius * texelScale;
+        glm::vec3 lightSpaceCenter = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+        lightSpaceCenter.x = floorf(lightSpaceCenter.x / texelSize) * texelSize;
+        lightSpaceCenter.y = floorf(lightSpaceCenter.y / texelSize) * texelSize;
+        center = glm::vec3(invLightRotation * glm::vec4(lightSpaceCenter, 1.0f));
+
+        // Casters between the light and the slice still need to be in the depth range.
+        glm::mat4 view = glm::lookAtRH(center, center + direction, upVector);
+        glm::mat4 proj = glm::orthoRH(-radius, radius, -radius, radius, -SHADOW_RANGE_Z, radius);
+
+        mCascadeMatrices[i] = clip * proj * view;
+        mCascadeCenters[i] = center;
+        mCascadeRadii[i] = radius;
+    }
+}
+
+const glm::mat4& DirectionalLightComponent::GetCascadeViewProjectionMatrix(uint32_t cascade) const
+{
+    assert(cascade < SHADOW_CASCADE_COUNT);
+    return mCascadeMatrices[cascade];
+}
+
+float DirectionalLightComponent::GetCascadeSplit(uint32_t cascade) const
+{
+    assert(cascade < SHADOW_CASCADE_COUNT);
+    return mCascadeSplits[cascade];
+}
+
+void DirectionalLightComponent::GetCascadeFrustum(uint32_t cascade, CameraFrustum& outFrustum) const
+{
+    assert(cascade < SHADOW_CASCADE_COUNT);
+    float radius = mCascadeRadii[cascade];
+
+    outFrustum.SetPosition(mCascadeCenters[cascade]);
+    outFrustum.SetBasis(glm::normalize(mDirection), mLightUp, mLightRight);
+    outFrustum.SetOrthographic(radius, radius, -SHADOW_RANGE_Z, radius);
 }
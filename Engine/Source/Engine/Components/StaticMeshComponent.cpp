@@ -143,6 +143,16 @@ bool StaticMeshComponent::GetUseTriangleCollision() const
     return mUseTriangleCollision;
 }
 
+void StaticMeshComponent::SetLod(uint32_t lod)
+{
+    mLod = lod;
+}
+
+uint32_t StaticMeshComponent::GetLod() const
+{
+    return mLod;
+}
+
 Material* StaticMeshComponent::GetMaterial()
 {
     Material* mat = mMaterialOverride.Get<Material>();
@@ -12,6 +12,7 @@
 #include "Constants.h"
 #include "Utilities.h"
 #include "Profiler.h"
+#include "ObjectPool.h"
 #include "Maths.h"
 #include "ScriptAutoReg.h"
 #include "Components/ScriptComponent.h"
@@ -110,6 +111,13 @@ void ReadCommandLineArgs(int32_t argc, char** argv)
             gCommandLineOptions.mDefaultLevel = argv[i + 1];
             ++i;
         }
+
+        if (strcmp(argv[i], "-cook") == 0)
+        {
+            assert(i + 1 < argc);
+            gCommandLineOptions.mCookPlatform = argv[i + 1];
+            ++i;
+        }
     }
 }
 
@@ -285,6 +293,8 @@ void Shutdown()
     delete sWorld;
     sWorld = nullptr;
 
+    ObjectPool::Shutdown();
+
     NetworkManager::Destroy();
     Renderer::Destroy();
     AssetManager::Destroy();
@@ -0,0 +1,738 @@
+#include "MeshOptimizer.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+static const float kCacheDecayPower = 1.5f;
+static const float kLastTriScore = 0.75f;
+static const float kValenceBoostScale = 2.0f;
+static const float kValenceBoostPower = 0.5f;
+
+static float ComputeVertexScore(int32_t cachePos, uint32_t numActiveTris)
+{
+    if (numActiveTris == 0)
+    {
+        // No triangles left that use this vertex.
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+
+    if (cachePos >= 0)
+    {
+        if (cachePos < 3)
+        {
+            // Vertices of the triangle that was just emitted get a fixed score so that
+            // the next triangle doesn't always prefer strip-like order.
+            score = kLastTriScore;
+        }
+        else
+        {
+            const float scaler = 1.0f / (MESH_OPT_CACHE_SIZE - 3);
+            score = 1.0f - (cachePos - 3) * scaler;
+            score = powf(score, kCacheDecayPower);
+        }
+    }
+
+    // Boost vertices with few triangles left so that we get rid of lone triangles early.
+    score += kValenceBoostScale * powf((float)numActiveTris, -kValenceBoostPower);
+
+    return score;
+}
+
+float MeshOpt_ComputeAcmr(const IndexType* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize)
+{
+    if (numIndices < 3)
+        return 0.0f;
+
+    // FIFO cache simulated with timestamps. A vertex is in the cache if it was
+    // pushed less than cacheSize misses ago.
+    std::vector<uint32_t> cacheTime(numVertices, 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t misses = 0;
+
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        IndexType v = indices[i];
+        assert(v < numVertices);
+
+        if (time - cacheTime[v] > cacheSize)
+        {
+            cacheTime[v] = time;
+            ++time;
+            ++misses;
+        }
+    }
+
+    return float(misses) / float(numIndices / 3);
+}
+
+void MeshOpt_OptimizeVertexCache(IndexType* indices, uint32_t numIndices, uint32_t numVertices)
+{
+    const uint32_t numTris = numIndices / 3;
+
+    if (numTris == 0 || numVertices == 0)
+        return;
+
+    // Build vertex -> triangle adjacency
+    std::vector<uint32_t> numActiveTris(numVertices, 0);
+    std::vector<uint32_t> adjOffsets(numVertices + 1, 0);
+
+    for (uint32_t i = 0; i < numTris * 3; ++i)
+    {
+        numActiveTris[indices[i]]++;
+    }
+
+    for (uint32_t v = 0; v < numVertices; ++v)
+    {
+        adjOffsets[v + 1] = adjOffsets[v] + numActiveTris[v];
+    }
+
+    std::vector<uint32_t> adjTris(numTris * 3);
+    std::vector<uint32_t> adjFill(adjOffsets.begin(), adjOffsets.end() - 1);
+
+    for (uint32_t t = 0; t < numTris; ++t)
+    {
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            IndexType v = indices[t * 3 + c];
+            adjTris[adjFill[v]++] = t;
+        }
+    }
+
+    std::vector<int32_t> cachePos(numVertices, -1);
+    std::vector<float> vertScores(numVertices);
+    std::vector<float> triScores(numTris, 0.0f);
+    std::vector<bool> triEmitted(numTris, false);
+
+    for (uint32_t v = 0; v < numVertices; ++v)
+    {
+        vertScores[v] = ComputeVertexScore(-1, numActiveTris[v]);
+    }
+
+    int32_t bestTri = -1;
+    float bestScore = -1.0f;
+
+    for (uint32_t t = 0; t < numTris; ++t)
+    {
+        triScores[t] = vertScores[indices[t * 3 + 0]] + vertScores[indices[t * 3 + 1]] + vertScores[indices[t * 3 + 2]];
+
+        if (triScores[t] > bestScore)
+        {
+            bestScore = triScores[t];
+            bestTri = (int32_t)t;
+        }
+    }
+
+    // The cache has room for the 3 vertices of the new triangle before older entries are pushed out.
+    uint32_t cache[MESH_OPT_CACHE_SIZE + 3];
+    uint32_t cacheCount = 0;
+
+    std::vector<IndexType> outIndices(numTris * 3);
+    uint32_t numEmitted = 0;
+    uint32_t fallbackCursor = 0;
+
+    while (numEmitted < numTris)
+    {
+        if (bestTri < 0)
+        {
+            // Nothing in the cache touches an unemitted triangle, so just take the next one in order.
+            while (triEmitted[fallbackCursor])
+            {
+                ++fallbackCursor;
+            }
+
+            bestTri = (int32_t)fallbackCursor;
+        }
+
+        const uint32_t tri = (uint32_t)bestTri;
+        const IndexType* triVerts = &indices[tri * 3];
+
+        outIndices[numEmitted * 3 + 0] = triVerts[0];
+        outIndices[numEmitted * 3 + 1] = triVerts[1];
+        outIndices[numEmitted * 3 + 2] = triVerts[2];
+        triEmitted[tri] = true;
+        ++numEmitted;
+
+        // Remove the triangle from the active lists of its vertices.
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            IndexType v = triVerts[c];
+            uint32_t* adj = &adjTris[adjOffsets[v]];
+            uint32_t count = numActiveTris[v];
+
+            for (uint32_t a = 0; a < count; ++a)
+            {
+                if (adj[a] == tri)
+                {
+                    adj[a] = adj[count - 1];
+                    break;
+                }
+            }
+
+            numActiveTris[v]--;
+        }
+
+        // Push the triangle's vertices to the front of the cache.
+        uint32_t newCache[MESH_OPT_CACHE_SIZE + 3];
+        uint32_t newCount = 0;
+
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            newCache[newCount++] = triVerts[c];
+        }
+
+        for (uint32_t i = 0; i < cacheCount; ++i)
+        {
+            uint32_t v = cache[i];
+
+            if (v != triVerts[0] && v != triVerts[1] && v != triVerts[2])
+            {
+                newCache[newCount++] = v;
+            }
+        }
+
+        // Anything past the cache size fell out, so rescore it as uncached.
+        for (uint32_t i = MESH_OPT_CACHE_SIZE; i < newCount; ++i)
+        {
+            cachePos[newCache[i]] = -1;
+            vertScores[newCache[i]] = ComputeVertexScore(-1, numActiveTris[newCache[i]]);
+        }
+
+        cacheCount = std::min<uint32_t>(newCount, MESH_OPT_CACHE_SIZE);
+        memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+
+        for (uint32_t i = 0; i < cacheCount; ++i)
+        {
+            cachePos[cache[i]] = (int32_t)i;
+            vertScores[cache[i]] = ComputeVertexScore((int32_t)i, numActiveTris[cache[i]]);
+        }
+
+        // Rescore triangles that touch the cache and pick the best one for the next iteration.
+        bestTri = -1;
+        bestScore = -1.0f;
+
+        for (uint32_t i = 0; i < cacheCount; ++i)
+        {
+            uint32_t v = cache[i];
+            const uint32_t* adj = &adjTris[adjOffsets[v]];
+
+            for (uint32_t a = 0; a < numActiveTris[v]; ++a)
+            {
+                uint32_t t = adj[a];
+                float score = vertScores[indices[t * 3 + 0]] + vertScores[indices[t * 3 + 1]] + vertScores[indices[t * 3 + 2]];
+                triScores[t] = score;
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTri = (int32_t)t;
+                }
+            }
+        }
+    }
+
+    memcpy(indices, outIndices.data(), sizeof(IndexType) * numTris * 3);
+}
+
+void MeshOpt_OptimizeOverdraw(IndexType* indices, uint32_t numIndices, const uint8_t* positions, uint32_t positionStride, uint32_t numVertices)
+{
+    const uint32_t numTris = numIndices / 3;
+
+    if (numTris < 2)
+        return;
+
+    auto getPos = [&](IndexType v) -> glm::vec3
+    {
+        glm::vec3 pos;
+        memcpy(&pos, positions + size_t(v) * positionStride, sizeof(glm::vec3));
+        return pos;
+    };
+
+    const float meshAcmr = MeshOpt_ComputeAcmr(indices, numIndices, numVertices);
+    const float clusterAcmrLimit = meshAcmr * MESH_OPT_OVERDRAW_THRESHOLD;
+
+    // Split the (already cache optimized) triangle order into clusters. A cluster always ends when
+    // the cache effectively restarts (all 3 vertices miss), and may end early wherever a triangle
+    // starts missing again as long as the cluster so far is at least as good as the whole mesh.
+    std::vector<uint32_t> clusterStarts;
+    clusterStarts.push_back(0);
+
+    {
+        std::vector<uint32_t> cacheTime(numVertices, 0);
+        uint32_t time = MESH_OPT_ACMR_CACHE_SIZE + 1;
+        uint32_t clusterMisses = 0;
+        uint32_t clusterTris = 0;
+
+        for (uint32_t t = 0; t < numTris; ++t)
+        {
+            uint32_t misses = 0;
+
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                IndexType v = indices[t * 3 + c];
+
+                if (time - cacheTime[v] > MESH_OPT_ACMR_CACHE_SIZE)
+                {
+                    cacheTime[v] = time;
+                    ++time;
+                    ++misses;
+                }
+            }
+
+            if (clusterTris > 0)
+            {
+                bool hardBoundary = (misses == 3);
+                bool softBoundary = (misses >= 2) && (float(clusterMisses) / clusterTris <= clusterAcmrLimit);
+
+                if (hardBoundary || softBoundary)
+                {
+                    clusterStarts.push_back(t);
+                    clusterMisses = 0;
+                    clusterTris = 0;
+                }
+            }
+
+            clusterMisses += misses;
+            clusterTris++;
+        }
+    }
+
+    const uint32_t numClusters = (uint32_t)clusterStarts.size();
+
+    if (numClusters < 2)
+        return;
+
+    clusterStarts.push_back(numTris);
+
+    // Area-weighted centroid and average normal of each cluster
+    std::vector<glm::vec3> clusterCentroids(numClusters);
+    std::vector<glm::vec3> clusterNormals(numClusters);
+    glm::vec3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+
+    for (uint32_t c = 0; c < numClusters; ++c)
+    {
+        glm::vec3 centroid = { 0.0f, 0.0f, 0.0f };
+        glm::vec3 normal = { 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+
+        for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+        {
+            glm::vec3 p0 = getPos(indices[t * 3 + 0]);
+            glm::vec3 p1 = getPos(indices[t * 3 + 1]);
+            glm::vec3 p2 = getPos(indices[t * 3 + 2]);
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float triArea = glm::length(n);
+
+            centroid += (p0 + p1 + p2) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+
+        clusterCentroids[c] = (area > 0.0f) ? (centroid / area) : getPos(indices[clusterStarts[c] * 3]);
+        float normalLength = glm::length(normal);
+        clusterNormals[c] = (normalLength > 0.0f) ? (normal / normalLength) : glm::vec3(0.0f);
+    }
+
+    if (meshArea > 0.0f)
+    {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters that face away from the center of the mesh are more likely to occlude the rest of it,
+    // so draw them first.
+    std::vector<float> sortKeys(numClusters);
+    std::vector<uint32_t> clusterOrder(numClusters);
+
+    for (uint32_t c = 0; c < numClusters; ++c)
+    {
+        sortKeys[c] = glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]);
+        clusterOrder[c] = c;
+    }
+
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](uint32_t a, uint32_t b)
+    {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<IndexType> outIndices;
+    outIndices.reserve(numTris * 3);
+
+    for (uint32_t i = 0; i < numClusters; ++i)
+    {
+        uint32_t c = clusterOrder[i];
+        outIndices.insert(outIndices.end(), indices + clusterStarts[c] * 3, indices + clusterStarts[c + 1] * 3);
+    }
+
+    memcpy(indices, outIndices.data(), sizeof(IndexType) * numTris * 3);
+}
+
+uint32_t MeshOpt_OptimizeVertexFetch(uint8_t* vertices, uint32_t vertexSize, uint32_t numVertices, IndexType* indices, uint32_t numIndices)
+{
+    const uint32_t kUnused = 0xffffffff;
+    std::vector<uint32_t> remap(numVertices, kUnused);
+    std::vector<uint8_t> newVertices(size_t(numVertices) * vertexSize);
+    uint32_t nextVertex = 0;
+
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        IndexType v = indices[i];
+        assert(v < numVertices);
+
+        if (remap[v] == kUnused)
+        {
+            remap[v] = nextVertex;
+            memcpy(&newVertices[size_t(nextVertex) * vertexSize], vertices + size_t(v) * vertexSize, vertexSize);
+            ++nextVertex;
+        }
+
+        indices[i] = (IndexType)remap[v];
+    }
+
+    memcpy(vertices, newVertices.data(), size_t(nextVertex) * vertexSize);
+
+    return nextVertex;
+}
+
+uint32_t MeshOpt_OptimizeMesh(
+    uint8_t* vertices,
+    uint32_t vertexSize,
+    uint32_t positionOffset,
+    uint32_t numVertices,
+    IndexType* indices,
+    uint32_t numIndices,
+    MeshOptimizeStats* outStats)
+{
+    float acmrBefore = MeshOpt_ComputeAcmr(indices, numIndices, numVertices);
+
+    MeshOpt_OptimizeVertexCache(indices, numIndices, numVertices);
+    MeshOpt_OptimizeOverdraw(indices, numIndices, vertices + positionOffset, vertexSize, numVertices);
+    uint32_t newNumVertices = MeshOpt_OptimizeVertexFetch(vertices, vertexSize, numVertices, indices, numIndices);
+
+    if (outStats != nullptr)
+    {
+        outStats->mAcmrBefore = acmrBefore;
+        outStats->mAcmrAfter = MeshOpt_ComputeAcmr(indices, numIndices, newNumVertices);
+    }
+
+    return newNumVertices;
+}
+
+struct Quadric
+{
+    // Symmetric 4x4 matrix, upper triangle only.
+    double mA00 = 0.0, mA01 = 0.0, mA02 = 0.0, mA03 = 0.0;
+    double mA11 = 0.0, mA12 = 0.0, mA13 = 0.0;
+    double mA22 = 0.0, mA23 = 0.0;
+    double mA33 = 0.0;
+
+    void AddPlane(const glm::vec3& n, float d, float weight)
+    {
+        mA00 += weight * n.x * n.x; mA01 += weight * n.x * n.y; mA02 += weight * n.x * n.z; mA03 += weight * n.x * d;
+        mA11 += weight * n.y * n.y; mA12 += weight * n.y * n.z; mA13 += weight * n.y * d;
+        mA22 += weight * n.z * n.z; mA23 += weight * n.z * d;
+        mA33 += weight * d * d;
+    }
+
+    void Add(const Quadric& q)
+    {
+        mA00 += q.mA00; mA01 += q.mA01; mA02 += q.mA02; mA03 += q.mA03;
+        mA11 += q.mA11; mA12 += q.mA12; mA13 += q.mA13;
+        mA22 += q.mA22; mA23 += q.mA23;
+        mA33 += q.mA33;
+    }
+
+    double Eval(const glm::vec3& p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        return x * x * mA00 + 2.0 * x * y * mA01 + 2.0 * x * z * mA02 + 2.0 * x * mA03 +
+            y * y * mA11 + 2.0 * y * z * mA12 + 2.0 * y * mA13 +
+            z * z * mA22 + 2.0 * z * mA23 +
+            mA33;
+    }
+};
+
+struct PositionHash
+{
+    size_t operator()(const glm::vec3& p) const
+    {
+        uint32_t bits[3];
+        memcpy(bits, &p, sizeof(bits));
+        return size_t(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+    }
+};
+
+struct CollapseCandidate
+{
+    uint32_t mSrc;
+    uint32_t mDst;
+    double mCost;
+};
+
+static uint64_t MakeEdgeKey(uint32_t a, uint32_t b)
+{
+    return (a < b) ? ((uint64_t(a) << 32) | b) : ((uint64_t(b) << 32) | a);
+}
+
+uint32_t MeshOpt_Simplify(IndexType* indices, uint32_t numIndices, const uint8_t* positions, uint32_t positionStride, uint32_t numVertices, uint32_t targetIndexCount)
+{
+    const uint32_t kMaxPasses = 64;
+
+    if (numIndices <= targetIndexCount || numVertices == 0)
+        return numIndices;
+
+    std::vector<glm::vec3> pos(numVertices);
+
+    for (uint32_t v = 0; v < numVertices; ++v)
+    {
+        memcpy(&pos[v], positions + size_t(v) * positionStride, sizeof(glm::vec3));
+    }
+
+    // Weld vertices by position so that topology (borders, quadrics) ignores attribute splits.
+    std::vector<uint32_t> wedge(numVertices);
+    std::vector<uint32_t> numCopies(numVertices, 0);
+
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> positionMap;
+        positionMap.reserve(numVertices);
+
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            auto it = positionMap.emplace(pos[v], v).first;
+            wedge[v] = it->second;
+            numCopies[wedge[v]]++;
+        }
+    }
+
+    // Edges that only belong to one triangle are on an open border.
+    std::vector<bool> locked(numVertices, false);
+
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        edgeCounts.reserve(numIndices);
+
+        for (uint32_t t = 0; t < numIndices / 3; ++t)
+        {
+            for (uint32_t e = 0; e < 3; ++e)
+            {
+                uint32_t a = wedge[indices[t * 3 + e]];
+                uint32_t b = wedge[indices[t * 3 + (e + 1) % 3]];
+                edgeCounts[MakeEdgeKey(a, b)]++;
+            }
+        }
+
+        std::vector<bool> border(numVertices, false);
+
+        for (auto& pair : edgeCounts)
+        {
+            if (pair.second == 1)
+            {
+                border[uint32_t(pair.first >> 32)] = true;
+                border[uint32_t(pair.first & 0xffffffff)] = true;
+            }
+        }
+
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            locked[v] = border[wedge[v]] || numCopies[wedge[v]] > 1;
+        }
+    }
+
+    std::vector<Quadric> quadrics(numVertices);
+
+    for (uint32_t t = 0; t < numIndices / 3; ++t)
+    {
+        const glm::vec3& p0 = pos[indices[t * 3 + 0]];
+        const glm::vec3& p1 = pos[indices[t * 3 + 1]];
+        const glm::vec3& p2 = pos[indices[t * 3 + 2]];
+
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float area = glm::length(n);
+
+        if (area <= 0.0f)
+            continue;
+
+        n /= area;
+        float d = -glm::dot(n, p0);
+
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            quadrics[wedge[indices[t * 3 + c]]].AddPlane(n, d, area);
+        }
+    }
+
+    std::vector<IndexType> cur(indices, indices + numIndices);
+    std::vector<uint32_t> collapseTo(numVertices);
+    std::vector<bool> touched(numVertices);
+    std::vector<uint32_t> adjOffsets(numVertices + 1);
+    std::vector<uint32_t> adjTris;
+    std::vector<CollapseCandidate> candidates;
+
+    for (uint32_t pass = 0; pass < kMaxPasses && cur.size() > targetIndexCount; ++pass)
+    {
+        const uint32_t numTris = uint32_t(cur.size() / 3);
+
+        // Vertex -> triangle adjacency for the current triangles
+        std::fill(adjOffsets.begin(), adjOffsets.end(), 0);
+
+        for (uint32_t i = 0; i < numTris * 3; ++i)
+        {
+            adjOffsets[cur[i] + 1]++;
+        }
+
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            adjOffsets[v + 1] += adjOffsets[v];
+        }
+
+        adjTris.resize(numTris * 3);
+        std::vector<uint32_t> adjFill(adjOffsets.begin(), adjOffsets.end() - 1);
+
+        for (uint32_t t = 0; t < numTris; ++t)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                adjTris[adjFill[cur[t * 3 + c]]++] = t;
+            }
+        }
+
+        candidates.clear();
+
+        for (uint32_t t = 0; t < numTris; ++t)
+        {
+            for (uint32_t e = 0; e < 3; ++e)
+            {
+                uint32_t a = cur[t * 3 + e];
+                uint32_t b = cur[t * 3 + (e + 1) % 3];
+
+                Quadric q = quadrics[wedge[a]];
+                q.Add(quadrics[wedge[b]]);
+
+                if (!locked[a])
+                {
+                    candidates.push_back({ a, b, q.Eval(pos[b]) });
+                }
+
+                if (!locked[b])
+                {
+                    candidates.push_back({ b, a, q.Eval(pos[a]) });
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const CollapseCandidate& l, const CollapseCandidate& r)
+        {
+            return l.mCost < r.mCost;
+        });
+
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            collapseTo[v] = v;
+        }
+
+        std::fill(touched.begin(), touched.end(), false);
+
+        const uint32_t trisToRemove = numTris - targetIndexCount / 3;
+        uint32_t trisRemoved = 0;
+        uint32_t numCollapses = 0;
+
+        for (const CollapseCandidate& cand : candidates)
+        {
+            if (touched[cand.mSrc] || touched[cand.mDst])
+                continue;
+
+            // Reject the collapse if it would flip any of the triangles around the source vertex.
+            bool flips = false;
+            uint32_t collapsedTris = 0;
+
+            for (uint32_t a = adjOffsets[cand.mSrc]; a < adjOffsets[cand.mSrc + 1]; ++a)
+            {
+                const IndexType* tri = &cur[adjTris[a] * 3];
+
+                if (tri[0] == cand.mDst || tri[1] == cand.mDst || tri[2] == cand.mDst)
+                {
+                    collapsedTris++;
+                    continue;
+                }
+
+                glm::vec3 p[3] = { pos[tri[0]], pos[tri[1]], pos[tri[2]] };
+                glm::vec3 oldNormal = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    if (tri[c] == cand.mSrc)
+                    {
+                        p[c] = pos[cand.mDst];
+                    }
+                }
+
+                glm::vec3 newNormal = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+                if (glm::dot(oldNormal, newNormal) <= 0.0f)
+                {
+                    flips = true;
+                    break;
+                }
+            }
+
+            if (flips)
+                continue;
+
+            collapseTo[cand.mSrc] = cand.mDst;
+            quadrics[wedge[cand.mDst]].Add(quadrics[wedge[cand.mSrc]]);
+
+            // Freeze the whole ring around the source so the flip checks above stay valid for this pass.
+            for (uint32_t a = adjOffsets[cand.mSrc]; a < adjOffsets[cand.mSrc + 1]; ++a)
+            {
+                const IndexType* tri = &cur[adjTris[a] * 3];
+                touched[tri[0]] = true;
+                touched[tri[1]] = true;
+                touched[tri[2]] = true;
+            }
+
+            touched[cand.mDst] = true;
+            trisRemoved += collapsedTris;
+            numCollapses++;
+
+            if (trisRemoved >= trisToRemove)
+                break;
+        }
+
+        if (numCollapses == 0)
+            break;
+
+        // Rewrite the triangles and drop the ones that became degenerate.
+        uint32_t numOut = 0;
+
+        for (uint32_t t = 0; t < numTris; ++t)
+        {
+            IndexType i0 = (IndexType)collapseTo[cur[t * 3 + 0]];
+            IndexType i1 = (IndexType)collapseTo[cur[t * 3 + 1]];
+            IndexType i2 = (IndexType)collapseTo[cur[t * 3 + 2]];
+
+            if (i0 != i1 && i1 != i2 && i0 != i2)
+            {
+                cur[numOut++] = i0;
+                cur[numOut++] = i1;
+                cur[numOut++] = i2;
+            }
+        }
+
+        cur.resize(numOut);
+    }
+
+    memcpy(indices, cur.data(), sizeof(IndexType) * cur.size());
+
+    return uint32_t(cur.size());
+}
@@ -0,0 +1,147 @@
+#include "ObjectPool.h"
+#include "Profiler.h"
+#include "Log.h"
+
+#include "System/System.h"
+
+#include <vector>
+#include <unordered_map>
+#include <assert.h>
+
+struct PoolBlock
+{
+    PoolBlock* mNext = nullptr;
+};
+
+struct SizePool
+{
+    PoolBlock* mFreeList = nullptr;
+    std::vector<void*> mSlabs;
+    uint32_t mNumBlocks = 0;
+    uint32_t mNumFree = 0;
+};
+
+static std::unordered_map<uint32_t, SizePool> sPools;
+static uint32_t sNumLiveObjects = 0;
+
+static uint32_t GetSizeClass(size_t size)
+{
+    uint32_t sizeClass = (uint32_t(size) + (OBJECT_POOL_ALIGNMENT - 1)) & ~uint32_t(OBJECT_POOL_ALIGNMENT - 1);
+    return (sizeClass < sizeof(PoolBlock)) ? uint32_t(sizeof(PoolBlock)) : sizeClass;
+}
+
+static void AllocateSlab(SizePool& pool, uint32_t sizeClass)
+{
+    uint8_t* slab = (uint8_t*)SYS_AlignedMalloc(sizeClass * OBJECT_POOL_SLAB_OBJECTS, OBJECT_POOL_ALIGNMENT);
+    pool.mSlabs.push_back(slab);
+
+    // Link the new blocks in address order so consecutive spawns are adjacent in memory.
+    for (int32_t i = OBJECT_POOL_SLAB_OBJECTS - 1; i >= 0; --i)
+    {
+        PoolBlock* block = (PoolBlock*)(slab + i * sizeClass);
+        block->mNext = pool.mFreeList;
+        pool.mFreeList = block;
+    }
+
+    pool.mNumBlocks += OBJECT_POOL_SLAB_OBJECTS;
+    pool.mNumFree += OBJECT_POOL_SLAB_OBJECTS;
+}
+
+void* ObjectPool::Alloc(size_t size)
+{
+    uint32_t sizeClass = GetSizeClass(size);
+    SizePool& pool = sPools[sizeClass];
+    bool poolMiss = false;
+
+    if (pool.mFreeList == nullptr)
+    {
+        AllocateSlab(pool, sizeClass);
+        poolMiss = true;
+    }
+
+    PoolBlock* block = pool.mFreeList;
+    pool.mFreeList = block->mNext;
+    pool.mNumFree--;
+    sNumLiveObjects++;
+
+    if (GetProfiler() != nullptr)
+    {
+        GetProfiler()->RecordObjectAlloc(poolMiss);
+    }
+
+    return block;
+}
+
+void ObjectPool::Free(void* object, size_t size)
+{
+    if (object == nullptr)
+        return;
+
+    uint32_t sizeClass = GetSizeClass(size);
+    auto it = sPools.find(sizeClass);
+    assert(it != sPools.end());
+
+    if (it != sPools.end())
+    {
+        SizePool& pool = it->second;
+        PoolBlock* block = (PoolBlock*)object;
+        block->mNext = pool.mFreeList;
+        pool.mFreeList = block;
+        pool.mNumFree++;
+        sNumLiveObjects--;
+
+        if (GetProfiler() != nullptr)
+        {
+            GetProfiler()->RecordObjectFree();
+        }
+    }
+}
+
+void ObjectPool::Prewarm(size_t size, uint32_t count)
+{
+    if (size == 0)
+        return;
+
+    uint32_t sizeClass = GetSizeClass(size);
+    SizePool& pool = sPools[sizeClass];
+
+    while (pool.mNumFree < count)
+    {
+        AllocateSlab(pool, sizeClass);
+    }
+}
+
+void ObjectPool::Shutdown()
+{
+    for (auto& it : sPools)
+    {
+        SizePool& pool = it.second;
+
+        if (pool.mNumFree == pool.mNumBlocks)
+        {
+            for (uint32_t i = 0; i < pool.mSlabs.size(); ++i)
+            {
+                SYS_AlignedFree(pool.mSlabs[i]);
+            }
+        }
+        else
+        {
+            // Something still points into these slabs. Leak them rather than free live objects.
+            LogWarning("ObjectPool: %d objects of size %d still alive at shutdown", pool.mNumBlocks - pool.mNumFree, it.first);
+        }
+    }
+
+    sPools.clear();
+    sNumLiveObjects = 0;
+}
+
+uint32_t ObjectPool::GetNumFreeObjects(size_t size)
+{
+    auto it = sPools.find(GetSizeClass(size));
+    return (it != sPools.end()) ? it->second.mNumFree : 0;
+}
+
+uint32_t ObjectPool::GetNumLiveObjects()
+{
+    return sNumLiveObjects;
+}
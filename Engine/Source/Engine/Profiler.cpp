@@ -3,6 +3,7 @@
 #include "System/System.h"
 #include "Maths.h"
 #include "Clock.h"
+#include "Graphics/Graphics.h"
 
 #include <assert.h>
 
@@ -18,6 +19,16 @@ void Profiler::BeginFrame()
         mCpuStats[i].mStartTime = 0;
         mCpuStats[i].mEndTime = 0;
     }
+
+    // GPU times are added back in by the backend's GFX_BeginFrame()
+    for (uint32_t i = 0; i < mGpuStats.size(); ++i)
+    {
+        mGpuStats[i].mTime = 0.0f;
+    }
+
+    // Keep the last full frame's allocation counts around for display
+    mAllocStats = mFrameAllocStats;
+    mFrameAllocStats = AllocStats();
 #endif
 }
 
@@ -31,6 +42,11 @@ void Profiler::EndFrame()
     {
         mCpuStats[i].mSmoothedTime = Maths::Damp(mCpuStats[i].mSmoothedTime, mCpuStats[i].mTime, 0.05f, deltaTime);
     }
+
+    for (uint32_t i = 0; i < mGpuStats.size(); ++i)
+    {
+        mGpuStats[i].mSmoothedTime = Maths::Damp(mGpuStats[i].mSmoothedTime, mGpuStats[i].mTime, 0.05f, deltaTime);
+    }
 #endif
 }
 
@@ -87,6 +103,84 @@ const std::vector<CpuStat>& Profiler::GetCpuStats() const
     return mCpuStats;
 }
 
+void Profiler::BeginGpuStat(const char* name)
+{
+#if PROFILING_ENABLED
+    GFX_BeginGpuStat(name);
+#endif
+}
+
+void Profiler::EndGpuStat()
+{
+#if PROFILING_ENABLED
+    GFX_EndGpuStat();
+#endif
+}
+
+void Profiler::AddGpuStatTime(const char* name, float time)
+{
+#if PROFILING_ENABLED
+    GpuStat* stat = FindGpuStat(name);
+
+    if (stat == nullptr)
+    {
+        GpuStat newStat;
+        strncpy(newStat.mName, name, STAT_NAME_LENGTH);
+        mGpuStats.push_back(newStat);
+        stat = &mGpuStats.back();
+    }
+
+    // A scope can run more than once per frame (e.g. once per view), so the times are summed.
+    stat->mTime += time;
+#endif
+}
+
+GpuStat* Profiler::FindGpuStat(const char* name)
+{
+    GpuStat* retStat = nullptr;
+
+#if PROFILING_ENABLED
+    for (uint32_t i = 0; i < mGpuStats.size(); ++i)
+    {
+        if (strncmp(mGpuStats[i].mName, name, STAT_NAME_LENGTH) == 0)
+        {
+            retStat = &mGpuStats[i];
+        }
+    }
+#endif
+
+    return retStat;
+}
+
+const std::vector<GpuStat>& Profiler::GetGpuStats() const
+{
+    return mGpuStats;
+}
+
+void Profiler::RecordObjectAlloc(bool poolMiss)
+{
+#if PROFILING_ENABLED
+    mFrameAllocStats.mObjectAllocs++;
+
+    if (poolMiss)
+    {
+        mFrameAllocStats.mPoolMisses++;
+    }
+#endif
+}
+
+void Profiler::RecordObjectFree()
+{
+#if PROFILING_ENABLED
+    mFrameAllocStats.mObjectFrees++;
+#endif
+}
+
+const AllocStats& Profiler::GetAllocStats() const
+{
+    return mAllocStats;
+}
+
 void CreateProfiler()
 {
 #if PROFILING_ENABLED
@@ -11,6 +11,9 @@
 #include "Components/PointLightComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/ShadowMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/CameraComponent.h"
+#include "Assets/StaticMesh.h"
 #include "Log.h"
 #include "Line.h"
 #include "Maths.h"
@@ -148,6 +151,16 @@ bool Renderer::IsFrustumCullingEnabled() const
     return mFrustumCulling;
 }
 
+void Renderer::EnableMeshLods(bool enable)
+{
+    mMeshLods = enable;
+}
+
+bool Renderer::AreMeshLodsEnabled() const
+{
+    return mMeshLods;
+}
+
 Texture* Renderer::GetBlackTexture()
 {
     return mBlackTexture.Get<Texture>();
@@ -420,6 +433,7 @@ void Renderer::GatherDrawData(World* world)
 
     if (world != nullptr)
     {
+        CameraComponent* camera = world->GetActiveCamera();
         const std::vector<Actor*>& actors = world->GetActors();
 
         for (uint32_t i = 0; i < actors.size(); ++i)
@@ -439,6 +453,11 @@ void Renderer::GatherDrawData(World* world)
                     if (data.mComponent != nullptr &&
                         comp->IsVisible())
                     {
+                        if (prim->Is(StaticMeshComponent::ClassRuntimeId()))
+                        {
+                            SelectMeshLod(static_cast<StaticMeshComponent*>(prim), camera);
+                        }
+
                         if (simpleShadow)
                         {
                             mSimpleShadowDraws.push_back(data);
@@ -498,8 +517,6 @@ void Renderer::GatherDrawData(World* world)
             }
         }
 
-        CameraComponent* camera = world->GetActiveCamera();
-
         if (camera)
         {
             glm::vec3 cameraPos = camera->GetAbsolutePosition();
@@ -565,19 +582,12 @@ void Renderer::GatherDrawData(World* world)
 
 void Renderer::RenderDraws(const std::vector<DrawData>& drawData)
 {
-    for (uint32_t i = 0; i < drawData.size(); ++i)
-    {
-        drawData[i].mComponent->Render();
-    }
+    GFX_RenderDraws(drawData);
 }
 
 void Renderer::RenderDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId)
 {
-    for (uint32_t i = 0; i < drawData.size(); ++i)
-    {
-        GFX_BindPipeline(pipelineId, drawData[i].mComponent->GetVertexType());
-        drawData[i].mComponent->Render();
-    }
+    GFX_RenderDraws(drawData, pipelineId);
 }
 
 void Renderer::RenderDebugDraws(const std::vector<DebugDraw>& draws, PipelineId pipelineId)
@@ -601,6 +611,41 @@ void Renderer::RenderDebugDraws(const std::vector<DebugDraw>& draws, PipelineId
 #endif
 }
 
+void Renderer::SelectMeshLod(StaticMeshComponent* comp, CameraComponent* camera)
+{
+    StaticMesh* mesh = comp->GetStaticMesh();
+    uint32_t lod = 0;
+
+    if (mMeshLods &&
+        camera != nullptr &&
+        mesh != nullptr &&
+        mesh->GetNumLods() > 1)
+    {
+        // Screen size is the projected bounding sphere radius relative to half the screen height.
+        Bounds bounds = comp->GetBounds();
+        float screenSize = 1.0f;
+
+        if (camera->GetProjectionMode() == ProjectionMode::PERSPECTIVE)
+        {
+            float distance = glm::distance(camera->GetAbsolutePosition(), bounds.mCenter);
+            float tanHalfFov = tanf(glm::radians(camera->GetPerspectiveSettings().mFovY) * 0.5f);
+
+            if (distance > bounds.mRadius)
+            {
+                screenSize = bounds.mRadius / (distance * tanHalfFov);
+            }
+        }
+        else
+        {
+            screenSize = bounds.mRadius / camera->GetOrthoSettings().mHeight;
+        }
+
+        lod = mesh->SelectLod(screenSize);
+    }
+
+    comp->SetLod(lod);
+}
+
 void Renderer::FrustumCull(CameraComponent* camera)
 {
     CameraFrustum frustum;
@@ -645,6 +690,33 @@ void Renderer::FrustumCull(CameraComponent* camera)
 #endif
 }
 
+void Renderer::ShadowCull(DirectionalLightComponent* dirLight)
+{
+    // Each cascade only renders the casters that overlap its own light frustum.
+    for (uint32_t c = 0; c < SHADOW_CASCADE_COUNT; ++c)
+    {
+        std::vector<DrawData>& cascadeDraws = mShadowCascadeDraws[c];
+        cascadeDraws.clear();
+
+        if (!mFrustumCulling)
+        {
+            cascadeDraws = mShadowDraws;
+            continue;
+        }
+
+        CameraFrustum frustum;
+        dirLight->GetCascadeFrustum(c, frustum);
+
+        for (uint32_t i = 0; i < mShadowDraws.size(); ++i)
+        {
+            if (frustum.IsSphereInFrustumOrtho(mShadowDraws[i].mBounds.mCenter, mShadowDraws[i].mBounds.mRadius))
+            {
+                cascadeDraws.push_back(mShadowDraws[i]);
+            }
+        }
+    }
+}
+
 int32_t Renderer::FrustumCullDraws(const CameraFrustum& frustum, std::vector<DrawData>& drawData)
 {
     int32_t drawsCulled = 0;
@@ -759,6 +831,15 @@ void Renderer::Render(World* world)
         FrustumCull(activeCamera);
     }
 
+    DirectionalLightComponent* dirLight = world->GetDirectionalLight();
+    bool renderShadows = (dirLight != nullptr && activeCamera != nullptr && dirLight->ShouldCastShadows());
+
+    if (renderShadows)
+    {
+        dirLight->UpdateShadowCascades(activeCamera);
+        ShadowCull(dirLight);
+    }
+
     uint32_t numViews = GFX_GetNumViews();
 
     for (uint32_t view = 0; view < numViews; ++view)
@@ -773,11 +854,18 @@ void Renderer::Render(World* world)
 
         GFX_BeginRenderPass(RenderPassId::Shadows);
 
-        DirectionalLightComponent* dirLight = world->GetDirectionalLight();
-
-        if (dirLight && dirLight->ShouldCastShadows())
+        if (renderShadows)
         {
-            RenderDraws(mShadowDraws, PipelineId::Shadow);
+            for (uint32_t c = 0; c < SHADOW_CASCADE_COUNT; ++c)
+            {
+                int32_t cascadeX = int32_t(c % 2) * SHADOW_CASCADE_RESOLUTION;
+                int32_t cascadeY = int32_t(c / 2) * SHADOW_CASCADE_RESOLUTION;
+                GFX_SetViewport(cascadeX, cascadeY, SHADOW_CASCADE_RESOLUTION, SHADOW_CASCADE_RESOLUTION);
+                GFX_SetScissor(cascadeX, cascadeY, SHADOW_CASCADE_RESOLUTION, SHADOW_CASCADE_RESOLUTION);
+                GFX_SetShadowCascade(c);
+
+                RenderDraws(mShadowCascadeDraws[c], PipelineId::Shadow);
+            }
         }
 
         GFX_EndRenderPass();
@@ -792,11 +880,15 @@ void Renderer::Render(World* world)
 
         if (GetDebugMode() != DEBUG_WIREFRAME)
         {
+            BEGIN_GPU_STAT("Opaque");
             RenderDraws(mOpaqueDraws);
             RenderDraws(mSimpleShadowDraws);
             RenderDraws(mPostShadowOpaqueDraws);
+            END_GPU_STAT();
 
+            BEGIN_GPU_STAT("Translucent");
             RenderDraws(mTranslucentDraws);
+            END_GPU_STAT();
 
             RenderDebugDraws(mDebugDraws);
         }
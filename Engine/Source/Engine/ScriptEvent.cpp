@@ -168,3 +168,14 @@ void ScriptEvent::NetKick(std::string& tableName, std::string& funcName, NetMsgK
         ExecFunctionCall(L, 2);
     }
 }
+
+// World
+void ScriptEvent::LevelStreamed(std::string& tableName, std::string& funcName, const std::string& levelName)
+{
+    lua_State* L = GetLua();
+    if (PrepFunctionCall(L, tableName, funcName))
+    {
+        lua_pushstring(L, levelName.c_str());   // arg2 - level name
+        ExecFunctionCall(L, 2);
+    }
+}
@@ -128,6 +128,11 @@ void Stream::SetAsyncRequest(AsyncLoadRequest* request)
     mAsyncRequest = request;
 }
 
+AsyncLoadRequest* Stream::GetAsyncRequest()
+{
+    return mAsyncRequest;
+}
+
 void Stream::ReadAsset(AssetRef& asset)
 {
     // TODO: Resort to default asset if failed to load?
@@ -35,6 +35,9 @@ Button::Button() :
 {
     mUseScissor = true;
 
+    // Buttons poll mouse input in Update().
+    mAnimated = true;
+
     mQuad = new Quad();
     mText = new Text();
 
@@ -10,6 +10,9 @@ DEFINE_FACTORY(Console, Widget);
 
 Console::Console()
 {
+    // Output lines fade out over time.
+    mAnimated = true;
+
     glm::vec2 res = Renderer::Get()->GetScreenResolution(0);
 
     mFont = LoadAsset<Font>("F_RobotoMono16");
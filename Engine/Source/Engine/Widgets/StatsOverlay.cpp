@@ -5,6 +5,8 @@
 #include "Profiler.h"
 #include "Engine.h"
 #include "NetworkManager.h"
+#include "AudioManager.h"
+#include "Graphics/Graphics.h"
 
 #include "System/System.h"
 
@@ -20,6 +22,9 @@ StatsOverlay::StatsOverlay()
 
     SetAnchorMode(AnchorMode::TopRight);
     SetRect(x, y, width, height);
+
+    // Stat values change every frame.
+    mAnimated = true;
 }
 
 void StatsOverlay::Update()
@@ -34,14 +39,17 @@ void StatsOverlay::Update()
         break;
     case StatDisplayMode::CpuStatText:
     case StatDisplayMode::CpuStatBars:
-        numStats = (uint32_t)GetProfiler()->GetCpuStats().size();
+        numStats = (uint32_t)(GetProfiler()->GetCpuStats().size() + GetProfiler()->GetGpuStats().size());
         break;
     case StatDisplayMode::Memory:
-        numStats = 1;
+        numStats = 9;
         break;
     case StatDisplayMode::Network:
         numStats = 2;
         break;
+    case StatDisplayMode::Audio:
+        numStats = 2;
+        break;
     default:
         numStats = 0;
         break;
@@ -87,6 +95,18 @@ void StatsOverlay::Update()
 #else
         SetStatText(0, "Free Memory", SYS_GetNumBytesFree() / static_cast<float>(1024 * 1024), statY);
 #endif
+        const AllocStats& allocStats = GetProfiler()->GetAllocStats();
+        SetStatText(1, "Object Allocs", float(allocStats.mObjectAllocs), statY);
+        SetStatText(2, "Pool Misses", float(allocStats.mPoolMisses), statY);
+
+        GpuMemoryStats gpuStats;
+        GFX_GetMemoryStats(gpuStats);
+        SetStatText(3, "GPU Used", gpuStats.mUsedBytes / static_cast<float>(1024 * 1024), statY);
+        SetStatText(4, "GPU Reserved", gpuStats.mReservedBytes / static_cast<float>(1024 * 1024), statY);
+        SetStatText(5, "GPU Host Vis", gpuStats.mHostVisibleBytes / static_cast<float>(1024 * 1024), statY);
+        SetStatText(6, "GPU Allocs", float(gpuStats.mNumAllocations), statY);
+        SetStatText(7, "GPU Dedicated", float(gpuStats.mNumDedicated), statY);
+        SetStatText(8, "GPU Frag %", gpuStats.mFragmentation * 100.0f, statY);
     }
     else if (mDisplayMode == StatDisplayMode::Network)
     {
@@ -94,14 +114,28 @@ void StatsOverlay::Update()
         SetStatText(0, "Upload", netMan->GetUploadRate() / 1024, statY);
         SetStatText(1, "Download", netMan->GetDownloadRate() / 1024, statY);
     }
+    else if (mDisplayMode == StatDisplayMode::Audio)
+    {
+        SetStatText(0, "Real Voices", float(AudioManager::GetNumRealVoices()), statY);
+        SetStatText(1, "Virtual Voices", float(AudioManager::GetNumVirtualVoices()), statY);
+    }
     else
     {
         const std::vector<CpuStat>& stats = GetProfiler()->GetCpuStats();
-        assert(numStats <= stats.size());
-        for (uint32_t i = 0; i < numStats; ++i)
+        const std::vector<GpuStat>& gpuStats = GetProfiler()->GetGpuStats();
+        assert(numStats <= stats.size() + gpuStats.size());
+        for (uint32_t i = 0; i < stats.size(); ++i)
         {
             SetStatText(i, stats[i].mName, stats[i].mSmoothedTime, statY);
         }
+
+        // GPU stats follow the CPU stats, prefixed so that names shared by both (e.g. "UI") can be told apart.
+        for (uint32_t i = 0; i < gpuStats.size(); ++i)
+        {
+            char key[STAT_NAME_BUFFER_LENGTH + 4];
+            snprintf(key, sizeof(key), "GPU %s", gpuStats[i].mName);
+            SetStatText(uint32_t(stats.size()) + i, key, gpuStats[i].mSmoothedTime, statY);
+        }
     }
 
     Canvas::Update();
@@ -42,10 +42,9 @@ void Text::Update()
 {
     Widget::Update();
 
-    UpdateVertexData();
-
     if (IsDirty())
     {
+        UpdateVertexData();
         GFX_UpdateTextResourceUniformData(this);
     }
 }
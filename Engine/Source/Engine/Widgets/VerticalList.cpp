@@ -9,7 +9,8 @@ DEFINE_FACTORY(VerticalList, Widget);
 
 VerticalList::VerticalList()
 {
-
+    // Scroll wheel input is polled in Update().
+    mAnimated = true;
 }
 
 VerticalList::~VerticalList()
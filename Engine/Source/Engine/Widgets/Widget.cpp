@@ -26,7 +26,8 @@ Widget::Widget() :
     mActiveMargins(0),
     mUseScissor(false),
     mVisible(true),
-    mScriptOwned(false)
+    mScriptOwned(false),
+    mAnimated(false)
 {
     MarkDirty();
 
@@ -76,19 +77,37 @@ void Widget::Render()
 }
 
 // Refresh any data used for rendering based on this widget's state. Use dirty flag.
-// Recursively update children.
+// Recursively update children. Only dirty and animated widgets (and their ancestors) are visited.
 void Widget::RecursiveUpdate()
 {
-    Update();
-    mDirty[Renderer::Get()->GetFrameIndex()] = false;
+    uint32_t frameIndex = Renderer::Get()->GetFrameIndex();
+
+    if (mDirty[frameIndex] || mAnimated)
+    {
+        Update();
+        mDirty[frameIndex] = false;
+    }
+
+    mChildDirty[frameIndex] = false;
+
+    bool subtreeAnimated = false;
 
     for (uint32_t i = 0; i < mChildren.size(); ++i)
     {
-        if (mChildren[i]->IsVisible())
+        Widget* child = mChildren[i];
+
+        if (child->IsVisible())
         {
-            mChildren[i]->RecursiveUpdate();
+            if (child->NeedsUpdate())
+            {
+                child->RecursiveUpdate();
+            }
+
+            subtreeAnimated = subtreeAnimated || child->mAnimated || child->mSubtreeAnimated;
         }
     }
+
+    mSubtreeAnimated = subtreeAnimated;
 }
 
 void Widget::Update()
@@ -594,7 +613,17 @@ float Widget::GetParentHeight() const
 
 void Widget::SetVisible(bool visible)
 {
-    mVisible = visible;
+    if (mVisible != visible)
+    {
+        mVisible = visible;
+
+        if (mVisible)
+        {
+            // Hidden subtrees are skipped by RecursiveUpdate(), so make sure
+            // any changes that happened while hidden get picked up now.
+            MarkAncestorsDirty();
+        }
+    }
 }
 
 bool Widget::IsVisible() const
@@ -696,6 +725,41 @@ uint32_t Widget::GetNumChildren() const
 
 void Widget::MarkDirty()
 {
+    MarkSubtreeDirty();
+    MarkAncestorsDirty();
+}
+
+bool Widget::IsDirty() const
+{
+    uint32_t frameIndex = Renderer::Get()->GetFrameIndex();
+    return mDirty[frameIndex];
+}
+
+void Widget::SetAnimated(bool animated)
+{
+    if (mAnimated != animated)
+    {
+        mAnimated = animated;
+
+        // Ancestors need to be visited so they can refresh their mSubtreeAnimated flag.
+        MarkAncestorsDirty();
+    }
+}
+
+bool Widget::IsAnimated() const
+{
+    return mAnimated;
+}
+
+bool Widget::NeedsUpdate() const
+{
+    uint32_t frameIndex = Renderer::Get()->GetFrameIndex();
+    return mDirty[frameIndex] || mChildDirty[frameIndex] || mAnimated || mSubtreeAnimated;
+}
+
+void Widget::MarkSubtreeDirty()
+{
+    // A parent's layout change affects every descendant's rect and transform.
     for (uint32_t i = 0; i < MAX_FRAMES; ++i)
     {
         mDirty[i] = true;
@@ -703,14 +767,24 @@ void Widget::MarkDirty()
 
     for (uint32_t i = 0; i < mChildren.size(); ++i)
     {
-        mChildren[i]->MarkDirty();
+        mChildren[i]->MarkSubtreeDirty();
     }
 }
 
-bool Widget::IsDirty() const
+void Widget::MarkAncestorsDirty()
 {
-    uint32_t frameIndex = Renderer::Get()->GetFrameIndex();
-    return mDirty[frameIndex];
+    // Flag the path to the root so RecursiveUpdate() can find this widget.
+    Widget* ancestor = mParent;
+
+    while (ancestor != nullptr)
+    {
+        for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+        {
+            ancestor->mChildDirty[i] = true;
+        }
+
+        ancestor = ancestor->mParent;
+    }
 }
 
 float Widget::InterfaceToNormalized(float interfaceCoord, float interfaceSize)
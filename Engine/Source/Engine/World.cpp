@@ -3,6 +3,8 @@
 #include "Constants.h"
 #include "Renderer.h"
 #include "Profiler.h"
+#include "ObjectPool.h"
+#include "ScriptEvent.h"
 #include "Utilities.h"
 #include "AudioManager.h"
 #include "AssetManager.h"
@@ -93,6 +95,14 @@ void World::Destroy()
     mActors.clear();
     mActiveCamera = nullptr;
 
+    // Actors were destroyed above, only the pending loads need to be dropped.
+    for (StreamingLevel& streamingLevel : mStreamingLevels)
+    {
+        AssetManager::Get()->EraseAsyncLoadRef(streamingLevel.mLevel);
+    }
+
+    mStreamingLevels.clear();
+
     delete mDynamicsWorld;
     delete mSolver;
     delete mBroadphase;
@@ -723,6 +733,8 @@ void World::Update(float deltaTime)
         mQueuedLevels.clear();
     }
 
+    UpdateLevelStreaming();
+
     {
         SCOPED_CPU_STAT("Physics");
         mDynamicsWorld->stepSimulation(deltaTime, 2);
@@ -948,6 +960,53 @@ Actor* World::SpawnBlueprint(const char* name)
     return ret;
 }
 
+void World::PrewarmActorPool(TypeId actorType, uint32_t count)
+{
+    // Only the actor itself is reserved here. Native actors create their components in their
+    // constructors, so the component sizes aren't known until an instance exists.
+    uint32_t size = FindFactoryClassSize(Actor::GetFactoryList(), actorType);
+
+    if (size > 0)
+    {
+        ObjectPool::Prewarm(size, count);
+    }
+    else
+    {
+        LogError("Failed to prewarm actor pool. Unknown actor type.");
+    }
+}
+
+void World::PrewarmActorPool(const char* typeName, uint32_t count)
+{
+    const std::vector<Factory*>& factoryList = Actor::GetFactoryList();
+    TypeId actorType = INVALID_TYPE_ID;
+
+    for (uint32_t i = 0; i < factoryList.size(); ++i)
+    {
+        if (strcmp(factoryList[i]->GetClassName(), typeName) == 0)
+        {
+            actorType = factoryList[i]->GetType();
+            break;
+        }
+    }
+
+    PrewarmActorPool(actorType, count);
+}
+
+void World::PrewarmBlueprintPool(const char* name, uint32_t count)
+{
+    Blueprint* bp = LoadAsset<Blueprint>(name);
+
+    if (bp != nullptr)
+    {
+        bp->PrewarmPools(count);
+    }
+    else
+    {
+        LogError("Failed to load blueprint.");
+    }
+}
+
 void World::LoadLevel(const char* name, glm::vec3 offset, glm::vec3 rotation)
 {
     Level* level = LoadAsset<Level>(name);
@@ -982,16 +1041,147 @@ void World::QueueLevelLoad(const char* name, bool clearWorld, glm::vec3 offset,
     }
 }
 
+void World::StreamLevel(const char* name, glm::vec3 offset, glm::vec3 rotation)
+{
+    AssetStub* stub = FetchAssetStub(name);
+
+    if (stub != nullptr &&
+        stub->mType == Level::GetStaticType())
+    {
+        mStreamingLevels.push_back(StreamingLevel());
+        StreamingLevel& streamingLevel = mStreamingLevels.back();
+        streamingLevel.mName = name;
+        streamingLevel.mOffset = offset;
+        streamingLevel.mRotation = rotation;
+
+        // The level data is read and its actor records are staged on the async load thread.
+        AsyncLoadAsset(name, &streamingLevel.mLevel);
+    }
+    else
+    {
+        LogError("Failed to stream level.");
+    }
+}
+
+bool World::IsStreamingLevels() const
+{
+    return mStreamingLevels.size() > 0;
+}
+
+float World::GetLevelStreamProgress() const
+{
+    float progress = 1.0f;
+
+    if (mStreamingLevels.size() > 0)
+    {
+        progress = 0.0f;
+
+        for (const StreamingLevel& streamingLevel : mStreamingLevels)
+        {
+            if (streamingLevel.mStarted)
+            {
+                const LevelStreamState& state = streamingLevel.mState;
+                progress += (state.mNumActors > 0) ? (state.mNextActor / float(state.mNumActors)) : 1.0f;
+            }
+        }
+
+        progress /= mStreamingLevels.size();
+    }
+
+    return progress;
+}
+
+void World::SetLevelStreamBudget(float budgetMs)
+{
+    mLevelStreamBudget = budgetMs;
+}
+
+float World::GetLevelStreamBudget() const
+{
+    return mLevelStreamBudget;
+}
+
+void World::UpdateLevelStreaming()
+{
+    if (mStreamingLevels.size() == 0)
+        return;
+
+    SCOPED_CPU_STAT("LevelStream");
+
+    // Levels are spawned one at a time in the order they were requested.
+    StreamingLevel& streamingLevel = mStreamingLevels.front();
+    Level* level = streamingLevel.mLevel.Get<Level>();
+
+    if (level == nullptr)
+    {
+        // Still loading on the async thread.
+        return;
+    }
+
+    if (!streamingLevel.mStarted)
+    {
+        level->BeginStreamIntoWorld(streamingLevel.mState, streamingLevel.mOffset, streamingLevel.mRotation);
+        streamingLevel.mStarted = true;
+    }
+
+    if (level->StreamIntoWorld(this, streamingLevel.mState, mLevelStreamBudget))
+    {
+        // Loaded levels hold the level from here on.
+        mStreamingLevels.pop_front();
+
+        if (mLevelStreamedCallback.mFuncPointer != nullptr)
+        {
+            mLevelStreamedCallback.mFuncPointer(level);
+        }
+        if (mLevelStreamedCallback.mScriptTableName != "")
+        {
+            ScriptEvent::LevelStreamed(
+                mLevelStreamedCallback.mScriptTableName,
+                mLevelStreamedCallback.mScriptFuncName,
+                level->GetName());
+        }
+    }
+}
+
 void World::UnloadLevel(const char* name)
 {
-    for (uint32_t i = 0; i < mLoadedLevels.size(); ++i)
+    for (auto it = mStreamingLevels.begin(); it != mStreamingLevels.end();)
     {
-        if (mLoadedLevels[i].Get()->GetName() == name)
+        if (it->mName == name)
+        {
+            CancelStreamingLevel(*it);
+            it = mStreamingLevels.erase(it);
+        }
+        else
         {
-            mLoadedLevels[i].Get<Level>()->UnloadFromWorld(this);
-            mLoadedLevels.erase(mLoadedLevels.begin() + i);
+            ++it;
         }
     }
+
+    // UnloadFromWorld() erases the level from mLoadedLevels, so hold a ref until it's done.
+    for (int32_t i = int32_t(mLoadedLevels.size()) - 1; i >= 0; --i)
+    {
+        if (i < int32_t(mLoadedLevels.size()) &&
+            mLoadedLevels[i].Get()->GetName() == name)
+        {
+            LevelRef level = mLoadedLevels[i];
+            level.Get<Level>()->UnloadFromWorld(this);
+        }
+    }
+}
+
+void World::CancelStreamingLevel(StreamingLevel& streamingLevel)
+{
+    AssetManager::Get()->EraseAsyncLoadRef(streamingLevel.mLevel);
+
+    // Destroy the actors that were already spawned from a partially streamed level.
+    Level* level = streamingLevel.mLevel.Get<Level>();
+
+    if (level != nullptr &&
+        streamingLevel.mStarted)
+    {
+        level->UnloadFromWorld(this);
+    }
 }
 
 void World::EnableInternalEdgeSmoothing(bool enable)
@@ -175,6 +175,11 @@ void GFX_SetScissor(int32_t x, int32_t y, int32_t width, int32_t height)
     GX_SetScissor(x, y, width, height);
 }
 
+void GFX_SetShadowCascade(uint32_t cascade)
+{
+
+}
+
 glm::mat4 GFX_MakePerspectiveMatrix(float fovyDegrees, float aspectRatio, float zNear, float zFar)
 {
     Mtx44 projection;
@@ -254,6 +259,19 @@ void GFX_DrawFullscreen()
 
 }
 
+void GFX_RenderDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId)
+{
+    for (uint32_t i = 0; i < drawData.size(); ++i)
+    {
+        if (pipelineId != PipelineId::Count)
+        {
+            GFX_BindPipeline(pipelineId, drawData[i].mComponent->GetVertexType());
+        }
+
+        drawData[i].mComponent->Render();
+    }
+}
+
 void GFX_ResizeWindow()
 {
 
@@ -274,6 +292,21 @@ void GFX_SetFrameRate(int32_t frameRate)
 
 }
 
+void GFX_GetMemoryStats(GpuMemoryStats& outStats)
+{
+    outStats = GpuMemoryStats();
+}
+
+void GFX_BeginGpuStat(const char* name)
+{
+
+}
+
+void GFX_EndGpuStat()
+{
+
+}
+
 // Texture
 void GFX_CreateTextureResource(Texture* texture, std::vector<uint8_t>& data)
 {
@@ -9,166 +9,432 @@
 
 #include <assert.h>
 
-std::vector<MemoryBlock> Allocator::sBlocks;
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+std::vector<MemoryBlock*> Allocator::sBlocks;
 const uint64_t Allocator::sDefaultBlockSize = 16777216; // 16 MB Blocks
 
 uint64_t Allocator::sNumAllocations = 0;
 uint64_t Allocator::sNumAllocatedBytes = 0;
+uint32_t Allocator::sNumDedicated[VK_MAX_MEMORY_TYPES] = {};
+uint64_t Allocator::sDedicatedBytes[VK_MAX_MEMORY_TYPES] = {};
+
+static uint32_t FindLastSet(uint64_t value)
+{
+    assert(value != 0);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return uint32_t(index);
+#else
+    return 63 - uint32_t(__builtin_clzll(value));
+#endif
+}
 
-static int64_t sNumChunksAllocated = 0;
+static uint32_t FindFirstSet(uint64_t value)
+{
+    assert(value != 0);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return uint32_t(index);
+#else
+    return uint32_t(__builtin_ctzll(value));
+#endif
+}
 
-MemoryChunk* MemoryBlock::AllocateChunk(uint64_t size)
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
 {
-    MemoryChunk* chunk = nullptr;
+    return ((value + alignment - 1) / alignment) * alignment;
+}
 
-    for (int32_t j = 0; j < int32_t(mChunks.size()); ++j)
+// Size class that a free range of this size is stored in.
+static void MappingInsert(VkDeviceSize size, uint32_t& fl, uint32_t& sl)
+{
+    if (size < (1ull << TLSF_FL_MIN_LOG2))
     {
-        if (mChunks[j].mFree &&
-            mChunks[j].mSize >= size)
-        {
-            // We found a chunk that is big enough, now let's split the chunk into two.
-            uint64_t extraSize = mChunks[j].mSize - size;
+        fl = 0;
+        sl = uint32_t(size >> (TLSF_FL_MIN_LOG2 - TLSF_SL_LOG2));
+    }
+    else
+    {
+        uint32_t log2 = FindLastSet(size);
+        sl = uint32_t(size >> (log2 - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        fl = log2 - TLSF_FL_MIN_LOG2 + 1;
+    }
+}
 
-            if (extraSize > 0)
-            {
-                mChunks[j].mSize = size;
-                
-                MemoryChunk extraChunk;
-                extraChunk.mFree = true;
-                extraChunk.mOffset = mChunks[j].mOffset + mChunks[j].mSize;
-                extraChunk.mSize = extraSize;
-                extraChunk.mID = -1;
-
-                mChunks.insert(mChunks.begin() + j + 1, extraChunk);
-            }
+// First size class in which every free range is at least this big.
+static void MappingSearch(VkDeviceSize size, uint32_t& fl, uint32_t& sl)
+{
+    if (size >= (1ull << TLSF_FL_MIN_LOG2))
+    {
+        size += (1ull << (FindLastSet(size) - TLSF_SL_LOG2)) - 1;
+    }
 
-            mChunks[j].mFree = false;
-            mChunks[j].mID = sNumChunksAllocated++;
+    MappingInsert(size, fl, sl);
+}
 
-            assert(mChunks[j].mID >= 0); // Did we overflow int64_t?
+void MemoryBlock::Init(VkDeviceSize size)
+{
+    mSize = size;
+    mUsedBytes = 0;
+    mNumAllocations = 0;
+    mFlBitmap = 0;
 
-            // make sure we grab the pointer after inserting the new chunk (as it may reallocate the data).
-            chunk = &mChunks[j];
-            break;
+    for (uint32_t fl = 0; fl < TLSF_FL_COUNT; ++fl)
+    {
+        mSlBitmaps[fl] = 0;
+
+        for (uint32_t sl = 0; sl < TLSF_SL_COUNT; ++sl)
+        {
+            mFreeHeads[fl][sl] = -1;
         }
     }
 
-    return chunk;
+    mNodes.clear();
+    mUnusedNodes.clear();
+
+    int32_t first = NewNode();
+    mNodes[first].mOffset = 0;
+    mNodes[first].mSize = size;
+    InsertFree(first);
 }
 
-bool MemoryBlock::FreeChunk(int64_t id)
+int32_t MemoryBlock::AllocateNode(VkDeviceSize size, VkDeviceSize alignment)
 {
-    bool bFreed = false;
+    // Node offsets are always aligned to TLSF_MIN_ALIGNMENT, so only stricter alignments can need a gap.
+    size = AlignUp(size, TLSF_MIN_ALIGNMENT);
+    alignment = glm::max<VkDeviceSize>(alignment, TLSF_MIN_ALIGNMENT);
+    VkDeviceSize searchSize = size + (alignment - TLSF_MIN_ALIGNMENT);
+
+    if (searchSize > mSize)
+    {
+        return -1;
+    }
+
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    MappingSearch(searchSize, fl, sl);
+
+    int32_t node = (fl < TLSF_FL_COUNT) ? FindFree(fl, sl) : -1;
+
+    if (node == -1)
+    {
+        return -1;
+    }
+
+    RemoveFree(node);
 
-    for (int32_t j = 0; j < int32_t(mChunks.size()); ++j)
+    // Return the alignment gap in front of the allocation to the free lists.
+    VkDeviceSize gap = AlignUp(mNodes[node].mOffset, alignment) - mNodes[node].mOffset;
+
+    if (gap > 0)
     {
-        if (mChunks[j].mID == id)
+        int32_t gapNode = NewNode();
+        MemoryNode& gapRange = mNodes[gapNode];
+        MemoryNode& range = mNodes[node];
+
+        gapRange.mOffset = range.mOffset;
+        gapRange.mSize = gap;
+        gapRange.mPrevPhysical = range.mPrevPhysical;
+        gapRange.mNextPhysical = node;
+
+        if (range.mPrevPhysical != -1)
         {
-            bFreed = true;
+            mNodes[range.mPrevPhysical].mNextPhysical = gapNode;
+        }
 
-            // Mark this chunk as freed
-            mChunks[j].mFree = true;
-            
-            // See if we can merge this chunk
-            // First try merging it with the next chunk in the list
-            if (j < int32_t(mChunks.size()) - 1 &&
-                mChunks[j + 1].mFree)
-            {
-                mChunks[j].mSize += mChunks[j + 1].mSize;
-                mChunks.erase(mChunks.begin() + j + 1);
-            }
+        range.mPrevPhysical = gapNode;
+        range.mOffset += gap;
+        range.mSize -= gap;
 
-            // Now try merging with the previous chunk
-            if (j > 0 &&
-                mChunks[j - 1].mFree)
-            {
-                mChunks[j - 1].mSize += mChunks[j].mSize;
-                mChunks.erase(mChunks.begin() + j);
-            }
+        InsertFree(gapNode);
+    }
+
+    // And split off whatever is left behind it.
+    VkDeviceSize remainder = mNodes[node].mSize - size;
+
+    if (remainder > 0)
+    {
+        int32_t restNode = NewNode();
+        MemoryNode& restRange = mNodes[restNode];
+        MemoryNode& range = mNodes[node];
+
+        restRange.mOffset = range.mOffset + size;
+        restRange.mSize = remainder;
+        restRange.mPrevPhysical = node;
+        restRange.mNextPhysical = range.mNextPhysical;
+
+        if (range.mNextPhysical != -1)
+        {
+            mNodes[range.mNextPhysical].mPrevPhysical = restNode;
         }
+
+        range.mNextPhysical = restNode;
+        range.mSize = size;
+
+        InsertFree(restNode);
     }
 
-    return bFreed;
+    mUsedBytes += mNodes[node].mSize;
+    mNumAllocations++;
+
+    return node;
 }
 
-void Allocator::Alloc(uint64_t size, uint64_t alignment, uint32_t memoryType, Allocation& outAllocation)
+void MemoryBlock::FreeNode(int32_t node)
 {
-    MemoryBlock* block = nullptr;
-    MemoryChunk* chunk = nullptr;
+    assert(node >= 0 && node < int32_t(mNodes.size()));
+    assert(!mNodes[node].mFree);
+
+    mUsedBytes -= mNodes[node].mSize;
+    mNumAllocations--;
 
-    uint64_t maxAlignSize = size + alignment;
-    for (int32_t i = 0; i < int32_t(sBlocks.size()); ++i)
+    // Free neighbors are always merged, so at most one merge per side is needed.
+    int32_t prev = mNodes[node].mPrevPhysical;
+
+    if (prev != -1 && mNodes[prev].mFree)
     {
-        if (sBlocks[i].mMemoryType == memoryType)
+        RemoveFree(prev);
+
+        int32_t next = mNodes[node].mNextPhysical;
+        mNodes[prev].mSize += mNodes[node].mSize;
+        mNodes[prev].mNextPhysical = next;
+
+        if (next != -1)
         {
-            chunk = sBlocks[i].AllocateChunk(maxAlignSize);
+            mNodes[next].mPrevPhysical = prev;
+        }
 
-            if (chunk != nullptr)
-            {
-                block = &sBlocks[i];
-                break;
-            }
+        ReleaseNode(node);
+        node = prev;
+    }
+
+    int32_t next = mNodes[node].mNextPhysical;
+
+    if (next != -1 && mNodes[next].mFree)
+    {
+        RemoveFree(next);
+
+        int32_t nextNext = mNodes[next].mNextPhysical;
+        mNodes[node].mSize += mNodes[next].mSize;
+        mNodes[node].mNextPhysical = nextNext;
+
+        if (nextNext != -1)
+        {
+            mNodes[nextNext].mPrevPhysical = node;
         }
+
+        ReleaseNode(next);
     }
 
-    if (chunk == nullptr)
+    InsertFree(node);
+}
+
+int32_t MemoryBlock::NewNode()
+{
+    int32_t node = -1;
+
+    if (mUnusedNodes.size() > 0)
     {
-        uint64_t newBlockSize = maxAlignSize > sDefaultBlockSize ? maxAlignSize : sDefaultBlockSize;
-        block = AllocateBlock(newBlockSize, memoryType);
-        assert(block);
+        node = mUnusedNodes.back();
+        mUnusedNodes.pop_back();
+        mNodes[node] = MemoryNode();
+    }
+    else
+    {
+        node = int32_t(mNodes.size());
+        mNodes.push_back(MemoryNode());
+    }
+
+    return node;
+}
+
+void MemoryBlock::ReleaseNode(int32_t node)
+{
+    mNodes[node] = MemoryNode();
+    mUnusedNodes.push_back(node);
+}
+
+void MemoryBlock::InsertFree(int32_t node)
+{
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    MappingInsert(mNodes[node].mSize, fl, sl);
+
+    int32_t head = mFreeHeads[fl][sl];
+    mNodes[node].mFree = true;
+    mNodes[node].mPrevFree = -1;
+    mNodes[node].mNextFree = head;
 
-        chunk = block->AllocateChunk(maxAlignSize);
+    if (head != -1)
+    {
+        mNodes[head].mPrevFree = node;
     }
 
-    assert(chunk);
+    mFreeHeads[fl][sl] = node;
+    mSlBitmaps[fl] |= (1u << sl);
+    mFlBitmap |= (1ull << fl);
+}
 
-    outAllocation.mDeviceMemory = block->mDeviceMemory;
-    outAllocation.mID = chunk->mID;
-    outAllocation.mOffset = ((chunk->mOffset + alignment - 1) / alignment) * alignment;
-    outAllocation.mSize = size;
-    outAllocation.mType = block->mMemoryType;
-    outAllocation.mPaddedSize = maxAlignSize;
+void MemoryBlock::RemoveFree(int32_t node)
+{
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    MappingInsert(mNodes[node].mSize, fl, sl);
 
-    sNumAllocations++;
-    sNumAllocatedBytes += outAllocation.mPaddedSize;
+    int32_t prev = mNodes[node].mPrevFree;
+    int32_t next = mNodes[node].mNextFree;
 
-    //LogDebug("ALLOC: NumAllocations = %lld, NumAllocatedBytes = %lld", sNumAllocations, sNumAllocatedBytes);
+    if (prev != -1)
+    {
+        mNodes[prev].mNextFree = next;
+    }
+    else
+    {
+        mFreeHeads[fl][sl] = next;
+    }
+
+    if (next != -1)
+    {
+        mNodes[next].mPrevFree = prev;
+    }
+
+    if (mFreeHeads[fl][sl] == -1)
+    {
+        mSlBitmaps[fl] &= ~(1u << sl);
+
+        if (mSlBitmaps[fl] == 0)
+        {
+            mFlBitmap &= ~(1ull << fl);
+        }
+    }
+
+    mNodes[node].mFree = false;
+    mNodes[node].mPrevFree = -1;
+    mNodes[node].mNextFree = -1;
 }
 
-void Allocator::Free(Allocation& allocation)
+int32_t MemoryBlock::FindFree(uint32_t fl, uint32_t sl) const
 {
-    sNumAllocations--;
-    sNumAllocatedBytes -= allocation.mPaddedSize;
+    // Look for a non-empty list in this first level at or above the second level index...
+    uint32_t slMap = mSlBitmaps[fl] & (~0u << sl);
+
+    if (slMap == 0)
+    {
+        // ...otherwise take the smallest list of the next non-empty first level.
+        uint64_t flMap = (fl + 1 < 64) ? (mFlBitmap & (~0ull << (fl + 1))) : 0;
+
+        if (flMap == 0)
+        {
+            return -1;
+        }
+
+        fl = FindFirstSet(flMap);
+        slMap = mSlBitmaps[fl];
+    }
 
-    //LogDebug("FREE: NumAllocations = %lld, NumAllocatedBytes = %lld", sNumAllocations, sNumAllocatedBytes);
+    sl = FindFirstSet(slMap);
+    return mFreeHeads[fl][sl];
+}
+
+void Allocator::Alloc(uint64_t size, uint64_t alignment, uint32_t memoryType, Allocation& outAllocation)
+{
+    assert(memoryType < VK_MAX_MEMORY_TYPES);
+
+    outAllocation.mType = memoryType;
+    outAllocation.mSize = size;
 
-    bool bFreed = false;
-    for (int32_t i = 0; i < int32_t(sBlocks.size()); ++i)
+    if (size >= ALLOCATOR_DEDICATED_THRESHOLD)
     {
-        if (sBlocks[i].mMemoryType == allocation.mType)
+        // Large resources (mostly render targets and big textures) would only fragment the blocks.
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        if (vkAllocateMemory(GetVulkanDevice(), &allocInfo, nullptr, &outAllocation.mDeviceMemory) != VK_SUCCESS)
         {
-            bFreed = sBlocks[i].FreeChunk(allocation.mID);
+            LogError("Failed to allocate dedicated memory");
+            assert(0);
+        }
+
+        outAllocation.mOffset = 0;
+        outAllocation.mBlock = nullptr;
+        outAllocation.mNode = -1;
+
+        sNumDedicated[memoryType]++;
+        sDedicatedBytes[memoryType] += size;
+    }
+    else
+    {
+        MemoryBlock* block = nullptr;
+        int32_t node = -1;
 
-            if (bFreed)
+        for (uint32_t i = 0; i < sBlocks.size(); ++i)
+        {
+            if (sBlocks[i]->mMemoryType == memoryType)
             {
-                // If the block is entirely free, deallocate the memory.
-                if (sBlocks[i].mChunks.size() == 1)
+                node = sBlocks[i]->AllocateNode(size, alignment);
+
+                if (node != -1)
                 {
-                    assert(sBlocks[i].mChunks[0].mFree);
-                    FreeBlock(sBlocks[i]);
+                    block = sBlocks[i];
+                    break;
                 }
-                break;
             }
         }
+
+        if (node == -1)
+        {
+            block = AllocateBlock(sDefaultBlockSize, memoryType);
+            assert(block);
+
+            node = block->AllocateNode(size, alignment);
+        }
+
+        assert(node != -1);
+
+        outAllocation.mDeviceMemory = block->mDeviceMemory;
+        outAllocation.mOffset = block->mNodes[node].mOffset;
+        outAllocation.mBlock = block;
+        outAllocation.mNode = node;
+    }
+
+    sNumAllocations++;
+    sNumAllocatedBytes += size;
+}
+
+void Allocator::Free(Allocation& allocation)
+{
+    assert(allocation.IsValid());
+
+    sNumAllocations--;
+    sNumAllocatedBytes -= allocation.mSize;
+
+    if (allocation.mBlock == nullptr)
+    {
+        vkFreeMemory(GetVulkanDevice(), allocation.mDeviceMemory, nullptr);
+
+        sNumDedicated[allocation.mType]--;
+        sDedicatedBytes[allocation.mType] -= allocation.mSize;
     }
+    else
+    {
+        MemoryBlock* block = allocation.mBlock;
+        block->FreeNode(allocation.mNode);
 
-    assert(bFreed);
+        // If the block is entirely free, deallocate the memory.
+        if (block->mNumAllocations == 0)
+        {
+            FreeBlock(block);
+        }
+    }
 
-    allocation.mDeviceMemory = VK_NULL_HANDLE;
-    allocation.mID = -1;
-    allocation.mOffset = 0;
-    allocation.mSize = 0;
-    allocation.mType = 0;
+    allocation = Allocation();
 }
 
 uint64_t Allocator::GetNumBlocksAllocated()
@@ -186,15 +452,78 @@ uint64_t Allocator::GetNumAllocatedBytes()
     return sNumAllocatedBytes;
 }
 
-MemoryBlock* Allocator::AllocateBlock(uint64_t newBlockSize, uint32_t memoryType)
+void Allocator::GetStats(AllocatorStats& outStats, uint32_t memoryType)
+{
+    outStats = AllocatorStats();
+
+    for (uint32_t i = 0; i < sBlocks.size(); ++i)
+    {
+        const MemoryBlock* block = sBlocks[i];
+
+        if (memoryType != ALLOCATOR_ALL_MEMORY_TYPES &&
+            block->mMemoryType != memoryType)
+        {
+            continue;
+        }
+
+        outStats.mNumBlocks++;
+        outStats.mNumAllocations += block->mNumAllocations;
+        outStats.mReservedBytes += block->mSize;
+        outStats.mUsedBytes += block->mUsedBytes;
+
+        // Released nodes are never marked free, so this only counts live free ranges.
+        for (uint32_t n = 0; n < block->mNodes.size(); ++n)
+        {
+            if (block->mNodes[n].mFree)
+            {
+                outStats.mNumFreeRanges++;
+                outStats.mLargestFreeRange = glm::max<uint64_t>(outStats.mLargestFreeRange, block->mNodes[n].mSize);
+            }
+        }
+    }
+
+    for (uint32_t t = 0; t < VK_MAX_MEMORY_TYPES; ++t)
+    {
+        if (memoryType == ALLOCATOR_ALL_MEMORY_TYPES || memoryType == t)
+        {
+            outStats.mNumAllocations += sNumDedicated[t];
+            outStats.mNumDedicated += sNumDedicated[t];
+            outStats.mReservedBytes += sDedicatedBytes[t];
+            outStats.mUsedBytes += sDedicatedBytes[t];
+        }
+    }
+}
+
+void Allocator::LogStats()
 {
-    sBlocks.push_back(MemoryBlock());
-    MemoryBlock& newBlock = sBlocks.back();
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(GetVulkanContext()->GetPhysicalDevice(), &memProperties);
+
+    for (uint32_t t = 0; t < memProperties.memoryTypeCount; ++t)
+    {
+        AllocatorStats stats;
+        GetStats(stats, t);
 
-    newBlock.mSize = newBlockSize;
-    newBlock.mAvailableMemory = newBlockSize;
-    newBlock.mLargestChunk = newBlockSize;
-    newBlock.mMemoryType = memoryType;
+        if (stats.mReservedBytes > 0)
+        {
+            LogDebug("Memory Type %d (flags 0x%x): %d blocks, %d allocs (%d dedicated), %.2f / %.2f MB used, %d free ranges, largest %.2f MB",
+                int32_t(t),
+                uint32_t(memProperties.memoryTypes[t].propertyFlags),
+                int32_t(stats.mNumBlocks),
+                int32_t(stats.mNumAllocations),
+                int32_t(stats.mNumDedicated),
+                stats.mUsedBytes / float(1024 * 1024),
+                stats.mReservedBytes / float(1024 * 1024),
+                int32_t(stats.mNumFreeRanges),
+                stats.mLargestFreeRange / float(1024 * 1024));
+        }
+    }
+}
+
+MemoryBlock* Allocator::AllocateBlock(uint64_t newBlockSize, uint32_t memoryType)
+{
+    MemoryBlock* newBlock = new MemoryBlock();
+    newBlock->mMemoryType = memoryType;
 
     // Allocate video memory.
     VkMemoryAllocateInfo allocInfo = {};
@@ -202,30 +531,26 @@ MemoryBlock* Allocator::AllocateBlock(uint64_t newBlockSize, uint32_t memoryType
     allocInfo.allocationSize = newBlockSize;
     allocInfo.memoryTypeIndex = memoryType;
 
-    if (vkAllocateMemory(GetVulkanDevice(), &allocInfo, nullptr, &newBlock.mDeviceMemory) != VK_SUCCESS)
+    if (vkAllocateMemory(GetVulkanDevice(), &allocInfo, nullptr, &newBlock->mDeviceMemory) != VK_SUCCESS)
     {
         LogError("Failed to allocate image memory");
         assert(0);
     }
 
-    // Initialize the starting chunk.
-    MemoryChunk firstChunk;
-    firstChunk.mFree = true;
-    firstChunk.mID = -1;
-    firstChunk.mOffset = 0;
-    firstChunk.mSize = newBlockSize;
-    newBlock.mChunks.push_back(firstChunk);
+    // Initialize the free lists with one range spanning the whole block.
+    newBlock->Init(newBlockSize);
+    sBlocks.push_back(newBlock);
 
-    return &newBlock;
+    return newBlock;
 }
 
-void Allocator::FreeBlock(MemoryBlock& block)
+void Allocator::FreeBlock(MemoryBlock* block)
 {
     int32_t index = 0;
 
     for (index = 0; index < int32_t(sBlocks.size()); ++index)
     {
-        if (block.mDeviceMemory == sBlocks[index].mDeviceMemory)
+        if (block == sBlocks[index])
         {
             break;
         }
@@ -233,8 +558,9 @@ void Allocator::FreeBlock(MemoryBlock& block)
 
     assert(index < int32_t(sBlocks.size()));
 
-    vkFreeMemory(GetVulkanDevice(), sBlocks[index].mDeviceMemory, nullptr);
+    vkFreeMemory(GetVulkanDevice(), block->mDeviceMemory, nullptr);
     sBlocks.erase(sBlocks.begin() + index);
+    delete block;
 }
 
-#endif // API_VULKAN
\ No newline at end of file
+#endif // API_VULKAN
@@ -0,0 +1,211 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/BindlessTable.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/UniformBuffer.h"
+#include "Graphics/Vulkan/Image.h"
+
+#include "Log.h"
+
+#include <assert.h>
+
+void BindlessTable::Create(VkDescriptorSetLayout layout)
+{
+    VkDevice device = GetVulkanDevice();
+
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[0].descriptorCount = MAX_FRAMES;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[1].descriptorCount = MAX_FRAMES * BINDLESS_MAX_TEXTURES;
+
+    VkDescriptorPoolCreateInfo ciPool = {};
+    ciPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ciPool.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    ciPool.poolSizeCount = 2;
+    ciPool.pPoolSizes = poolSizes;
+    ciPool.maxSets = MAX_FRAMES;
+
+    if (vkCreateDescriptorPool(device, &ciPool, nullptr, &mDescriptorPool) != VK_SUCCESS)
+    {
+        LogError("Failed to create bindless descriptor pool");
+        assert(0);
+    }
+
+    mMaterialBuffer = new UniformBuffer(BINDLESS_MAX_MATERIALS * sizeof(MaterialData), "Bindless Materials", nullptr, BufferType::Storage);
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = mDescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        if (vkAllocateDescriptorSets(device, &allocInfo, &mDescriptorSets[i]) != VK_SUCCESS)
+        {
+            LogError("Failed to allocate bindless descriptor set");
+            assert(0);
+        }
+
+        VkDescriptorBufferInfo bufferInfo = {};
+        bufferInfo.buffer = mMaterialBuffer->Get(i);
+        bufferInfo.offset = 0;
+        bufferInfo.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet descriptorWrite = {};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = mDescriptorSets[i];
+        descriptorWrite.dstBinding = 0;
+        descriptorWrite.dstArrayElement = 0;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pBufferInfo = &bufferInfo;
+
+        vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+    }
+
+    LogDebug("Bindless materials enabled (%d textures, %d materials)", BINDLESS_MAX_TEXTURES, BINDLESS_MAX_MATERIALS);
+}
+
+void BindlessTable::Destroy()
+{
+    if (mDescriptorPool == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // Destroying the pool frees the sets. The device has been waited on before this.
+    vkDestroyDescriptorPool(GetVulkanDevice(), mDescriptorPool, nullptr);
+    mDescriptorPool = VK_NULL_HANDLE;
+
+    GetDestroyQueue()->Destroy(mMaterialBuffer);
+    mMaterialBuffer = nullptr;
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        mDescriptorSets[i] = VK_NULL_HANDLE;
+        mPendingTextureSlots[i].clear();
+        mPendingMaterialSlots[i].clear();
+    }
+
+    mFreeTextureSlots.clear();
+    mFreeMaterialSlots.clear();
+    mNumTextureSlots = 0;
+    mNumMaterialSlots = 0;
+}
+
+void BindlessTable::BeginFrame()
+{
+    uint32_t frameIndex = GetFrameIndex();
+
+    mFreeTextureSlots.insert(mFreeTextureSlots.end(), mPendingTextureSlots[frameIndex].begin(), mPendingTextureSlots[frameIndex].end());
+    mFreeMaterialSlots.insert(mFreeMaterialSlots.end(), mPendingMaterialSlots[frameIndex].begin(), mPendingMaterialSlots[frameIndex].end());
+    mPendingTextureSlots[frameIndex].clear();
+    mPendingMaterialSlots[frameIndex].clear();
+}
+
+uint32_t BindlessTable::AddTexture(Image* image)
+{
+    uint32_t index = AllocSlot(mFreeTextureSlots, mNumTextureSlots, BINDLESS_MAX_TEXTURES);
+
+    if (index == BINDLESS_INVALID_INDEX)
+    {
+        LogError("Out of bindless texture slots (max %d)", BINDLESS_MAX_TEXTURES);
+        return index;
+    }
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfo.imageView = image->GetView();
+    imageInfo.sampler = image->GetSampler();
+
+    VkWriteDescriptorSet descriptorWrites[MAX_FRAMES] = {};
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].dstSet = mDescriptorSets[i];
+        descriptorWrites[i].dstBinding = 1;
+        descriptorWrites[i].dstArrayElement = index;
+        descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[i].descriptorCount = 1;
+        descriptorWrites[i].pImageInfo = &imageInfo;
+    }
+
+    vkUpdateDescriptorSets(GetVulkanDevice(), MAX_FRAMES, descriptorWrites, 0, nullptr);
+
+    return index;
+}
+
+void BindlessTable::RemoveTexture(uint32_t index)
+{
+    if (mDescriptorPool != VK_NULL_HANDLE &&
+        index != BINDLESS_INVALID_INDEX)
+    {
+        mPendingTextureSlots[GetFrameIndex()].push_back(index);
+    }
+}
+
+uint32_t BindlessTable::AddMaterial()
+{
+    uint32_t index = AllocSlot(mFreeMaterialSlots, mNumMaterialSlots, BINDLESS_MAX_MATERIALS);
+
+    if (index == BINDLESS_INVALID_INDEX)
+    {
+        LogError("Out of bindless material slots (max %d)", BINDLESS_MAX_MATERIALS);
+    }
+
+    return index;
+}
+
+void BindlessTable::RemoveMaterial(uint32_t index)
+{
+    if (mDescriptorPool != VK_NULL_HANDLE &&
+        index != BINDLESS_INVALID_INDEX)
+    {
+        mPendingMaterialSlots[GetFrameIndex()].push_back(index);
+    }
+}
+
+void BindlessTable::UpdateMaterial(uint32_t index, const MaterialData& data)
+{
+    if (index != BINDLESS_INVALID_INDEX)
+    {
+        // Only the current frame's buffer, the other frame might still be reading its copy.
+        mMaterialBuffer->GetBuffer(GetFrameIndex())->Update(&data, sizeof(MaterialData), index * sizeof(MaterialData));
+    }
+}
+
+void BindlessTable::Bind(VkCommandBuffer cb, VkPipelineLayout pipelineLayout)
+{
+    vkCmdBindDescriptorSets(
+        cb,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pipelineLayout,
+        (uint32_t)DescriptorSetBinding::Material,
+        1,
+        &mDescriptorSets[GetFrameIndex()],
+        0,
+        nullptr);
+}
+
+uint32_t BindlessTable::AllocSlot(std::vector<uint32_t>& freeSlots, uint32_t& numSlots, uint32_t maxSlots)
+{
+    uint32_t index = BINDLESS_INVALID_INDEX;
+
+    if (freeSlots.size() > 0)
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else if (numSlots < maxSlots)
+    {
+        index = numSlots++;
+    }
+
+    return index;
+}
+
+#endif
@@ -24,7 +24,9 @@ Buffer::Buffer(
     case BufferType::Vertex: usageFlags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT; break;
     case BufferType::Index: usageFlags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT; break;
     case BufferType::Uniform: usageFlags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT; break;
+    case BufferType::Storage: usageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; break;
     case BufferType::Transfer: usageFlags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT; break;
+    case BufferType::Indirect: usageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT; break;
     default: assert(0); break; // Not valid type
     }
 
@@ -70,15 +72,16 @@ void Buffer::Update(const void* srcData, size_t srcSize, size_t dstOffset)
     if (mHostVisible)
     {
         void* data = nullptr;
-        vkMapMemory(device, mMemory.mDeviceMemory, mMemory.mOffset, srcSize, 0, &data);
+        vkMapMemory(device, mMemory.mDeviceMemory, mMemory.mOffset + dstOffset, srcSize, 0, &data);
         memcpy(data, srcData, srcSize);
         vkUnmapMemory(device, mMemory.mDeviceMemory);
     }
     else
     {
-        Buffer* stagingBuffer = new Buffer(BufferType::Transfer, srcSize, "Staging Buffer", srcData);
-        CopyBuffer(stagingBuffer->Get(), mBuffer, srcSize);
-        GetDestroyQueue()->Destroy(stagingBuffer);
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        GetVulkanContext()->GetUploadQueue().Stage(srcData, uint32_t(srcSize), stagingBuffer, stagingOffset);
+        CopyBuffer(stagingBuffer, mBuffer, srcSize, dstOffset, stagingOffset);
     }
 }
 
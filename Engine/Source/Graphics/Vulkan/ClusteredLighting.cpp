@@ -0,0 +1,296 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/ClusteredLighting.h"
+#include "Graphics/Vulkan/UniformBuffer.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+
+#include "Components/CameraComponent.h"
+#include "Components/PointLightComponent.h"
+#include "Log.h"
+
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+static const size_t kIndexListOffset = sizeof(ClusterLightData);
+static const size_t kMaxBufferSize = sizeof(ClusterLightData) + LIGHT_CLUSTER_COUNT * LIGHT_CLUSTER_MAX_LIGHTS * sizeof(uint32_t);
+
+static glm::vec3 UnprojectAtDepth(const glm::mat4& invProjection, float ndcX, float ndcY, float depth)
+{
+    // Find the view space line through this NDC point and walk it to the requested view depth.
+    glm::vec4 p0 = invProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+    glm::vec4 p1 = invProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    glm::vec3 v0 = glm::vec3(p0) / p0.w;
+    glm::vec3 v1 = glm::vec3(p1) / p1.w;
+
+    float d0 = -v0.z;
+    float d1 = -v1.z;
+    float t = (glm::abs(d1 - d0) > 0.0001f) ? (depth - d0) / (d1 - d0) : 0.0f;
+
+    return v0 + t * (v1 - v0);
+}
+
+void ClusteredLighting::Create()
+{
+    mBuffer = new UniformBuffer(kMaxBufferSize, "Cluster Lights", nullptr, BufferType::Storage);
+    mData.resize(kMaxBufferSize);
+    memset(mData.data(), 0, mData.size());
+
+    mClusterBounds.resize(LIGHT_CLUSTER_COUNT);
+    mClusterLights.resize(LIGHT_CLUSTER_COUNT * LIGHT_CLUSTER_MAX_LIGHTS);
+    mClusterCounts.resize(LIGHT_CLUSTER_COUNT);
+    mLightRanges.reserve(MAX_POINTLIGHTS);
+
+    // Force the bounds to be rebuilt on the first update.
+    mBoundsProjection = glm::mat4(0.0f);
+}
+
+void ClusteredLighting::Destroy()
+{
+    GetDestroyQueue()->Destroy(mBuffer);
+    mBuffer = nullptr;
+}
+
+void ClusteredLighting::Update(CameraComponent* camera, const std::vector<PointLightComponent*>& pointLights)
+{
+    ClusterLightData* lightData = reinterpret_cast<ClusterLightData*>(mData.data());
+    uint32_t* indexList = reinterpret_cast<uint32_t*>(mData.data() + kIndexListOffset);
+
+    memset(mClusterCounts.data(), 0, mClusterCounts.size());
+    mLightRanges.clear();
+    mNumLights = 0;
+
+    if (camera != nullptr)
+    {
+        // The camera only stores the view projection with the clip adjustment applied.
+        const glm::mat4& view = camera->GetViewMatrix();
+        glm::mat4 projection = camera->GetViewProjectionMatrix() * glm::inverse(view);
+
+        float nearZ = glm::max(camera->GetNearZ(), LIGHT_CLUSTER_MIN_DEPTH);
+        float farZ = glm::max(camera->GetFarZ(), nearZ + 1.0f);
+
+        if (projection != mBoundsProjection ||
+            nearZ != mBoundsNear ||
+            farZ != mBoundsFar)
+        {
+            UpdateClusterBounds(projection, nearZ, farZ);
+        }
+
+        static bool sWarnedLightCount = false;
+        if (pointLights.size() > MAX_POINTLIGHTS && !sWarnedLightCount)
+        {
+            sWarnedLightCount = true;
+            LogWarning("Too many point lights (%d), only the first %d will be rendered.", int32_t(pointLights.size()), MAX_POINTLIGHTS);
+        }
+
+        uint32_t numLights = glm::min<uint32_t>(uint32_t(pointLights.size()), MAX_POINTLIGHTS);
+
+        for (uint32_t l = 0; l < numLights; ++l)
+        {
+            PointLightComponent* pointLight = pointLights[l];
+            glm::vec3 position = pointLight->GetAbsolutePosition();
+            float radius = pointLight->GetRadius();
+
+            lightData->mLightPositions[l] = glm::vec4(position, radius);
+            lightData->mLightColors[l] = pointLight->GetColor();
+
+            glm::vec3 viewPos = glm::vec3(view * glm::vec4(position, 1.0f));
+            float depth = -viewPos.z;
+
+            if (depth + radius < 0.0f ||
+                depth - radius > farZ)
+            {
+                continue;
+            }
+
+            int32_t z0 = GetDepthSlice(depth - radius);
+            int32_t z1 = GetDepthSlice(depth + radius);
+            int32_t x0 = 0;
+            int32_t x1 = LIGHT_CLUSTER_DIM_X - 1;
+            int32_t y0 = 0;
+            int32_t y1 = LIGHT_CLUSTER_DIM_Y - 1;
+
+            // Narrow the tile range by projecting the sphere's bounding box, unless it reaches the camera plane.
+            if (depth - radius > nearZ)
+            {
+                glm::vec2 ndcMin = glm::vec2(1.0f);
+                glm::vec2 ndcMax = glm::vec2(-1.0f);
+
+                for (uint32_t c = 0; c < 8; ++c)
+                {
+                    glm::vec3 corner = viewPos + glm::vec3(
+                        (c & 1) ? radius : -radius,
+                        (c & 2) ? radius : -radius,
+                        (c & 4) ? radius : -radius);
+
+                    glm::vec4 clipPos = projection * glm::vec4(corner, 1.0f);
+                    glm::vec2 ndc = glm::vec2(clipPos) / clipPos.w;
+                    ndcMin = glm::min(ndcMin, ndc);
+                    ndcMax = glm::max(ndcMax, ndc);
+                }
+
+                x0 = glm::clamp(int32_t(floorf((ndcMin.x * 0.5f + 0.5f) * LIGHT_CLUSTER_DIM_X)), 0, LIGHT_CLUSTER_DIM_X - 1);
+                x1 = glm::clamp(int32_t(floorf((ndcMax.x * 0.5f + 0.5f) * LIGHT_CLUSTER_DIM_X)), 0, LIGHT_CLUSTER_DIM_X - 1);
+                y0 = glm::clamp(int32_t(floorf((ndcMin.y * 0.5f + 0.5f) * LIGHT_CLUSTER_DIM_Y)), 0, LIGHT_CLUSTER_DIM_Y - 1);
+                y1 = glm::clamp(int32_t(floorf((ndcMax.y * 0.5f + 0.5f) * LIGHT_CLUSTER_DIM_Y)), 0, LIGHT_CLUSTER_DIM_Y - 1);
+            }
+
+            LightClusterRange range;
+            range.mViewPos = viewPos;
+            range.mRadiusSq = radius * radius;
+            range.mMin[0] = x0;
+            range.mMin[1] = y0;
+            range.mMin[2] = z0;
+            range.mMax[0] = x1;
+            range.mMax[1] = y1;
+            range.mMax[2] = z1;
+            range.mLightIndex = uint16_t(l);
+            mLightRanges.push_back(range);
+        }
+
+        // A handful of lights is cheaper to bin than to hand out to the workers.
+        uint32_t slicesPerJob = (mLightRanges.size() >= LIGHT_CLUSTER_PARALLEL_MIN_LIGHTS) ? LIGHT_CLUSTER_SLICES_PER_JOB : LIGHT_CLUSTER_DIM_Z;
+
+        GetVulkanContext()->GetCommandRecorder().RunTasks(
+            LIGHT_CLUSTER_DIM_Z,
+            slicesPerJob,
+            [this](uint32_t zBegin, uint32_t zEnd) { BinSlices(zBegin, zEnd); });
+
+        mNumLights = int32_t(numLights);
+        mDepthParams = glm::vec4(
+            LIGHT_CLUSTER_DIM_Z / logf(farZ / nearZ),
+            -LIGHT_CLUSTER_DIM_Z * logf(nearZ) / logf(farZ / nearZ),
+            0.0f,
+            0.0f);
+    }
+
+    // Compact the per cluster lists into one index list.
+    uint32_t numIndices = 0;
+
+    for (uint32_t i = 0; i < LIGHT_CLUSTER_COUNT; ++i)
+    {
+        uint32_t count = mClusterCounts[i];
+        lightData->mClusters[i] = glm::uvec2(numIndices, count);
+
+        const uint16_t* clusterLights = &mClusterLights[i * LIGHT_CLUSTER_MAX_LIGHTS];
+        for (uint32_t j = 0; j < count; ++j)
+        {
+            indexList[numIndices++] = clusterLights[j];
+        }
+    }
+
+    // Only upload the part of the index list that was written this frame.
+    size_t uploadSize = kIndexListOffset + glm::max<uint32_t>(numIndices, 1) * sizeof(uint32_t);
+    mBuffer->Update(mData.data(), uploadSize);
+}
+
+UniformBuffer* ClusteredLighting::GetBuffer()
+{
+    return mBuffer;
+}
+
+int32_t ClusteredLighting::GetNumLights() const
+{
+    return mNumLights;
+}
+
+glm::vec4 ClusteredLighting::GetDepthParams() const
+{
+    return mDepthParams;
+}
+
+void ClusteredLighting::UpdateClusterBounds(const glm::mat4& projection, float nearZ, float farZ)
+{
+    glm::mat4 invProjection = glm::inverse(projection);
+
+    for (uint32_t z = 0; z < LIGHT_CLUSTER_DIM_Z; ++z)
+    {
+        // Slice 0 also covers anything in front of the near depth, the last slice anything past far.
+        float sliceNear = (z == 0) ? 0.0f : nearZ * powf(farZ / nearZ, float(z) / LIGHT_CLUSTER_DIM_Z);
+        float sliceFar = nearZ * powf(farZ / nearZ, float(z + 1) / LIGHT_CLUSTER_DIM_Z);
+
+        for (uint32_t y = 0; y < LIGHT_CLUSTER_DIM_Y; ++y)
+        {
+            float ndcY0 = -1.0f + 2.0f * y / LIGHT_CLUSTER_DIM_Y;
+            float ndcY1 = -1.0f + 2.0f * (y + 1) / LIGHT_CLUSTER_DIM_Y;
+
+            for (uint32_t x = 0; x < LIGHT_CLUSTER_DIM_X; ++x)
+            {
+                float ndcX0 = -1.0f + 2.0f * x / LIGHT_CLUSTER_DIM_X;
+                float ndcX1 = -1.0f + 2.0f * (x + 1) / LIGHT_CLUSTER_DIM_X;
+
+                glm::vec3 corners[8] =
+                {
+                    UnprojectAtDepth(invProjection, ndcX0, ndcY0, sliceNear),
+                    UnprojectAtDepth(invProjection, ndcX1, ndcY0, sliceNear),
+                    UnprojectAtDepth(invProjection, ndcX0, ndcY1, sliceNear),
+                    UnprojectAtDepth(invProjection, ndcX1, ndcY1, sliceNear),
+                    UnprojectAtDepth(invProjection, ndcX0, ndcY0, sliceFar),
+                    UnprojectAtDepth(invProjection, ndcX1, ndcY0, sliceFar),
+                    UnprojectAtDepth(invProjection, ndcX0, ndcY1, sliceFar),
+                    UnprojectAtDepth(invProjection, ndcX1, ndcY1, sliceFar),
+                };
+
+                LightClusterBounds& bounds = mClusterBounds[(z * LIGHT_CLUSTER_DIM_Y + y) * LIGHT_CLUSTER_DIM_X + x];
+                bounds.mMin = corners[0];
+                bounds.mMax = corners[0];
+
+                for (uint32_t c = 1; c < 8; ++c)
+                {
+                    bounds.mMin = glm::min(bounds.mMin, corners[c]);
+                    bounds.mMax = glm::max(bounds.mMax, corners[c]);
+                }
+            }
+        }
+    }
+
+    mBoundsProjection = projection;
+    mBoundsNear = nearZ;
+    mBoundsFar = farZ;
+}
+
+void ClusteredLighting::BinSlices(uint32_t zBegin, uint32_t zEnd)
+{
+    for (uint32_t r = 0; r < mLightRanges.size(); ++r)
+    {
+        const LightClusterRange& range = mLightRanges[r];
+        int32_t z0 = glm::max<int32_t>(range.mMin[2], int32_t(zBegin));
+        int32_t z1 = glm::min<int32_t>(range.mMax[2], int32_t(zEnd) - 1);
+
+        for (int32_t z = z0; z <= z1; ++z)
+        {
+            for (int32_t y = range.mMin[1]; y <= range.mMax[1]; ++y)
+            {
+                for (int32_t x = range.mMin[0]; x <= range.mMax[0]; ++x)
+                {
+                    uint32_t cluster = (z * LIGHT_CLUSTER_DIM_Y + y) * LIGHT_CLUSTER_DIM_X + x;
+                    const LightClusterBounds& bounds = mClusterBounds[cluster];
+
+                    glm::vec3 closest = glm::clamp(range.mViewPos, bounds.mMin, bounds.mMax);
+                    glm::vec3 delta = range.mViewPos - closest;
+
+                    if (glm::dot(delta, delta) <= range.mRadiusSq &&
+                        mClusterCounts[cluster] < LIGHT_CLUSTER_MAX_LIGHTS)
+                    {
+                        mClusterLights[cluster * LIGHT_CLUSTER_MAX_LIGHTS + mClusterCounts[cluster]] = range.mLightIndex;
+                        mClusterCounts[cluster]++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int32_t ClusteredLighting::GetDepthSlice(float depth) const
+{
+    if (depth <= mBoundsNear)
+    {
+        return 0;
+    }
+
+    float slice = logf(depth / mBoundsNear) * LIGHT_CLUSTER_DIM_Z / logf(mBoundsFar / mBoundsNear);
+    return glm::clamp(int32_t(slice), 0, LIGHT_CLUSTER_DIM_Z - 1);
+}
+
+#endif
@@ -0,0 +1,425 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/CommandRecorder.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Graphics.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "EngineTypes.h"
+#include "Renderer.h"
+#include "Log.h"
+
+#include <glm/glm.hpp>
+#include <assert.h>
+
+// 0 is the main thread, workers are 1 to RECORD_MAX_THREADS.
+static thread_local uint32_t sRecordThreadIndex = 0;
+
+void CommandRecorder::Create(uint32_t queueFamilyIndex)
+{
+    VkDevice device = GetVulkanDevice();
+
+    // Leave a core for the main thread, which records jobs too while it waits.
+    uint32_t numCores = std::thread::hardware_concurrency();
+    uint32_t numWorkers = (numCores > 1) ? glm::min<uint32_t>(numCores - 1, RECORD_MAX_THREADS) : 0;
+
+    for (uint32_t f = 0; f < MAX_FRAMES; ++f)
+    {
+        for (uint32_t t = 0; t <= numWorkers; ++t)
+        {
+            VkCommandPoolCreateInfo ciCommandPool = {};
+            ciCommandPool.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            ciCommandPool.queueFamilyIndex = queueFamilyIndex;
+            ciCommandPool.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+            if (vkCreateCommandPool(device, &ciCommandPool, nullptr, &mCommandPools[f][t]) != VK_SUCCESS)
+            {
+                LogError("Failed to create record command pool");
+                assert(0);
+            }
+        }
+    }
+
+    mExit = false;
+
+    for (uint32_t t = 1; t <= numWorkers; ++t)
+    {
+        mThreads.push_back(std::thread(WorkerThreadFunc, this, t));
+    }
+
+    LogDebug("Recording secondary command buffers with %d worker threads", int32_t(numWorkers));
+}
+
+void CommandRecorder::Destroy()
+{
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+        mExit = true;
+    }
+
+    mJobCondition.notify_all();
+
+    for (uint32_t i = 0; i < mThreads.size(); ++i)
+    {
+        mThreads[i].join();
+    }
+
+    mThreads.clear();
+
+    // Destroying the pools frees their command buffers. The device has been waited on before this.
+    VkDevice device = GetVulkanDevice();
+
+    for (uint32_t f = 0; f < MAX_FRAMES; ++f)
+    {
+        for (uint32_t t = 0; t <= RECORD_MAX_THREADS; ++t)
+        {
+            if (mCommandPools[f][t] != VK_NULL_HANDLE)
+            {
+                vkDestroyCommandPool(device, mCommandPools[f][t], nullptr);
+                mCommandPools[f][t] = VK_NULL_HANDLE;
+            }
+
+            mSecondaries[f][t].clear();
+            mNumSecondariesUsed[f][t] = 0;
+        }
+    }
+}
+
+void CommandRecorder::BeginFrame()
+{
+    VkDevice device = GetVulkanDevice();
+    uint32_t frameIndex = GetFrameIndex();
+
+    for (uint32_t t = 0; t <= mThreads.size(); ++t)
+    {
+        vkResetCommandPool(device, mCommandPools[frameIndex][t], 0);
+        mNumSecondariesUsed[frameIndex][t] = 0;
+    }
+}
+
+void CommandRecorder::BeginPass(VkRenderPass renderPass, VkFramebuffer framebuffer)
+{
+    assert(!mPassActive);
+
+    mRenderPass = renderPass;
+    mFramebuffer = framebuffer;
+    mPassActive = true;
+    mPassCommandBuffers.clear();
+}
+
+void CommandRecorder::EndPass(VkCommandBuffer primaryCb)
+{
+    assert(mPassActive);
+
+    EndMainSecondary();
+
+    if (mPassCommandBuffers.size() > 0)
+    {
+        vkCmdExecuteCommands(primaryCb, uint32_t(mPassCommandBuffers.size()), mPassCommandBuffers.data());
+    }
+
+    mPassCommandBuffers.clear();
+    mPassActive = false;
+    mRenderPass = VK_NULL_HANDLE;
+    mFramebuffer = VK_NULL_HANDLE;
+
+    // Nothing recorded in the secondaries stays bound in the primary.
+    mThreadStates[0].mBoundPipeline = nullptr;
+}
+
+bool CommandRecorder::IsEnabled() const
+{
+    return mThreads.size() > 0;
+}
+
+bool CommandRecorder::IsPassActive() const
+{
+    return mPassActive;
+}
+
+VkCommandBuffer CommandRecorder::GetCommandBuffer()
+{
+    RecordThreadState& state = mThreadStates[sRecordThreadIndex];
+
+    if (mPassActive &&
+        state.mCommandBuffer == VK_NULL_HANDLE)
+    {
+        // Jobs always have a command buffer, so this is the main thread recording between draw lists.
+        assert(sRecordThreadIndex == 0);
+        state.mCommandBuffer = BeginSecondary(0);
+    }
+
+    return state.mCommandBuffer;
+}
+
+RecordThreadState& CommandRecorder::GetThreadState()
+{
+    return mThreadStates[sRecordThreadIndex];
+}
+
+void CommandRecorder::RecordDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId)
+{
+    uint32_t numDraws = uint32_t(drawData.size());
+    uint32_t numJobs = glm::min<uint32_t>(numDraws / RECORD_MIN_DRAWS_PER_JOB, uint32_t(mThreads.size()) + 1);
+
+    if (!mPassActive || numJobs <= 1)
+    {
+        RecordRange(drawData, 0, numDraws, pipelineId);
+        return;
+    }
+
+    // Do all of the lazy per-frame updates (uniforms, descriptor writes) here, so the jobs only read shared state.
+    GetVulkanContext()->GetGlobalDescriptorSet()->Refresh();
+
+    for (uint32_t i = 0; i < numDraws; ++i)
+    {
+        PrepareDrawResources(drawData[i].mComponent, drawData[i].mMaterial);
+    }
+
+    // The jobs' commands need to execute after what the main thread has recorded so far.
+    EndMainSecondary();
+
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+
+        mJobs.resize(numJobs);
+        uint32_t drawsPerJob = (numDraws + numJobs - 1) / numJobs;
+
+        for (uint32_t j = 0; j < numJobs; ++j)
+        {
+            RecordJob& job = mJobs[j];
+            job.mTask = nullptr;
+            job.mDrawData = &drawData;
+            job.mBegin = glm::min(j * drawsPerJob, numDraws);
+            job.mEnd = glm::min(job.mBegin + drawsPerJob, numDraws);
+            job.mPipelineId = pipelineId;
+            job.mCommandBuffer = VK_NULL_HANDLE;
+        }
+
+        mNextJob = 0;
+        mJobsRemaining = numJobs;
+    }
+
+    DispatchJobs();
+
+    // Execute in draw list order, regardless of which job finished first.
+    for (uint32_t j = 0; j < numJobs; ++j)
+    {
+        assert(mJobs[j].mCommandBuffer != VK_NULL_HANDLE);
+        mPassCommandBuffers.push_back(mJobs[j].mCommandBuffer);
+    }
+
+    {
+        // Workers read mJobs.size() in their wait predicate.
+        std::lock_guard<std::mutex> lock(mJobMutex);
+        mJobs.clear();
+        mNextJob = 0;
+    }
+}
+
+void CommandRecorder::RunTasks(uint32_t count, uint32_t minPerJob, const RecordTaskFunc& task)
+{
+    uint32_t numJobs = glm::min<uint32_t>(count / glm::max<uint32_t>(minPerJob, 1), uint32_t(mThreads.size()) + 1);
+
+    if (numJobs <= 1)
+    {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+
+        mJobs.resize(numJobs);
+        uint32_t itemsPerJob = (count + numJobs - 1) / numJobs;
+
+        for (uint32_t j = 0; j < numJobs; ++j)
+        {
+            RecordJob& job = mJobs[j];
+            job = RecordJob();
+            job.mTask = &task;
+            job.mBegin = glm::min(j * itemsPerJob, count);
+            job.mEnd = glm::min(job.mBegin + itemsPerJob, count);
+        }
+
+        mNextJob = 0;
+        mJobsRemaining = numJobs;
+    }
+
+    DispatchJobs();
+
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+        mJobs.clear();
+        mNextJob = 0;
+    }
+}
+
+void CommandRecorder::WorkerThreadFunc(CommandRecorder* recorder, uint32_t threadIndex)
+{
+    sRecordThreadIndex = threadIndex;
+
+    while (true)
+    {
+        uint32_t jobIndex = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(recorder->mJobMutex);
+            recorder->mJobCondition.wait(lock, [recorder]() { return recorder->mExit || recorder->mNextJob < recorder->mJobs.size(); });
+
+            if (recorder->mExit)
+            {
+                break;
+            }
+
+            jobIndex = recorder->mNextJob++;
+        }
+
+        recorder->RunJob(jobIndex, threadIndex);
+    }
+}
+
+void CommandRecorder::RecordRange(const std::vector<DrawData>& drawData, uint32_t begin, uint32_t end, PipelineId pipelineId)
+{
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        if (pipelineId != PipelineId::Count)
+        {
+            GFX_BindPipeline(pipelineId, drawData[i].mComponent->GetVertexType());
+        }
+
+        drawData[i].mComponent->Render();
+    }
+}
+
+VkCommandBuffer CommandRecorder::BeginSecondary(uint32_t threadIndex)
+{
+    VkDevice device = GetVulkanDevice();
+    uint32_t frameIndex = GetFrameIndex();
+    std::vector<VkCommandBuffer>& secondaries = mSecondaries[frameIndex][threadIndex];
+    uint32_t& numUsed = mNumSecondariesUsed[frameIndex][threadIndex];
+
+    if (numUsed >= secondaries.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = mCommandPools[frameIndex][threadIndex];
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer newCb = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(device, &allocInfo, &newCb) != VK_SUCCESS)
+        {
+            LogError("Failed to allocate secondary command buffer");
+            assert(0);
+        }
+
+        SetDebugObjectName(VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)newCb, "SecondaryCommandBuffer");
+        secondaries.push_back(newCb);
+    }
+
+    VkCommandBuffer cb = secondaries[numUsed++];
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = mRenderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = mFramebuffer;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    vkBeginCommandBuffer(cb, &beginInfo);
+
+    // Dynamic state and bindings aren't inherited from the primary.
+    VkViewport viewport = GetVulkanContext()->GetViewport();
+    VkRect2D scissor = GetVulkanContext()->GetScissor();
+    vkCmdSetViewport(cb, 0, 1, &viewport);
+    vkCmdSetScissor(cb, 0, 1, &scissor);
+
+    mThreadStates[threadIndex].mBoundPipeline = nullptr;
+
+    return cb;
+}
+
+void CommandRecorder::EndMainSecondary()
+{
+    RecordThreadState& state = mThreadStates[0];
+
+    if (state.mCommandBuffer != VK_NULL_HANDLE)
+    {
+        vkEndCommandBuffer(state.mCommandBuffer);
+        mPassCommandBuffers.push_back(state.mCommandBuffer);
+        state.mCommandBuffer = VK_NULL_HANDLE;
+    }
+}
+
+void CommandRecorder::DispatchJobs()
+{
+    mJobCondition.notify_all();
+
+    // Help out instead of idling until the workers are done.
+    while (true)
+    {
+        uint32_t jobIndex = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mJobMutex);
+
+            if (mNextJob >= mJobs.size())
+            {
+                break;
+            }
+
+            jobIndex = mNextJob++;
+        }
+
+        RunJob(jobIndex, 0);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mJobMutex);
+        mDoneCondition.wait(lock, [this]() { return mJobsRemaining == 0; });
+    }
+}
+
+void CommandRecorder::RunJob(uint32_t jobIndex, uint32_t threadIndex)
+{
+    // mJobs isn't resized until every job has finished, so this reference stays valid.
+    RecordJob& job = mJobs[jobIndex];
+
+    if (job.mTask != nullptr)
+    {
+        (*job.mTask)(job.mBegin, job.mEnd);
+    }
+    else
+    {
+        RecordThreadState& state = mThreadStates[threadIndex];
+
+        assert(state.mCommandBuffer == VK_NULL_HANDLE);
+        state.mCommandBuffer = BeginSecondary(threadIndex);
+
+        RecordRange(*job.mDrawData, job.mBegin, job.mEnd, job.mPipelineId);
+
+        vkEndCommandBuffer(state.mCommandBuffer);
+        job.mCommandBuffer = state.mCommandBuffer;
+        state.mCommandBuffer = VK_NULL_HANDLE;
+    }
+
+    bool lastJob = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex);
+        lastJob = (--mJobsRemaining == 0);
+    }
+
+    if (lastJob)
+    {
+        mDoneCondition.notify_one();
+    }
+}
+
+#endif
@@ -60,15 +60,19 @@ void DescriptorSet::UpdateUniformDescriptor(int32_t binding, UniformBuffer* unif
     MarkDirty();
 }
 
+void DescriptorSet::UpdateStorageDescriptor(int32_t binding, UniformBuffer* storageBuffer)
+{
+    assert(binding >= 0 && binding < MAX_DESCRIPTORS_PER_SET);
+    mBindings[binding].mType = DescriptorType::Storage;
+    mBindings[binding].mObject = storageBuffer;
+    MarkDirty();
+}
+
 void DescriptorSet::Bind(VkCommandBuffer cb, uint32_t index, VkPipelineLayout pipelineLayout)
 {
     uint32_t frameIndex = GetFrameIndex();
 
-    if (mDirty[frameIndex])
-    {
-        RefreshBindings(frameIndex);
-        mDirty[frameIndex] = false;
-    }
+    Refresh();
 
     vkCmdBindDescriptorSets(
         cb,
@@ -81,6 +85,17 @@ void DescriptorSet::Bind(VkCommandBuffer cb, uint32_t index, VkPipelineLayout pi
         nullptr);
 }
 
+void DescriptorSet::Refresh()
+{
+    uint32_t frameIndex = GetFrameIndex();
+
+    if (mDirty[frameIndex])
+    {
+        RefreshBindings(frameIndex);
+        mDirty[frameIndex] = false;
+    }
+}
+
 VkDescriptorSet DescriptorSet::Get()
 {
     uint32_t frameIndex = GetVulkanContext()->GetFrameIndex();
@@ -129,7 +144,8 @@ void DescriptorSet::RefreshBindings(uint32_t frameIndex)
 
                 vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
             }
-            else if (binding.mType == DescriptorType::Uniform)
+            else if (binding.mType == DescriptorType::Uniform ||
+                     binding.mType == DescriptorType::Storage)
             {
                 UniformBuffer* uniformBuffer = reinterpret_cast<UniformBuffer*>(binding.mObject);
 
@@ -143,7 +159,7 @@ void DescriptorSet::RefreshBindings(uint32_t frameIndex)
                 descriptorWrite.dstSet = mDescriptorSets[frameIndex];
                 descriptorWrite.dstBinding = i;
                 descriptorWrite.dstArrayElement = 0;
-                descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                descriptorWrite.descriptorType = (binding.mType == DescriptorType::Storage) ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
                 descriptorWrite.descriptorCount = 1;
                 descriptorWrite.pBufferInfo = &bufferInfo;
 
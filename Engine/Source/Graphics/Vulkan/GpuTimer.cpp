@@ -0,0 +1,185 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/GpuTimer.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+
+#include "Profiler.h"
+#include "Log.h"
+
+#include <assert.h>
+#include <string.h>
+
+void GpuTimer::Create(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex)
+{
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    uint32_t validBits = (queueFamilyIndex < queueFamilyCount) ? queueFamilies[queueFamilyIndex].timestampValidBits : 0;
+
+    if (validBits == 0 ||
+        deviceProperties.limits.timestampPeriod <= 0.0f)
+    {
+        LogWarning("Timestamp queries not supported, GPU stats disabled");
+        return;
+    }
+
+    mTimestampMask = (validBits >= 64) ? UINT64_MAX : ((uint64_t(1) << validBits) - 1);
+    mTimestampPeriod = deviceProperties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo ciQueryPool = {};
+    ciQueryPool.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    ciQueryPool.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    ciQueryPool.queryCount = GPU_TIMER_MAX_QUERIES;
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        if (vkCreateQueryPool(GetVulkanDevice(), &ciQueryPool, nullptr, &mQueryPools[i]) != VK_SUCCESS)
+        {
+            LogError("Failed to create timestamp query pool");
+            assert(0);
+        }
+
+        mScopes[i].reserve(GPU_TIMER_MAX_SCOPES);
+    }
+}
+
+void GpuTimer::Destroy()
+{
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        if (mQueryPools[i] != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(GetVulkanDevice(), mQueryPools[i], nullptr);
+            mQueryPools[i] = VK_NULL_HANDLE;
+        }
+
+        mScopes[i].clear();
+    }
+
+    mScopeStack.clear();
+}
+
+void GpuTimer::BeginFrame(VkCommandBuffer cb)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    uint32_t frameIndex = GetFrameIndex();
+
+    ReadResults(frameIndex);
+
+    if (mScopeStack.size() > 0)
+    {
+        LogWarning("GPU stat scope was not ended last frame");
+        mScopeStack.clear();
+    }
+
+    mScopes[frameIndex].clear();
+    vkCmdResetQueryPool(cb, mQueryPools[frameIndex], 0, GPU_TIMER_MAX_QUERIES);
+}
+
+void GpuTimer::BeginScope(VkCommandBuffer cb, const char* name)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    uint32_t frameIndex = GetFrameIndex();
+    std::vector<GpuTimerScope>& scopes = mScopes[frameIndex];
+    uint32_t scopeIndex = GPU_TIMER_INVALID_SCOPE;
+
+    // Out of queries just drops the scope. Its end still has to be matched, so push it either way.
+    if (scopes.size() < GPU_TIMER_MAX_SCOPES)
+    {
+        scopeIndex = (uint32_t)scopes.size();
+        scopes.push_back(GpuTimerScope());
+        strncpy(scopes.back().mName, name, STAT_NAME_LENGTH);
+
+        vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, mQueryPools[frameIndex], scopeIndex * 2);
+    }
+
+    mScopeStack.push_back(scopeIndex);
+}
+
+void GpuTimer::EndScope(VkCommandBuffer cb)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    assert(mScopeStack.size() > 0);
+
+    if (mScopeStack.size() > 0)
+    {
+        uint32_t scopeIndex = mScopeStack.back();
+        mScopeStack.pop_back();
+
+        if (scopeIndex != GPU_TIMER_INVALID_SCOPE)
+        {
+            vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, mQueryPools[GetFrameIndex()], scopeIndex * 2 + 1);
+        }
+    }
+}
+
+bool GpuTimer::IsEnabled() const
+{
+    return mQueryPools[0] != VK_NULL_HANDLE;
+}
+
+void GpuTimer::ReadResults(uint32_t frameIndex)
+{
+    std::vector<GpuTimerScope>& scopes = mScopes[frameIndex];
+    uint32_t numQueries = (uint32_t)scopes.size() * 2;
+
+    if (numQueries == 0 ||
+        GetProfiler() == nullptr)
+    {
+        return;
+    }
+
+    // Each query returns its timestamp followed by its availability. A scope that was never ended
+    // leaves its end query unavailable, so only that scope is skipped instead of the whole frame.
+    uint64_t results[GPU_TIMER_MAX_QUERIES * 2];
+
+    VkResult result = vkGetQueryPoolResults(
+        GetVulkanDevice(),
+        mQueryPools[frameIndex],
+        0,
+        numQueries,
+        sizeof(results),
+        results,
+        sizeof(uint64_t) * 2,
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    if (result != VK_SUCCESS &&
+        result != VK_NOT_READY)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < scopes.size(); ++i)
+    {
+        const uint64_t* begin = &results[i * 4];
+        const uint64_t* end = &results[i * 4 + 2];
+
+        if (begin[1] != 0 &&
+            end[1] != 0)
+        {
+            uint64_t ticks = (end[0] - begin[0]) & mTimestampMask;
+            float timeMs = float(double(ticks) * mTimestampPeriod / 1000000.0);
+            GetProfiler()->AddGpuStatTime(scopes[i].mName, timeMs);
+        }
+    }
+}
+
+#endif
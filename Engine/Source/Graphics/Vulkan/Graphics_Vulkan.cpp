@@ -3,6 +3,7 @@
 #include "Graphics/Graphics.h"
 #include "Graphics/Vulkan/VulkanContext.h"
 #include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/Allocator.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -67,6 +68,11 @@ void GFX_SetScissor(int32_t x, int32_t y, int32_t width, int32_t height)
     gVulkanContext->SetScissor(x, y, width, height);
 }
 
+void GFX_SetShadowCascade(uint32_t cascade)
+{
+    gVulkanContext->SetShadowCascade(cascade);
+}
+
 glm::mat4 GFX_MakePerspectiveMatrix(float fovyDegrees, float aspectRatio, float zNear, float zFar)
 {
     return glm::perspectiveFov(glm::radians(fovyDegrees), aspectRatio, 1.0f, zNear, zFar);
@@ -97,6 +103,16 @@ void GFX_DrawFullscreen()
     gVulkanContext->DrawFullscreen();
 }
 
+void GFX_RenderDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId)
+{
+    // Pooled static meshes go through indirect draws, whatever is left is recorded per draw.
+    const std::vector<DrawData>& remainingDraws = gVulkanContext->IsIndirectDrawEnabled() ?
+        gVulkanContext->GetIndirectDrawer().RecordDraws(drawData, pipelineId) :
+        drawData;
+
+    gVulkanContext->GetCommandRecorder().RecordDraws(remainingDraws, pipelineId);
+}
+
 void GFX_ResizeWindow()
 {
     if (gVulkanContext != nullptr)
@@ -124,6 +140,48 @@ void GFX_SetFrameRate(int32_t frameRate)
 
 }
 
+void GFX_GetMemoryStats(GpuMemoryStats& outStats)
+{
+    AllocatorStats allStats;
+    Allocator::GetStats(allStats);
+
+    outStats = GpuMemoryStats();
+    outStats.mUsedBytes = allStats.mUsedBytes;
+    outStats.mReservedBytes = allStats.mReservedBytes;
+    outStats.mNumAllocations = allStats.mNumAllocations;
+    outStats.mNumDedicated = allStats.mNumDedicated;
+    outStats.mNumBlocks = allStats.mNumBlocks;
+
+    uint64_t freeBytes = allStats.mReservedBytes - allStats.mUsedBytes;
+    if (freeBytes > 0)
+    {
+        outStats.mFragmentation = 1.0f - float(allStats.mLargestFreeRange) / float(freeBytes);
+    }
+
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(gVulkanContext->GetPhysicalDevice(), &memProperties);
+
+    for (uint32_t t = 0; t < memProperties.memoryTypeCount; ++t)
+    {
+        if (memProperties.memoryTypes[t].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            AllocatorStats typeStats;
+            Allocator::GetStats(typeStats, t);
+            outStats.mHostVisibleBytes += typeStats.mUsedBytes;
+        }
+    }
+}
+
+void GFX_BeginGpuStat(const char* name)
+{
+    gVulkanContext->BeginGpuStat(name);
+}
+
+void GFX_EndGpuStat()
+{
+    gVulkanContext->EndGpuStat();
+}
+
 void GFX_CreateTextureResource(Texture* texture, std::vector<uint8_t>& data)
 {
     CreateTextureResource(texture, data.data());
@@ -234,49 +292,51 @@ void GFX_DrawParticleComp(ParticleComponent* particleComp)
     DrawParticleComp(particleComp);
 }
 
+// Quads and text don't own any GPU resources on Vulkan.
+// Their vertices are gathered by the UiBatcher when they are drawn.
 void GFX_CreateQuadResource(Quad* quad)
 {
-    CreateQuadResource(quad);
+
 }
 
 void GFX_DestroyQuadResource(Quad* quad)
 {
-    DestroyQuadResource(quad);
+
 }
 
 void GFX_UpdateQuadResource(Quad* quad)
 {
-    UpdateQuadResource(quad);
+
 }
 
 void GFX_DrawQuad(Quad* quad)
 {
-    DrawQuad(quad);
+    GetVulkanContext()->GetUiBatcher().AddQuad(quad);
 }
 
 void GFX_CreateTextResource(Text* text)
 {
-    CreateTextResource(text);
+
 }
 
 void GFX_DestroyTextResource(Text* text)
 {
-    DestroyTextResource(text);
+
 }
 
 void GFX_UpdateTextResourceUniformData(Text* text)
 {
-    UpdateTextResourceUniformData(text);
+
 }
 
 void GFX_UpdateTextResourceVertexData(Text* text)
 {
-    UpdateTextResourceVertexData(text);
+
 }
 
 void GFX_DrawText(Text* text)
 {
-    DrawTextWidget(text);
+    GetVulkanContext()->GetUiBatcher().AddText(text);
 }
 
 void GFX_DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& transform, glm::vec4 color)
@@ -159,22 +159,26 @@ VkFormat Image::GetFormat() const
     return mFormat;
 }
 
-void Image::Update(const void* srcData)
+void Image::Update(const void* srcData, uint32_t mipLevel)
 {
     assert(srcData != nullptr);
     assert(mImage != VK_NULL_HANDLE);
+    assert(mipLevel < mMipLevels);
+
+    uint32_t mipWidth = glm::max(mWidth >> mipLevel, 1u);
+    uint32_t mipHeight = glm::max(mHeight >> mipLevel, 1u);
 
     uint32_t imageSize = 0;
     if (IsFormatBlockCompressed(mFormat))
     {
         const uint32_t blockSize = 4;
-        uint32_t blockWidth = (mWidth + blockSize - 1) / blockSize;
-        uint32_t blockHeight = (mHeight + blockSize - 1) / blockSize;
+        uint32_t blockWidth = (mipWidth + blockSize - 1) / blockSize;
+        uint32_t blockHeight = (mipHeight + blockSize - 1) / blockSize;
         imageSize = GetFormatBlockSize(mFormat) * blockWidth * blockHeight;
     }
     else
     {
-        imageSize = GetFormatPixelSize(mFormat) * mWidth * mHeight;
+        imageSize = GetFormatPixelSize(mFormat) * mipWidth * mipHeight;
     }
 
     if (imageSize == 0)
@@ -185,14 +189,15 @@ void Image::Update(const void* srcData)
     if (srcData != nullptr &&
         imageSize > 0)
     {
-        Buffer* stagingBuffer = new Buffer(BufferType::Transfer, imageSize, "Staging Buffer", srcData);
+        // Stage first, staging can flush the current upload batch if it runs out of space.
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceSize stagingOffset = 0;
+        GetVulkanContext()->GetUploadQueue().Stage(srcData, imageSize, stagingBuffer, stagingOffset);
 
         VkImageLayout savedLayout = mLayout;
         Transition(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        CopyBufferToImage(stagingBuffer->Get(), mImage, mWidth, mHeight);
+        CopyBufferToImage(stagingBuffer, mImage, mipWidth, mipHeight, mipLevel, stagingOffset);
         Transition(savedLayout != VK_IMAGE_LAYOUT_PREINITIALIZED ? savedLayout : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-        GetDestroyQueue()->Destroy(stagingBuffer);
     }
 }
 
@@ -0,0 +1,263 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/IndirectDrawer.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/Pipeline.h"
+#include "Graphics/Vulkan/UniformBuffer.h"
+#include "Graphics/Vulkan/DescriptorSet.h"
+
+#include "Assets/Material.h"
+#include "Assets/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "EngineTypes.h"
+#include "Renderer.h"
+#include "Log.h"
+
+#include <glm/glm.hpp>
+#include <assert.h>
+
+void IndirectDrawer::Create(VkDescriptorSetLayout layout)
+{
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(GetVulkanContext()->GetPhysicalDevice(), &deviceProperties);
+    mMaxDrawIndirectCount = glm::max<uint32_t>(deviceProperties.limits.maxDrawIndirectCount, 1);
+
+    mDrawBuffer = new UniformBuffer(INDIRECT_MAX_DRAWS * sizeof(IndirectDrawData), "Indirect Draw Data", nullptr, BufferType::Storage);
+    mCommandBuffer = new UniformBuffer(INDIRECT_MAX_COMMANDS * sizeof(VkDrawIndexedIndirectCommand), "Indirect Draw Commands", nullptr, BufferType::Indirect);
+
+    mDescriptorSet = new DescriptorSet(layout);
+    mDescriptorSet->UpdateStorageDescriptor(0, mDrawBuffer);
+
+    mDraws.reserve(INDIRECT_MAX_DRAWS);
+    mCommands.reserve(INDIRECT_MAX_COMMANDS);
+
+    LogDebug("Indirect draws enabled (%d draws, %d commands)", INDIRECT_MAX_DRAWS, INDIRECT_MAX_COMMANDS);
+}
+
+void IndirectDrawer::Destroy()
+{
+    if (mDescriptorSet == nullptr)
+    {
+        return;
+    }
+
+    GetDestroyQueue()->Destroy(mDescriptorSet);
+    GetDestroyQueue()->Destroy(mDrawBuffer);
+    GetDestroyQueue()->Destroy(mCommandBuffer);
+    mDescriptorSet = nullptr;
+    mDrawBuffer = nullptr;
+    mCommandBuffer = nullptr;
+
+    mDraws.clear();
+    mCommands.clear();
+}
+
+void IndirectDrawer::BeginFrame()
+{
+    // The frame's fence has already been waited on, so its buffers can be refilled.
+    mDraws.clear();
+    mCommands.clear();
+    ++mGeneration;
+}
+
+void IndirectDrawer::Flush()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    if (mDraws.size() > 0)
+    {
+        mDrawBuffer->Update(mDraws.data(), mDraws.size() * sizeof(IndirectDrawData));
+    }
+
+    if (mCommands.size() > 0)
+    {
+        mCommandBuffer->Update(mCommands.data(), mCommands.size() * sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+const std::vector<DrawData>& IndirectDrawer::RecordDraws(const std::vector<DrawData>& drawData, PipelineId pipelineId)
+{
+    if (!IsEnabled())
+    {
+        return drawData;
+    }
+
+    Pipeline* bucketPipelines[2] = { };
+    mBucketCommands[0].clear();
+    mBucketCommands[1].clear();
+    mRemainingDraws.clear();
+
+    uint32_t numCommands = uint32_t(mCommands.size());
+
+    for (uint32_t i = 0; i < drawData.size(); ++i)
+    {
+        const DrawData& draw = drawData[i];
+        Pipeline* pipeline = GetIndirectPipeline(draw, pipelineId);
+        uint32_t drawIndex = INDIRECT_MAX_DRAWS;
+
+        if (pipeline != nullptr &&
+            numCommands < INDIRECT_MAX_COMMANDS)
+        {
+            drawIndex = WriteDrawData(static_cast<StaticMeshComponent*>(draw.mComponent), draw.mMaterial);
+        }
+
+        if (drawIndex == INDIRECT_MAX_DRAWS)
+        {
+            mRemainingDraws.push_back(draw);
+            continue;
+        }
+
+        StaticMeshComponent* staticMeshComp = static_cast<StaticMeshComponent*>(draw.mComponent);
+        StaticMesh* mesh = staticMeshComp->GetStaticMesh();
+        const MeshPoolAlloc& poolAlloc = mesh->GetResource()->mPoolAlloc;
+
+        uint32_t lod = glm::min(staticMeshComp->GetLod(), mesh->GetNumLods() - 1);
+        const StaticMeshLod& meshLod = mesh->GetLod(lod);
+
+        VkDrawIndexedIndirectCommand command = {};
+        command.indexCount = meshLod.mNumIndices;
+        command.instanceCount = 1;
+        command.firstIndex = poolAlloc.mFirstIndex + meshLod.mFirstIndex;
+        command.vertexOffset = int32_t(poolAlloc.mVertexOffset);
+        command.firstInstance = drawIndex;
+
+        uint32_t bucket = poolAlloc.mVertexColor ? 1 : 0;
+        bucketPipelines[bucket] = pipeline;
+        mBucketCommands[bucket].push_back(command);
+        ++numCommands;
+    }
+
+    if (mRemainingDraws.size() == drawData.size())
+    {
+        return drawData;
+    }
+
+    for (uint32_t b = 0; b < 2; ++b)
+    {
+        if (mBucketCommands[b].size() > 0)
+        {
+            RecordBucket(bucketPipelines[b], b == 1, mBucketCommands[b]);
+        }
+    }
+
+    return mRemainingDraws;
+}
+
+bool IndirectDrawer::IsEnabled() const
+{
+    return mDescriptorSet != nullptr;
+}
+
+Pipeline* IndirectDrawer::GetIndirectPipeline(const DrawData& draw, PipelineId pipelineId) const
+{
+    // ShadowMeshComponent is a StaticMeshComponent too, but it draws with its own pipelines.
+    if (draw.mComponent == nullptr ||
+        draw.mComponent->InstanceRuntimeId() != StaticMeshComponent::ClassRuntimeId())
+    {
+        return nullptr;
+    }
+
+    StaticMeshComponent* staticMeshComp = static_cast<StaticMeshComponent*>(draw.mComponent);
+    StaticMesh* mesh = staticMeshComp->GetStaticMesh();
+
+    if (mesh == nullptr ||
+        !mesh->GetResource()->mPoolAlloc.IsValid())
+    {
+        return nullptr;
+    }
+
+    Material* material = draw.mMaterial ? draw.mMaterial : Renderer::Get()->GetDefaultMaterial();
+
+    if (material == nullptr ||
+        material->GetResource()->mBindlessIndex == BINDLESS_INVALID_INDEX)
+    {
+        return nullptr;
+    }
+
+    VulkanContext* context = GetVulkanContext();
+    RenderPassId renderPassId = context->GetCurrentRenderPassId();
+
+    if (renderPassId == RenderPassId::Shadows &&
+        pipelineId == PipelineId::Shadow)
+    {
+        return context->GetPipeline(PipelineId::ShadowIndirect);
+    }
+
+    // Blended and depthless materials keep their own pipelines (and their draw order).
+    if (renderPassId == RenderPassId::Forward &&
+        pipelineId == PipelineId::Count &&
+        GetMaterialPipeline(material)->GetId() == PipelineId::Opaque)
+    {
+        return context->GetPipeline(PipelineId::OpaqueIndirect);
+    }
+
+    return nullptr;
+}
+
+uint32_t IndirectDrawer::WriteDrawData(StaticMeshComponent* staticMeshComp, Material* material)
+{
+    StaticMeshCompResource* resource = staticMeshComp->GetResource();
+
+    if (material == nullptr)
+    {
+        material = Renderer::Get()->GetDefaultMaterial();
+    }
+
+    if (material->IsDirty(GetFrameIndex()))
+    {
+        UpdateMaterialResource(material);
+    }
+
+    // Components drawn by several passes (shadow cascades, then forward) share one entry per frame.
+    if (resource->mIndirectGeneration == mGeneration)
+    {
+        return resource->mIndirectDrawIndex;
+    }
+
+    if (mDraws.size() >= INDIRECT_MAX_DRAWS)
+    {
+        return INDIRECT_MAX_DRAWS;
+    }
+
+    mDraws.push_back(IndirectDrawData());
+    IndirectDrawData& data = mDraws.back();
+    WriteStaticMeshCompGeometryData(staticMeshComp, data.mGeometry);
+    data.mMaterialIndex = material->GetResource()->mBindlessIndex;
+
+    resource->mIndirectDrawIndex = uint32_t(mDraws.size() - 1);
+    resource->mIndirectGeneration = mGeneration;
+
+    return resource->mIndirectDrawIndex;
+}
+
+void IndirectDrawer::RecordBucket(Pipeline* pipeline, bool vertexColor, const std::vector<VkDrawIndexedIndirectCommand>& commands)
+{
+    VulkanContext* context = GetVulkanContext();
+    context->BindPipeline(pipeline, vertexColor ? VertexType::VertexColor : VertexType::Vertex);
+
+    VkCommandBuffer cb = GetCommandBuffer();
+    mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout());
+    context->GetMeshPool().Bind(cb, vertexColor);
+
+    // Commands are appended to the frame's list, the offsets are final even though the upload happens in Flush().
+    uint32_t firstCommand = uint32_t(mCommands.size());
+    mCommands.insert(mCommands.end(), commands.begin(), commands.end());
+
+    for (uint32_t i = 0; i < commands.size(); i += mMaxDrawIndirectCount)
+    {
+        uint32_t numDraws = glm::min<uint32_t>(uint32_t(commands.size()) - i, mMaxDrawIndirectCount);
+
+        vkCmdDrawIndexedIndirect(
+            cb,
+            mCommandBuffer->Get(),
+            (firstCommand + i) * sizeof(VkDrawIndexedIndirectCommand),
+            numDraws,
+            sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+#endif
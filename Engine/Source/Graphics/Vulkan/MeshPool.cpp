@@ -0,0 +1,131 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/MeshPool.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/Buffer.h"
+
+#include "Vertex.h"
+#include "Log.h"
+
+#include <assert.h>
+
+void MeshPool::Create()
+{
+    mVertexBuffers[0] = new Buffer(BufferType::Vertex, MESH_POOL_VERTEX_CAPACITY * sizeof(Vertex), "Mesh Pool Vertices", nullptr, false);
+    mVertexBuffers[1] = new Buffer(BufferType::Vertex, MESH_POOL_COLOR_VERTEX_CAPACITY * sizeof(VertexColor), "Mesh Pool Color Vertices", nullptr, false);
+    mIndexBuffer = new Buffer(BufferType::Index, MESH_POOL_INDEX_CAPACITY * sizeof(IndexType), "Mesh Pool Indices", nullptr, false);
+
+    mVertexRanges[0].Init(MESH_POOL_VERTEX_CAPACITY);
+    mVertexRanges[1].Init(MESH_POOL_COLOR_VERTEX_CAPACITY);
+    mIndexRanges.Init(MESH_POOL_INDEX_CAPACITY);
+}
+
+void MeshPool::Destroy()
+{
+    if (mIndexBuffer == nullptr)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        GetDestroyQueue()->Destroy(mVertexBuffers[i]);
+        mVertexBuffers[i] = nullptr;
+    }
+
+    GetDestroyQueue()->Destroy(mIndexBuffer);
+    mIndexBuffer = nullptr;
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        mPendingFrees[i].clear();
+    }
+}
+
+void MeshPool::BeginFrame()
+{
+    std::vector<MeshPoolAlloc>& pendingFrees = mPendingFrees[GetFrameIndex()];
+
+    for (uint32_t i = 0; i < pendingFrees.size(); ++i)
+    {
+        FreeNow(pendingFrees[i]);
+    }
+
+    pendingFrees.clear();
+}
+
+bool MeshPool::Alloc(bool vertexColor, uint32_t numVertices, const void* vertices, uint32_t numIndices, const IndexType* indices, MeshPoolAlloc& outAlloc)
+{
+    outAlloc = MeshPoolAlloc();
+
+    if (mIndexBuffer == nullptr ||
+        numVertices == 0 ||
+        numIndices == 0)
+    {
+        return false;
+    }
+
+    uint32_t poolIndex = vertexColor ? 1 : 0;
+    int32_t vertexNode = mVertexRanges[poolIndex].AllocateNode(numVertices, 1);
+
+    if (vertexNode == -1)
+    {
+        return false;
+    }
+
+    int32_t indexNode = mIndexRanges.AllocateNode(numIndices, 1);
+
+    if (indexNode == -1)
+    {
+        mVertexRanges[poolIndex].FreeNode(vertexNode);
+        return false;
+    }
+
+    outAlloc.mVertexNode = vertexNode;
+    outAlloc.mIndexNode = indexNode;
+    outAlloc.mVertexOffset = uint32_t(mVertexRanges[poolIndex].mNodes[vertexNode].mOffset);
+    outAlloc.mFirstIndex = uint32_t(mIndexRanges.mNodes[indexNode].mOffset);
+    outAlloc.mVertexColor = vertexColor;
+
+    uint32_t vertexSize = vertexColor ? sizeof(VertexColor) : sizeof(Vertex);
+    mVertexBuffers[poolIndex]->Update(vertices, numVertices * vertexSize, outAlloc.mVertexOffset * vertexSize);
+    mIndexBuffer->Update(indices, numIndices * sizeof(IndexType), outAlloc.mFirstIndex * sizeof(IndexType));
+
+    return true;
+}
+
+void MeshPool::Free(MeshPoolAlloc& alloc)
+{
+    if (alloc.IsValid() &&
+        mIndexBuffer != nullptr)
+    {
+        mPendingFrees[GetFrameIndex()].push_back(alloc);
+    }
+
+    alloc = MeshPoolAlloc();
+}
+
+void MeshPool::Bind(VkCommandBuffer cb, bool vertexColor, const MeshPoolAlloc* alloc)
+{
+    VkDeviceSize vertexOffset = 0;
+    VkDeviceSize indexOffset = 0;
+
+    if (alloc != nullptr)
+    {
+        vertexOffset = alloc->mVertexOffset * (vertexColor ? sizeof(VertexColor) : sizeof(Vertex));
+        indexOffset = alloc->mFirstIndex * sizeof(IndexType);
+    }
+
+    VkBuffer vertexBuffer = mVertexBuffers[vertexColor ? 1 : 0]->Get();
+    vkCmdBindVertexBuffers(cb, 0, 1, &vertexBuffer, &vertexOffset);
+    vkCmdBindIndexBuffer(cb, mIndexBuffer->Get(), indexOffset, VK_INDEX_TYPE_UINT32);
+}
+
+void MeshPool::FreeNow(const MeshPoolAlloc& alloc)
+{
+    mVertexRanges[alloc.mVertexColor ? 1 : 0].FreeNode(alloc.mVertexNode);
+    mIndexRanges.FreeNode(alloc.mIndexNode);
+}
+
+#endif
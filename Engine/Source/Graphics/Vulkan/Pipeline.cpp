@@ -12,12 +12,14 @@ using namespace std;
 
 Pipeline::Pipeline() :
     mPipelineLayout(VK_NULL_HANDLE),
+    mBindless(false),
     mName("Pipeline"),
     mPipelineId(PipelineId::Count),
     mRenderpass(VK_NULL_HANDLE),
     mSubpass(0),
     mComputePipeline(false),
     mFragmentShaderPath("Shaders/bin/Forward.frag"),
+    mBindlessMaterials(false),
     mViewportWidth(0),
     mViewportHeight(0),
     mRasterizerDiscard(VK_FALSE),
@@ -29,7 +31,9 @@ Pipeline::Pipeline() :
     mDepthBias(0.0f),
     mDepthTestEnabled(VK_TRUE),
     mDepthWriteEnabled(VK_TRUE),
-    mDepthCompareOp(VK_COMPARE_OP_LESS)
+    mDepthCompareOp(VK_COMPARE_OP_LESS),
+    mPushConstantSize(0),
+    mPushConstantStages(0)
 {
     AddOpaqueBlendAttachmentState();
 }
@@ -248,7 +252,7 @@ void Pipeline::CreateGraphicsPipeline()
         uint32_t pipelineIndex = vertexConfig.mVertexType == VertexType::Max ? 0 : uint32_t(vertexConfig.mVertexType);
 
         if (vkCreateGraphicsPipelines(GetVulkanDevice(),
-            VK_NULL_HANDLE,
+            GetVulkanContext()->GetPipelineCache(),
             1,
             &ciPipeline,
             nullptr,
@@ -297,7 +301,7 @@ void Pipeline::CreateComputePipeline()
     mPipelines.resize(1, VK_NULL_HANDLE);
 
     if (vkCreateComputePipelines(device,
-        VK_NULL_HANDLE,
+        GetVulkanContext()->GetPipelineCache(),
         1,
         &ci,
         nullptr,
@@ -317,6 +321,20 @@ void Pipeline::Create(VkRenderPass renderPass)
     assert(mRenderpass != VK_NULL_HANDLE);
     assert(mPipelineId != PipelineId::Count);
 
+    mBindless = mBindlessMaterials && GetVulkanContext()->IsBindlessEnabled();
+
+    if (mBindless)
+    {
+        if (mBindlessFragmentShaderPath != "")
+        {
+            mFragmentShaderPath = mBindlessFragmentShaderPath;
+        }
+
+        // Replaces the pipeline's own push constants, DrawPushConstants covers the shadow cascade too.
+        mPushConstantSize = sizeof(DrawPushConstants);
+        mPushConstantStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+
     PopulateLayoutBindings();
     CreateDescriptorSetLayouts();
 
@@ -349,6 +367,8 @@ void Pipeline::Destroy()
 
     mDescriptorSetLayouts.clear();
     mLayoutBindings.clear();
+    mLayoutBindingFlags.clear();
+    mLayoutSetFlags.clear();
 }
 
 void Pipeline::BindPipeline(VkCommandBuffer commandBuffer, VertexType vertexType)
@@ -367,6 +387,11 @@ PipelineId Pipeline::GetId() const
     return mPipelineId;
 }
 
+bool Pipeline::IsBindless() const
+{
+    return mBindless;
+}
+
 VkShaderModule Pipeline::CreateShaderModule(const std::vector<char>& code)
 {
     VkDevice device = GetVulkanDevice();
@@ -436,21 +461,52 @@ void Pipeline::AddAdditiveBlendAttachmentState()
     mBlendAttachments.push_back(colorBlendAttachment);
 }
 
-void Pipeline::AddLayoutBinding(VkDescriptorType type, VkShaderStageFlags stageFlags)
+void Pipeline::AddLayoutBinding(VkDescriptorType type, VkShaderStageFlags stageFlags, uint32_t count, VkDescriptorBindingFlagsEXT bindingFlags)
 {
     VkDescriptorSetLayoutBinding layoutBinding = {};
-    layoutBinding.descriptorCount = 1;
+    layoutBinding.descriptorCount = count;
     layoutBinding.descriptorType = type;
     layoutBinding.pImmutableSamplers = nullptr;
     layoutBinding.stageFlags = stageFlags;
     layoutBinding.binding = static_cast<uint32_t>(mLayoutBindings.back().size());
 
     mLayoutBindings.back().push_back(layoutBinding);
+    mLayoutBindingFlags.back().push_back(bindingFlags);
 }
 
-void Pipeline::PushSet()
+void Pipeline::AddMaterialLayoutBindings()
+{
+    if (mBindless)
+    {
+        // Must match the bindless table's descriptor pool, which is created with UPDATE_AFTER_BIND.
+        // Slots are written while earlier frames are still in flight, but never ones those frames use.
+        PushSet(VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT);
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+        AddLayoutBinding(
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            VK_SHADER_STAGE_FRAGMENT_BIT,
+            BINDLESS_MAX_TEXTURES,
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT);
+    }
+    else
+    {
+        PushSet();
+        AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+        // Add texture sampler descriptors for each texture slot
+        for (int32_t i = 0; i < MATERIAL_MAX_TEXTURES; ++i)
+        {
+            AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
+        }
+    }
+}
+
+void Pipeline::PushSet(VkDescriptorSetLayoutCreateFlags flags)
 {
     mLayoutBindings.push_back(std::vector<VkDescriptorSetLayoutBinding>());
+    mLayoutBindingFlags.push_back(std::vector<VkDescriptorBindingFlagsEXT>());
+    mLayoutSetFlags.push_back(flags);
 }
 
 void Pipeline::CreatePipelineLayout()
@@ -462,6 +518,16 @@ void Pipeline::CreatePipelineLayout()
     pipelineLayoutInfo.pushConstantRangeCount = 0;
     pipelineLayoutInfo.pPushConstantRanges = 0;
 
+    VkPushConstantRange pushConstantRange = {};
+    if (mPushConstantSize > 0)
+    {
+        pushConstantRange.stageFlags = mPushConstantStages;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = mPushConstantSize;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    }
+
     if (vkCreatePipelineLayout(GetVulkanDevice(), &pipelineLayoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS)
     {
         LogError("Failed to create pipeline layout!");
@@ -477,6 +543,21 @@ void Pipeline::CreateDescriptorSetLayouts()
         ciDescriptorSetLayout.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         ciDescriptorSetLayout.bindingCount = static_cast<uint32_t>(mLayoutBindings[i].size());
         ciDescriptorSetLayout.pBindings = mLayoutBindings[i].data();
+        ciDescriptorSetLayout.flags = mLayoutSetFlags[i];
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT ciBindingFlags = {};
+        ciBindingFlags.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        ciBindingFlags.bindingCount = static_cast<uint32_t>(mLayoutBindingFlags[i].size());
+        ciBindingFlags.pBindingFlags = mLayoutBindingFlags[i].data();
+
+        for (uint32_t b = 0; b < mLayoutBindingFlags[i].size(); ++b)
+        {
+            if (mLayoutBindingFlags[i][b] != 0)
+            {
+                ciDescriptorSetLayout.pNext = &ciBindingFlags;
+                break;
+            }
+        }
 
         mDescriptorSetLayouts.push_back(VK_NULL_HANDLE);
 
@@ -497,6 +578,7 @@ void Pipeline::PopulateLayoutBindings()
     PushSet();
     AddLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
     AddLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
+    AddLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT);
 }
 
 #endif
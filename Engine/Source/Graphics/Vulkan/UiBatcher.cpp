@@ -0,0 +1,386 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/UiBatcher.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+
+#include "Widgets/Quad.h"
+#include "Widgets/Text.h"
+#include "Assets/Texture.h"
+#include "Assets/Font.h"
+#include "Renderer.h"
+#include "Profiler.h"
+#include "Utilities.h"
+#include "Log.h"
+
+#include <string.h>
+
+static uint32_t ModulateColor(uint32_t color, glm::vec4 tint)
+{
+    glm::vec4 color4 = glm::vec4(
+        float(color & 0xff),
+        float((color >> 8) & 0xff),
+        float((color >> 16) & 0xff),
+        float((color >> 24) & 0xff)) / 255.0f;
+
+    return ColorFloat4ToUint32(color4 * tint);
+}
+
+static bool IsUvInUnitRange(glm::vec2 uv)
+{
+    return (uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f);
+}
+
+void UiBatcher::Create()
+{
+    ImageDesc imageDesc;
+    imageDesc.mWidth = UI_ATLAS_SIZE;
+    imageDesc.mHeight = UI_ATLAS_SIZE;
+    imageDesc.mFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    imageDesc.mUsage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    SamplerDesc samplerDesc;
+    samplerDesc.mMagFilter = VK_FILTER_LINEAR;
+    samplerDesc.mMinFilter = VK_FILTER_LINEAR;
+    samplerDesc.mAddressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    mAtlasImage = new Image(imageDesc, samplerDesc, "UI Atlas");
+    mAtlasImage->Clear(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+}
+
+void UiBatcher::Destroy()
+{
+    mDescriptorSetArena.Destroy();
+
+    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    {
+        if (mVertexBuffers[i] != nullptr)
+        {
+            GetDestroyQueue()->Destroy(mVertexBuffers[i]);
+            mVertexBuffers[i] = nullptr;
+        }
+    }
+
+    if (mAtlasImage != nullptr)
+    {
+        GetDestroyQueue()->Destroy(mAtlasImage);
+        mAtlasImage = nullptr;
+    }
+
+    mAtlasEntries.clear();
+    mVertices.clear();
+    mBatches.clear();
+}
+
+void UiBatcher::BeginFrame()
+{
+    mDescriptorSetArena.Reset();
+    mFrameVertexOffset = 0;
+}
+
+void UiBatcher::SetScissor(const VkRect2D& scissor)
+{
+    // Only recorded here. The scissor is set per batch when the batches are flushed.
+    mScissor = scissor;
+}
+
+void UiBatcher::Flush(VkCommandBuffer cb)
+{
+    if (mBatches.size() == 0)
+        return;
+
+    SCOPED_CPU_STAT("UI Batch");
+
+    // The same buffer may be drawn from by multiple UI passes in a frame (one per view),
+    // so each flush appends after the vertices written by the previous one.
+    uint32_t frameIndex = GetFrameIndex();
+    size_t requiredSize = (mFrameVertexOffset + mVertices.size()) * sizeof(VertexUI);
+
+    if (mVertexBuffers[frameIndex] == nullptr ||
+        mVertexBuffers[frameIndex]->GetSize() < requiredSize)
+    {
+        if (mVertexBuffers[frameIndex] != nullptr)
+        {
+            // Earlier passes this frame still reference the old buffer. The destroy queue keeps it alive.
+            GetDestroyQueue()->Destroy(mVertexBuffers[frameIndex]);
+        }
+
+        size_t newSize = glm::max<size_t>(requiredSize * 2, UI_MIN_VERTEX_BUFFER_VERTS * sizeof(VertexUI));
+        mVertexBuffers[frameIndex] = new Buffer(BufferType::Vertex, newSize, "UI Vertex Stream");
+    }
+
+    Buffer* vertexBuffer = mVertexBuffers[frameIndex];
+    vertexBuffer->Update(mVertices.data(), mVertices.size() * sizeof(VertexUI), mFrameVertexOffset * sizeof(VertexUI));
+
+    Pipeline* uiPipeline = GetVulkanContext()->GetPipeline(PipelineId::Ui);
+    GetVulkanContext()->BindPipeline(uiPipeline, VertexType::VertexUI);
+    VkDescriptorSetLayout layout = uiPipeline->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Ui);
+
+    VkDeviceSize offset = 0;
+    VkBuffer vkBuffer = vertexBuffer->Get();
+    vkCmdBindVertexBuffers(cb, 0, 1, &vkBuffer, &offset);
+
+    Image* boundImage = nullptr;
+    VkRect2D boundScissor = {};
+
+    for (uint32_t i = 0; i < mBatches.size(); ++i)
+    {
+        const UiBatch& batch = mBatches[i];
+
+        if (i == 0 || memcmp(&batch.mScissor, &boundScissor, sizeof(VkRect2D)) != 0)
+        {
+            vkCmdSetScissor(cb, 0, 1, &batch.mScissor);
+            boundScissor = batch.mScissor;
+        }
+
+        if (batch.mImage != boundImage)
+        {
+            DescriptorSet* descriptorSet = mDescriptorSetArena.Alloc(layout);
+            descriptorSet->UpdateImageDescriptor(0, batch.mImage);
+            descriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Ui, uiPipeline->GetPipelineLayout());
+            boundImage = batch.mImage;
+        }
+
+        vkCmdDraw(cb, batch.mNumVertices, 1, mFrameVertexOffset + batch.mFirstVertex, 0);
+    }
+
+    mFrameVertexOffset += uint32_t(mVertices.size());
+    mVertices.clear();
+    mBatches.clear();
+}
+
+void UiBatcher::AddQuad(Quad* quad)
+{
+    Texture* texture = quad->GetTexture();
+    if (texture == nullptr)
+    {
+        texture = Renderer::Get()->mWhiteTexture.Get<Texture>();
+    }
+
+    const VertexUI* srcVertices = quad->GetVertices();
+    const glm::mat3& transform = quad->GetTransform();
+    glm::vec4 tint = quad->GetTint();
+
+    // Tiled UVs rely on the texture's own wrap mode, so those quads can't sample from the atlas.
+    bool unitUvs = true;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        unitUvs = unitUvs && IsUvInUnitRange(srcVertices[i].mTexcoord);
+    }
+
+    const UiAtlasEntry* atlasEntry = unitUvs ? &GetAtlasEntry(texture) : nullptr;
+    bool inAtlas = (atlasEntry != nullptr && atlasEntry->mInAtlas);
+    Image* image = inAtlas ? mAtlasImage : texture->GetResource()->mImage;
+
+    VertexUI quadVertices[4];
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        quadVertices[i].mPosition = glm::vec2(transform * glm::vec3(srcVertices[i].mPosition, 1.0f));
+        quadVertices[i].mTexcoord = inAtlas ?
+            (srcVertices[i].mTexcoord * atlasEntry->mUvScale + atlasEntry->mUvOffset) :
+            srcVertices[i].mTexcoord;
+        quadVertices[i].mColor = ModulateColor(srcVertices[i].mColor, tint);
+    }
+
+    // Quad vertices are laid out as a triangle strip. Batches are triangle lists.
+    static const uint32_t sStripToList[6] = { 0, 1, 2, 2, 1, 3 };
+
+    VertexUI* dstVertices = AllocVertices(image, 6);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        dstVertices[i] = quadVertices[sStripToList[i]];
+    }
+}
+
+void UiBatcher::AddText(Text* text)
+{
+    uint32_t numVertices = text->GetNumVisibleCharacters() * TEXT_VERTS_PER_CHAR;
+
+    if (text->GetText().size() == 0 || numVertices == 0)
+        return;
+
+    Font* font = text->GetFont();
+    Texture* texture = Renderer::Get()->mWhiteTexture.Get<Texture>();
+
+    if (font != nullptr &&
+        font->GetTexture() != nullptr)
+    {
+        texture = font->GetTexture();
+    }
+
+    int32_t fontSize = font ? font->GetSize() : 32;
+    float scale = text->GetScaledSize() / fontSize;
+    glm::vec2 offset = glm::vec2(text->GetRect().mX, text->GetRect().mY);
+    const glm::mat3& transform = text->GetTransform();
+
+    // Glyph UVs always lie within the font texture.
+    const UiAtlasEntry& atlasEntry = GetAtlasEntry(texture);
+    Image* image = atlasEntry.mInAtlas ? mAtlasImage : texture->GetResource()->mImage;
+
+    const VertexUI* srcVertices = text->GetVertices();
+    VertexUI* dstVertices = AllocVertices(image, numVertices);
+
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        glm::vec2 position = srcVertices[i].mPosition * scale + offset;
+        dstVertices[i].mPosition = glm::vec2(transform * glm::vec3(position, 1.0f));
+        dstVertices[i].mTexcoord = atlasEntry.mInAtlas ?
+            (srcVertices[i].mTexcoord * atlasEntry.mUvScale + atlasEntry.mUvOffset) :
+            srcVertices[i].mTexcoord;
+        dstVertices[i].mColor = srcVertices[i].mColor;
+    }
+}
+
+void UiBatcher::RemoveTexture(Texture* texture)
+{
+    // The atlas region is not reclaimed. Textures are rarely destroyed while the UI is using them.
+    mAtlasEntries.erase(texture);
+}
+
+VertexUI* UiBatcher::AllocVertices(Image* image, uint32_t numVertices)
+{
+    bool newBatch = (mBatches.size() == 0);
+
+    if (!newBatch)
+    {
+        const UiBatch& lastBatch = mBatches.back();
+        newBatch = (lastBatch.mImage != image ||
+            memcmp(&lastBatch.mScissor, &mScissor, sizeof(VkRect2D)) != 0);
+    }
+
+    if (newBatch)
+    {
+        UiBatch batch;
+        batch.mImage = image;
+        batch.mScissor = mScissor;
+        batch.mFirstVertex = uint32_t(mVertices.size());
+        mBatches.push_back(batch);
+    }
+
+    mBatches.back().mNumVertices += numVertices;
+
+    size_t firstVertex = mVertices.size();
+    mVertices.resize(firstVertex + numVertices);
+    return &mVertices[firstVertex];
+}
+
+const UiAtlasEntry& UiBatcher::GetAtlasEntry(Texture* texture)
+{
+    auto it = mAtlasEntries.find(texture);
+
+    if (it == mAtlasEntries.end())
+    {
+        UiAtlasEntry entry;
+
+        if (CanUseAtlas(texture))
+        {
+            entry.mInAtlas = InsertIntoAtlas(texture, entry);
+        }
+
+        it = mAtlasEntries.insert({ texture, entry }).first;
+    }
+
+    return it->second;
+}
+
+bool UiBatcher::CanUseAtlas(Texture* texture) const
+{
+    Image* image = texture->GetResource()->mImage;
+
+    // The atlas has no mips and is always sampled linearly.
+    return (image != nullptr &&
+        image->GetFormat() == VK_FORMAT_R8G8B8A8_UNORM &&
+        texture->GetFilterType() == FilterType::Linear &&
+        !texture->IsRenderTarget() &&
+        texture->GetLayers() == 1 &&
+        texture->GetWidth() <= UI_ATLAS_MAX_TEXTURE_SIZE &&
+        texture->GetHeight() <= UI_ATLAS_MAX_TEXTURE_SIZE);
+}
+
+bool UiBatcher::InsertIntoAtlas(Texture* texture, UiAtlasEntry& outEntry)
+{
+    uint32_t width = texture->GetWidth();
+    uint32_t height = texture->GetHeight();
+    uint32_t paddedWidth = width + UI_ATLAS_PADDING * 2;
+    uint32_t paddedHeight = height + UI_ATLAS_PADDING * 2;
+
+    // Simple shelf packing. Space is never reclaimed, so when the atlas fills up
+    // any further textures are drawn directly from their own image.
+    if (mShelfX + paddedWidth > UI_ATLAS_SIZE)
+    {
+        mShelfX = 0;
+        mShelfY += mShelfHeight;
+        mShelfHeight = 0;
+    }
+
+    if (mShelfY + paddedHeight > UI_ATLAS_SIZE)
+    {
+        LogDebug("UI atlas is full. %s will be drawn in its own batch.", texture->GetName().c_str());
+        return false;
+    }
+
+    int32_t x = int32_t(mShelfX + UI_ATLAS_PADDING);
+    int32_t y = int32_t(mShelfY + UI_ATLAS_PADDING);
+    int32_t w = int32_t(width);
+    int32_t h = int32_t(height);
+
+    mShelfX += paddedWidth;
+    mShelfHeight = glm::max(mShelfHeight, paddedHeight);
+
+    // Copy the texture into its slot, then replicate the edge texels into the padding
+    // so that linear filtering near the edges behaves like clamp-to-edge.
+    struct CopyRect { int32_t mSrcX, mSrcY, mDstX, mDstY, mWidth, mHeight; };
+    const CopyRect copyRects[] =
+    {
+        { 0,     0,     x,     y,     w, h },
+        { 0,     0,     x - 1, y,     1, h },
+        { w - 1, 0,     x + w, y,     1, h },
+        { 0,     0,     x,     y - 1, w, 1 },
+        { 0,     h - 1, x,     y + h, w, 1 },
+        { 0,     0,     x - 1, y - 1, 1, 1 },
+        { w - 1, 0,     x + w, y - 1, 1, 1 },
+        { 0,     h - 1, x - 1, y + h, 1, 1 },
+        { w - 1, h - 1, x + w, y + h, 1, 1 },
+    };
+
+    VkImageCopy regions[OCT_ARRAY_SIZE(copyRects)] = {};
+
+    for (uint32_t i = 0; i < OCT_ARRAY_SIZE(copyRects); ++i)
+    {
+        regions[i].srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        regions[i].srcSubresource.mipLevel = 0;
+        regions[i].srcSubresource.baseArrayLayer = 0;
+        regions[i].srcSubresource.layerCount = 1;
+        regions[i].srcOffset = { copyRects[i].mSrcX, copyRects[i].mSrcY, 0 };
+        regions[i].dstSubresource = regions[i].srcSubresource;
+        regions[i].dstOffset = { copyRects[i].mDstX, copyRects[i].mDstY, 0 };
+        regions[i].extent = { uint32_t(copyRects[i].mWidth), uint32_t(copyRects[i].mHeight), 1 };
+    }
+
+    Image* srcImage = texture->GetResource()->mImage;
+    VkCommandBuffer cb = BeginCommandBuffer();
+
+    srcImage->Transition(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cb);
+    mAtlasImage->Transition(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cb);
+
+    vkCmdCopyImage(
+        cb,
+        srcImage->Get(),
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        mAtlasImage->Get(),
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        OCT_ARRAY_SIZE(regions),
+        regions);
+
+    srcImage->Transition(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cb);
+    mAtlasImage->Transition(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cb);
+
+    EndCommandBuffer(cb);
+
+    outEntry.mUvOffset = glm::vec2(float(x), float(y)) / float(UI_ATLAS_SIZE);
+    outEntry.mUvScale = glm::vec2(float(w), float(h)) / float(UI_ATLAS_SIZE);
+
+    return true;
+}
+
+#endif
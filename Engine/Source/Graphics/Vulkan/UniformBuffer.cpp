@@ -4,11 +4,11 @@
 #include "Graphics/Vulkan/VulkanUtils.h"
 #include "Graphics/Vulkan/DestroyQueue.h"
 
-UniformBuffer::UniformBuffer(size_t size, const char* debugName, const void* srcData)
+UniformBuffer::UniformBuffer(size_t size, const char* debugName, const void* srcData, BufferType type)
 {
     for (uint32_t i = 0; i < MAX_FRAMES; ++i)
     {
-        mBuffers[i] = new Buffer(BufferType::Uniform, size, debugName, srcData, true);
+        mBuffers[i] = new Buffer(type, size, debugName, srcData, true);
     }
 }
 
@@ -0,0 +1,181 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/UniformRingBuffer.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/Buffer.h"
+
+#include "Log.h"
+
+#include <assert.h>
+
+void UniformRingBuffer::Create(VkDescriptorSetLayout layout, uint32_t range, const char* debugName)
+{
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(GetVulkanContext()->GetPhysicalDevice(), &deviceProperties);
+
+    mLayout = layout;
+    mRange = range;
+    mDebugName = debugName;
+    mAlignment = glm::max<uint32_t>(uint32_t(deviceProperties.limits.minUniformBufferOffsetAlignment), 16);
+    mFrameIndex = GetFrameIndex();
+    mBlockIndex = 0;
+
+    assert(mRange <= deviceProperties.limits.maxUniformBufferRange);
+    assert(mRange <= UNIFORM_RING_BLOCK_SIZE);
+}
+
+void UniformRingBuffer::Destroy()
+{
+    VkDevice device = GetVulkanDevice();
+    VkDescriptorPool pool = GetVulkanContext()->GetDescriptorPool();
+
+    for (uint32_t f = 0; f < MAX_FRAMES; ++f)
+    {
+        for (uint32_t i = 0; i < mBlocks[f].size(); ++i)
+        {
+            GetDestroyQueue()->Destroy(mBlocks[f][i].mBuffer);
+            vkFreeDescriptorSets(device, pool, 1, &mBlocks[f][i].mDescriptorSet);
+        }
+
+        mBlocks[f].clear();
+    }
+}
+
+void UniformRingBuffer::BeginFrame()
+{
+    // The frame's fence has already been waited on, so everything in these blocks can be overwritten.
+    mFrameIndex = GetFrameIndex();
+    mBlockIndex = 0;
+    ++mGeneration;
+
+    std::vector<UniformRingBlock>& blocks = mBlocks[mFrameIndex];
+    for (uint32_t i = 0; i < blocks.size(); ++i)
+    {
+        blocks[i].mUsed = 0;
+        blocks[i].mFlushed = 0;
+    }
+}
+
+void UniformRingBuffer::Flush()
+{
+    std::vector<UniformRingBlock>& blocks = mBlocks[mFrameIndex];
+
+    for (uint32_t i = 0; i < blocks.size() && i <= mBlockIndex; ++i)
+    {
+        UniformRingBlock& block = blocks[i];
+
+        if (block.mUsed > block.mFlushed)
+        {
+            block.mBuffer->Update(block.mData.data() + block.mFlushed, block.mUsed - block.mFlushed, block.mFlushed);
+            block.mFlushed = block.mUsed;
+        }
+    }
+}
+
+void UniformRingBuffer::Invalidate()
+{
+    ++mGeneration;
+}
+
+void* UniformRingBuffer::Alloc(uint32_t size, UniformRingAlloc& outAlloc)
+{
+    assert(size <= mRange);
+    std::vector<UniformRingBlock>& blocks = mBlocks[mFrameIndex];
+
+    if (mBlockIndex >= blocks.size())
+    {
+        AddBlock();
+    }
+
+    // The descriptor covers mRange bytes, so that much needs to fit behind every offset.
+    uint32_t offset = (blocks[mBlockIndex].mUsed + mAlignment - 1) & ~(mAlignment - 1);
+
+    if (offset + mRange > UNIFORM_RING_BLOCK_SIZE)
+    {
+        ++mBlockIndex;
+        if (mBlockIndex >= blocks.size())
+        {
+            AddBlock();
+        }
+
+        offset = 0;
+    }
+
+    UniformRingBlock& block = blocks[mBlockIndex];
+    block.mUsed = offset + size;
+
+    outAlloc.mBlock = mBlockIndex;
+    outAlloc.mOffset = offset;
+    outAlloc.mGeneration = mGeneration;
+
+    return block.mData.data() + offset;
+}
+
+bool UniformRingBuffer::IsCurrent(const UniformRingAlloc& alloc) const
+{
+    return alloc.mGeneration == mGeneration;
+}
+
+void UniformRingBuffer::Bind(VkCommandBuffer cb, uint32_t setIndex, VkPipelineLayout pipelineLayout, const UniformRingAlloc& alloc)
+{
+    assert(IsCurrent(alloc));
+    const UniformRingBlock& block = mBlocks[mFrameIndex][alloc.mBlock];
+
+    vkCmdBindDescriptorSets(
+        cb,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pipelineLayout,
+        setIndex,
+        1,
+        &block.mDescriptorSet,
+        1,
+        &alloc.mOffset);
+}
+
+UniformRingBlock& UniformRingBuffer::AddBlock()
+{
+    VkDevice device = GetVulkanDevice();
+    std::vector<UniformRingBlock>& blocks = mBlocks[mFrameIndex];
+
+    blocks.push_back(UniformRingBlock());
+    UniformRingBlock& block = blocks.back();
+
+    block.mBuffer = new Buffer(BufferType::Uniform, UNIFORM_RING_BLOCK_SIZE, mDebugName);
+    block.mData.resize(UNIFORM_RING_BLOCK_SIZE);
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = GetVulkanContext()->GetDescriptorPool();
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &mLayout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &block.mDescriptorSet) != VK_SUCCESS)
+    {
+        LogError("Failed to allocate uniform ring descriptor set");
+        assert(0);
+    }
+
+    // The set never changes, only the dynamic offset passed to Bind() does.
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = block.mBuffer->Get();
+    bufferInfo.offset = 0;
+    bufferInfo.range = mRange;
+
+    VkWriteDescriptorSet descriptorWrite = {};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = block.mDescriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+
+    LogDebug("Uniform ring %s grew to %d blocks for frame %d", mDebugName, int32_t(blocks.size()), int32_t(mFrameIndex));
+
+    return block;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#if API_VULKAN
+
+#include "Graphics/Vulkan/UploadQueue.h"
+#include "Graphics/Vulkan/VulkanContext.h"
+#include "Graphics/Vulkan/VulkanUtils.h"
+#include "Graphics/Vulkan/Buffer.h"
+
+#include "Log.h"
+
+#include <assert.h>
+
+void UploadQueue::Create()
+{
+    VkDevice device = GetVulkanDevice();
+
+    for (uint32_t i = 0; i < UPLOAD_BATCH_COUNT; ++i)
+    {
+        UploadBatch& batch = mBatches[i];
+
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = GetVulkanContext()->GetCommandPool();
+        allocInfo.commandBufferCount = 1;
+
+        if (vkAllocateCommandBuffers(device, &allocInfo, &batch.mCommandBuffer) != VK_SUCCESS)
+        {
+            LogError("Failed to allocate upload command buffer");
+            assert(0);
+        }
+
+        // Start signaled so the first use of each batch doesn't wait.
+        VkFenceCreateInfo ciFence = {};
+        ciFence.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        ciFence.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        if (vkCreateFence(device, &ciFence, nullptr, &batch.mFence) != VK_SUCCESS)
+        {
+            LogError("Failed to create upload fence");
+            assert(0);
+        }
+
+        batch.mStagingBuffer = new Buffer(BufferType::Transfer, UPLOAD_STAGING_SIZE, "Upload Staging");
+        batch.mStagingUsed = 0;
+        batch.mRecording = false;
+    }
+
+    mBatchIndex = 0;
+}
+
+void UploadQueue::Destroy()
+{
+    VkDevice device = GetVulkanDevice();
+
+    Flush();
+
+    for (uint32_t i = 0; i < UPLOAD_BATCH_COUNT; ++i)
+    {
+        UploadBatch& batch = mBatches[i];
+
+        vkWaitForFences(device, 1, &batch.mFence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(device, batch.mFence, nullptr);
+        vkFreeCommandBuffers(device, GetVulkanContext()->GetCommandPool(), 1, &batch.mCommandBuffer);
+        GetDestroyQueue()->Destroy(batch.mStagingBuffer);
+
+        batch = UploadBatch();
+    }
+}
+
+VkCommandBuffer UploadQueue::GetCommandBuffer()
+{
+    return BeginBatch().mCommandBuffer;
+}
+
+void UploadQueue::Stage(const void* srcData, uint32_t size, VkBuffer& outBuffer, VkDeviceSize& outOffset)
+{
+    if (size > UPLOAD_STAGING_SIZE)
+    {
+        // Too big for the ring, the destroy queue keeps it alive until the frame that uses it has finished.
+        Buffer* stagingBuffer = new Buffer(BufferType::Transfer, size, "Staging Buffer", srcData);
+        GetDestroyQueue()->Destroy(stagingBuffer);
+
+        outBuffer = stagingBuffer->Get();
+        outOffset = 0;
+        return;
+    }
+
+    uint32_t offset = (BeginBatch().mStagingUsed + UPLOAD_STAGING_ALIGNMENT - 1) & ~(UPLOAD_STAGING_ALIGNMENT - 1);
+
+    if (offset + size > UPLOAD_STAGING_SIZE)
+    {
+        // Out of staging space, kick off what we have and continue in the next batch.
+        Flush();
+        offset = 0;
+    }
+
+    UploadBatch& batch = BeginBatch();
+    batch.mStagingBuffer->Update(srcData, size, offset);
+    batch.mStagingUsed = offset + size;
+
+    outBuffer = batch.mStagingBuffer->Get();
+    outOffset = offset;
+}
+
+void UploadQueue::Flush()
+{
+    UploadBatch& batch = mBatches[mBatchIndex];
+
+    if (!batch.mRecording)
+    {
+        return;
+    }
+
+    // Make the uploaded data visible to everything submitted after this batch.
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    vkCmdPipelineBarrier(
+        batch.mCommandBuffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr);
+
+    vkEndCommandBuffer(batch.mCommandBuffer);
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.mCommandBuffer;
+
+    if (vkQueueSubmit(GetVulkanContext()->GetGraphicsQueue(), 1, &submitInfo, batch.mFence) != VK_SUCCESS)
+    {
+        LogError("Failed to submit upload command buffer");
+        assert(0);
+    }
+
+    batch.mRecording = false;
+    mBatchIndex = (mBatchIndex + 1) % UPLOAD_BATCH_COUNT;
+}
+
+UploadBatch& UploadQueue::BeginBatch()
+{
+    UploadBatch& batch = mBatches[mBatchIndex];
+
+    if (!batch.mRecording)
+    {
+        VkDevice device = GetVulkanDevice();
+
+        // Usually long finished, this only blocks if every batch is still in flight.
+        vkWaitForFences(device, 1, &batch.mFence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device, 1, &batch.mFence);
+
+        vkResetCommandBuffer(batch.mCommandBuffer, 0);
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(batch.mCommandBuffer, &beginInfo);
+        SetDebugObjectName(VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)batch.mCommandBuffer, "UploadCommandBuffer");
+
+        batch.mStagingUsed = 0;
+        batch.mRecording = true;
+    }
+
+    return batch;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Utilities.h"
 #include "World.h"
 #include "Renderer.h"
+#include "Stream.h"
 
 #include "Graphics/GraphicsUtils.h"
 
@@ -26,10 +27,15 @@ static uint32_t sNumValidationLayers = 1;
 static const char* sDeviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 static uint32_t sNumDeviceExtensions = 1;
 
+static const char* sBindlessDeviceExtensions[] = { VK_KHR_MAINTENANCE3_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME };
+static uint32_t sNumBindlessDeviceExtensions = 2;
+
 PFN_vkCmdBeginDebugUtilsLabelEXT CmdBeginDebugUtilsLabelEXT = nullptr;
 PFN_vkCmdEndDebugUtilsLabelEXT CmdEndDebugUtilsLabelEXT = nullptr;
 PFN_vkCmdInsertDebugUtilsLabelEXT CmdInsertDebugUtilsLabelEXT = nullptr;
 PFN_vkSetDebugUtilsObjectNameEXT SetDebugUtilsObjectNameEXT = nullptr;
+PFN_vkGetPhysicalDeviceFeatures2KHR GetPhysicalDeviceFeatures2KHR = nullptr;
+PFN_vkGetPhysicalDeviceProperties2KHR GetPhysicalDeviceProperties2KHR = nullptr;
 
 void CreateVulkanContext()
 {
@@ -98,6 +104,10 @@ void VulkanContext::Initialize()
     CreateSwapchain();
     CreateImageViews();
     CreateCommandPool();
+    mUploadQueue.Create();
+    mMeshPool.Create();
+    mCommandRecorder.Create(FindQueueFamilies(mPhysicalDevice).mGraphicsFamily);
+    mGpuTimer.Create(mPhysicalDevice, FindQueueFamilies(mPhysicalDevice).mGraphicsFamily);
 
     CreateShadowMapImage();
     CreateSceneColorImage();
@@ -109,8 +119,19 @@ void VulkanContext::Initialize()
     CreateHitCheck();
 #endif
 
+    CreatePipelineCache();
     CreatePipelines();
 
+    if (mSupportsBindless)
+    {
+        mBindlessTable.Create(GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Material));
+    }
+
+    if (mSupportsIndirectDraws)
+    {
+        mIndirectDrawer.Create(GetPipeline(PipelineId::OpaqueIndirect)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Geometry));
+    }
+
     CreateGlobalDescriptorSet();
     CreatePostProcessDescriptorSet();
     CreateFramebuffers();
@@ -118,6 +139,12 @@ void VulkanContext::Initialize()
     CreateSemaphores();
     CreateFences();
 
+    mUiBatcher.Create();
+    mGeometryRing.Create(
+        GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Geometry),
+        sizeof(SkinnedGeometryData),
+        "Geometry Uniform Ring");
+
     // Transition the swapchain image to swapchain present format before hitting render loop
     // or else the image transitions won't use expected initial layout.
     for (uint32_t i = 0; i < mSwapchainImages.size(); ++i)
@@ -138,13 +165,20 @@ void VulkanContext::Destroy()
 {
     DeviceWaitIdle();
 
-    mMeshDescriptorSetArena.Destroy();
-    mMeshUniformBufferArena.Destroy();
+    mGeometryRing.Destroy();
+    mUiBatcher.Destroy();
 
     DestroySwapchain();
 
     DestroyPipelines();
-
+    DestroyPipelineCache();
+
+    mIndirectDrawer.Destroy();
+    mBindlessTable.Destroy();
+    mGpuTimer.Destroy();
+    mCommandRecorder.Destroy();
+    mMeshPool.Destroy();
+    mUploadQueue.Destroy();
     mDestroyQueue.FlushAll();
 
     vkDestroyDescriptorPool(mDevice, mDescriptorPool, nullptr);
@@ -204,8 +238,15 @@ void VulkanContext::BeginFrame()
     vkBeginCommandBuffer(cb, &beginInfo);
     SetDebugObjectName(VK_OBJECT_TYPE_COMMAND_BUFFER, (uint64_t)cb, "FrameCommandBuffer");
 
-    mMeshDescriptorSetArena.Reset();
-    mMeshUniformBufferArena.Reset();
+    mGeometryRing.BeginFrame();
+    mUiBatcher.BeginFrame();
+    mCommandRecorder.BeginFrame();
+    mBindlessTable.BeginFrame();
+    mMeshPool.BeginFrame();
+    mIndirectDrawer.BeginFrame();
+
+    // Last use of this frame index has finished, so its timestamps can be read without waiting.
+    mGpuTimer.BeginFrame(cb);
 }
 
 void VulkanContext::EndFrame()
@@ -220,6 +261,11 @@ void VulkanContext::EndFrame()
 
     UpdateGlobalUniformData();
     UpdateGlobalDescriptorSet();
+    mGeometryRing.Flush();
+    mIndirectDrawer.Flush();
+
+    // Uploads recorded during the frame have to execute before the frame's commands.
+    mUploadQueue.Flush();
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -344,23 +390,52 @@ void VulkanContext::BeginRenderPass(RenderPassId id)
             0, nullptr);
     }
 
+    // Shadow and forward draws go through secondary command buffers so they can be recorded on several threads.
+    bool recordSecondaries = mCommandRecorder.IsEnabled() &&
+        (id == RenderPassId::Shadows || id == RenderPassId::Forward);
+
+    // Pass timestamps go on the primary outside of the pass instance since secondary passes can't take inline commands.
+    // Hit check records into its own command buffer, which is submitted before the frame's queries are reset.
+    if (id != RenderPassId::HitCheck)
+    {
+        mGpuTimer.BeginScope(mCommandBuffers[mFrameIndex], GetRenderPassName(id));
+    }
+
     BeginDebugLabel(GetRenderPassName(id));
-    vkCmdBeginRenderPass(mCommandBuffers[mFrameIndex], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(
+        mCommandBuffers[mFrameIndex],
+        &renderPassInfo,
+        recordSecondaries ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+    if (recordSecondaries)
+    {
+        mCommandRecorder.BeginPass(renderPassInfo.renderPass, renderPassInfo.framebuffer);
+    }
 }
 
 void VulkanContext::EndRenderPass()
 {
-    // TEMPORARY!!
-    // TODO: Remove this after finding out how to avoid double-updating GeometryUniform buffers between shadow and forward passes.
-    if (mCurrentRenderPassId == RenderPassId::Shadows)
+    if (mCurrentRenderPassId == RenderPassId::Ui)
     {
-        DeviceWaitIdle();
+        // All widgets have been gathered, so record the batched UI draws.
+        mUiBatcher.Flush(mCommandBuffers[mFrameIndex]);
+    }
+
+    if (mCommandRecorder.IsPassActive())
+    {
+        mCommandRecorder.EndPass(mCommandBuffers[mFrameIndex]);
     }
 
     if (mCurrentRenderPassId != RenderPassId::Count)
     {
         vkCmdEndRenderPass(mCommandBuffers[mFrameIndex]);
         EndDebugLabel();
+
+        if (mCurrentRenderPassId != RenderPassId::HitCheck)
+        {
+            mGpuTimer.EndScope(mCommandBuffers[mFrameIndex]);
+        }
+
         mCurrentRenderPassId = RenderPassId::Count;
     }
 }
@@ -375,15 +450,21 @@ void VulkanContext::BindPipeline(PipelineId id, VertexType vertexType)
 
 void VulkanContext::BindPipeline(Pipeline* pipeline, VertexType vertexType)
 {
-    VkCommandBuffer cb = mCommandBuffers[mFrameIndex];
+    VkCommandBuffer cb = GetCommandBuffer();
     VkPipelineLayout pipelineLayout = pipeline->GetPipelineLayout();
     
     pipeline->BindPipeline(cb, vertexType);
-    mCurrentlyBoundPipeline = pipeline;
+    mCommandRecorder.GetThreadState().mBoundPipeline = pipeline;
 
     // Always rebind Global Descriptor (might not need to do this)
     mGlobalDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Global, pipelineLayout);
 
+    // Bindless pipelines share one material set, so it's bound with the pipeline instead of per draw.
+    if (pipeline->IsBindless())
+    {
+        mBindlessTable.Bind(cb, pipelineLayout);
+    }
+
     // Handle pipeline-specific functionality
     switch (pipeline->GetId())
     {
@@ -392,15 +473,22 @@ void VulkanContext::BindPipeline(Pipeline* pipeline, VertexType vertexType)
         mPostProcessDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::PostProcess, pipelineLayout);
         break;
 
+    case PipelineId::Shadow:
+    case PipelineId::ShadowIndirect:
+        vkCmdPushConstants(cb, pipelineLayout, pipeline->mPushConstantStages, 0, sizeof(uint32_t), &mShadowCascade);
+        break;
+
     default: break;
     }
 }
 
 void VulkanContext::RebindPipeline(VertexType vertexType)
 {
-    if (mCurrentlyBoundPipeline != nullptr)
+    Pipeline* boundPipeline = GetCurrentlyBoundPipeline();
+
+    if (boundPipeline != nullptr)
     {
-        BindPipeline(mCurrentlyBoundPipeline, vertexType);
+        BindPipeline(boundPipeline, vertexType);
     }
 }
 
@@ -458,6 +546,17 @@ void VulkanContext::DrawFullscreen()
     vkCmdDraw(GetCommandBuffer(), 4, 1, 0, 0);
 }
 
+void VulkanContext::BeginGpuStat(const char* name)
+{
+    // Timestamps may be written inside a pass, into whichever command buffer is recording.
+    mGpuTimer.BeginScope(GetCommandBuffer(), name);
+}
+
+void VulkanContext::EndGpuStat()
+{
+    mGpuTimer.EndScope(GetCommandBuffer());
+}
+
 void VulkanContext::DestroySwapchain()
 {
     for (size_t i = 0; i < mSwapchainFramebuffers.size(); ++i)
@@ -490,6 +589,8 @@ void VulkanContext::DestroySwapchain()
     GetDestroyQueue()->Destroy(mGlobalUniformBuffer);
     mGlobalUniformBuffer = nullptr;
 
+    mClusteredLighting.Destroy();
+
     GetDestroyQueue()->Destroy(mGlobalDescriptorSet);
     mGlobalDescriptorSet = nullptr;
 
@@ -678,6 +779,7 @@ void VulkanContext::CreateInstance()
     VkBool32 surfaceExtFound = false;
     VkBool32 platformSurfaceExtFound = false;
     VkBool32 debugUtilsExtFound = false;
+    VkBool32 properties2ExtFound = false;
     uint32_t extensionCount = 0;
 
     if (mValidate &&
@@ -727,6 +829,15 @@ void VulkanContext::CreateInstance()
                     debugUtilsExtFound = true;
                 }
             }
+
+#if BINDLESS_ENABLED
+            // Needed to query descriptor indexing support on Vulkan 1.0
+            if (!strcmp(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, extensions[i].extensionName))
+            {
+                mEnabledExtensions[mEnabledExtensionCount++] = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
+                properties2ExtFound = true;
+            }
+#endif
             assert(mEnabledExtensionCount < MAX_ENABLED_EXTENSIONS);
         }
 
@@ -790,6 +901,18 @@ void VulkanContext::CreateInstance()
                 mInstance,
                 "vkSetDebugUtilsObjectNameEXT");
     }
+
+    if (properties2ExtFound)
+    {
+        GetPhysicalDeviceFeatures2KHR =
+            (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(
+                mInstance,
+                "vkGetPhysicalDeviceFeatures2KHR");
+        GetPhysicalDeviceProperties2KHR =
+            (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(
+                mInstance,
+                "vkGetPhysicalDeviceProperties2KHR");
+    }
 }
 
 void VulkanContext::CreateDebugCallback()
@@ -918,17 +1041,108 @@ void VulkanContext::CreateLogicalDevice()
     ciDeviceQueues[QUEUE_PRESENT].queueCount = 1;
     ciDeviceQueues[QUEUE_PRESENT].pQueuePriorities = &priorities;
 
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(mPhysicalDevice, &supportedFeatures);
+    mSupportsBlockCompression = supportedFeatures.textureCompressionBC;
+    bool supportsNonUniformIndexing = false;
+
     VkPhysicalDeviceFeatures deviceFeatures = {};
     deviceFeatures.fillModeNonSolid = true;
     deviceFeatures.wideLines = true;
+    deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
+    const char* deviceExtensions[MAX_ENABLED_EXTENSIONS] = { };
+    uint32_t numDeviceExtensions = 0;
+
+    for (uint32_t i = 0; i < sNumDeviceExtensions; ++i)
+    {
+        deviceExtensions[numDeviceExtensions++] = sDeviceExtensions[i];
+    }
+
+    mSupportsBindless = false;
+
+#if BINDLESS_ENABLED
+    if (GetPhysicalDeviceFeatures2KHR != nullptr &&
+        GetPhysicalDeviceProperties2KHR != nullptr &&
+        CheckDeviceExtensionSupport(mPhysicalDevice, sBindlessDeviceExtensions, sNumBindlessDeviceExtensions))
+    {
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT supportedIndexing = {};
+        supportedIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+        VkPhysicalDeviceFeatures2KHR features2 = {};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features2.pNext = &supportedIndexing;
+        GetPhysicalDeviceFeatures2KHR(mPhysicalDevice, &features2);
+
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProps = {};
+        indexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2KHR properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        properties2.pNext = &indexingProps;
+        GetPhysicalDeviceProperties2KHR(mPhysicalDevice, &properties2);
+
+        mSupportsBindless =
+            supportedIndexing.runtimeDescriptorArray &&
+            supportedIndexing.descriptorBindingPartiallyBound &&
+            supportedIndexing.descriptorBindingSampledImageUpdateAfterBind &&
+            supportedIndexing.descriptorBindingUpdateUnusedWhilePending &&
+            indexingProps.maxPerStageDescriptorUpdateAfterBindSamplers >= BINDLESS_MAX_TEXTURES &&
+            indexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages >= BINDLESS_MAX_TEXTURES &&
+            indexingProps.maxDescriptorSetUpdateAfterBindSamplers >= BINDLESS_MAX_TEXTURES &&
+            indexingProps.maxDescriptorSetUpdateAfterBindSampledImages >= BINDLESS_MAX_TEXTURES &&
+            indexingProps.maxPerStageUpdateAfterBindResources >= BINDLESS_MAX_TEXTURES + 1;
+
+        supportsNonUniformIndexing = supportedIndexing.shaderSampledImageArrayNonUniformIndexing;
+    }
+#endif
+
+    // Indirect draws pick their material from the draw data, so they need bindless materials
+    // and a texture array index that can differ within a draw.
+    mSupportsIndirectDraws = false;
+
+#if INDIRECT_DRAWS_ENABLED
+    mSupportsIndirectDraws =
+        mSupportsBindless &&
+        supportsNonUniformIndexing &&
+        supportedFeatures.multiDrawIndirect &&
+        supportedFeatures.drawIndirectFirstInstance;
+#endif
+
+    if (mSupportsIndirectDraws)
+    {
+        deviceFeatures.multiDrawIndirect = VK_TRUE;
+        deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+    if (mSupportsBindless)
+    {
+        indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        indexingFeatures.shaderSampledImageArrayNonUniformIndexing = mSupportsIndirectDraws ? VK_TRUE : VK_FALSE;
+
+        for (uint32_t i = 0; i < sNumBindlessDeviceExtensions; ++i)
+        {
+            deviceExtensions[numDeviceExtensions++] = sBindlessDeviceExtensions[i];
+        }
+    }
+
+    LogDebug("Bindless materials %s", mSupportsBindless ? "supported" : "not supported, using per material descriptor sets");
+    LogDebug("Indirect draws %s", mSupportsIndirectDraws ? "supported" : "not supported, using per draw commands");
 
     VkDeviceCreateInfo ciDevice = {};
     ciDevice.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    ciDevice.pNext = mSupportsBindless ? &indexingFeatures : nullptr;
     ciDevice.pQueueCreateInfos = ciDeviceQueues;
     ciDevice.queueCreateInfoCount = queueCount;
     ciDevice.pEnabledFeatures = &deviceFeatures;
-    ciDevice.enabledExtensionCount = sNumDeviceExtensions;
-    ciDevice.ppEnabledExtensionNames = sDeviceExtensions;
+    ciDevice.enabledExtensionCount = numDeviceExtensions;
+    ciDevice.ppEnabledExtensionNames = deviceExtensions;
 
     if (mValidate)
     {
@@ -1393,6 +1607,7 @@ void VulkanContext::CreateDepthImage()
 void VulkanContext::CreateGlobalUniformBuffer()
 {
     mGlobalUniformBuffer = new UniformBuffer(sizeof(GlobalUniformData), "Global Uniforms");
+    mClusteredLighting.Create();
 }
 
 void VulkanContext::UpdateGlobalUniformData()
@@ -1414,38 +1629,34 @@ void VulkanContext::UpdateGlobalUniformData()
         {
             mGlobalUniformData.mDirectionalLightDirection = glm::vec4(dirLight->GetDirection(), 0.0f);
             mGlobalUniformData.mDirectionalLightColor = dirLight->GetColor();
-            mGlobalUniformData.mDirectionalLightVP = dirLight->GetViewProjectionMatrix();
-            //mGlobalUniformData.mShadowIntensity = 0.0f; // (GetShadowMapImageView() != VK_NULL_HANDLE && world->GetDirectionalLight()->ShouldCastShadows()) ? 1.0f : 0.0f;
+            mGlobalUniformData.mShadowsEnabled = dirLight->ShouldCastShadows() ? 1 : 0;
+
+            for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i)
+            {
+                mGlobalUniformData.mShadowCascadeVP[i] = dirLight->GetCascadeViewProjectionMatrix(i);
+                mGlobalUniformData.mShadowCascadeSplits[i] = dirLight->GetCascadeSplit(i);
+            }
         }
         else
         {
             mGlobalUniformData.mDirectionalLightDirection = glm::vec4(1);
             mGlobalUniformData.mDirectionalLightColor = glm::vec4(0);
-            mGlobalUniformData.mDirectionalLightVP = glm::mat4(1);
-            //mGlobalUniformData.mShadowIntensity = 0.0;
-        }
+            mGlobalUniformData.mShadowsEnabled = 0;
 
-        mGlobalUniformData.mAmbientLightColor = world->GetAmbientLightColor();
-
-        const std::vector<PointLightComponent*>& pointLights = world->GetPointLights();
-        mGlobalUniformData.mNumPointLights = int32_t(pointLights.size());
-        
-        for (uint32_t i = 0; i < MAX_POINTLIGHTS; ++i)
-        {
-            PointLightComponent* pointLight = (i < pointLights.size()) ? pointLights[i] : nullptr;
-
-            if (pointLight != nullptr)
-            {
-                mGlobalUniformData.mPointLightPositions[i] = glm::vec4(pointLight->GetAbsolutePosition(), pointLight->GetRadius());
-                mGlobalUniformData.mPointLightColors[i] = pointLight->GetColor();
-            }
-            else
+            for (uint32_t i = 0; i < SHADOW_CASCADE_COUNT; ++i)
             {
-                mGlobalUniformData.mPointLightPositions[i] = glm::vec4(0,0,0,0);
-                mGlobalUniformData.mPointLightColors[i] = glm::vec4(0,0,0,1);
+                mGlobalUniformData.mShadowCascadeVP[i] = glm::mat4(1);
+                mGlobalUniformData.mShadowCascadeSplits[i] = 0.0f;
             }
         }
 
+        mGlobalUniformData.mAmbientLightColor = world->GetAmbientLightColor();
+
+        // Point lights are binned into view space clusters and read from a storage buffer.
+        mClusteredLighting.Update(camera, world->GetPointLights());
+        mGlobalUniformData.mNumPointLights = mClusteredLighting.GetNumLights();
+        mGlobalUniformData.mClusterDepthParams = mClusteredLighting.GetDepthParams();
+
         mGlobalUniformData.mShadowColor = world->GetShadowColor();
 
         const FogSettings& fog = world->GetFogSettings();
@@ -1474,6 +1685,21 @@ bool VulkanContext::IsValidationEnabled() const
     return mValidate;
 }
 
+bool VulkanContext::IsBlockCompressionSupported() const
+{
+    return mSupportsBlockCompression;
+}
+
+bool VulkanContext::IsBindlessEnabled() const
+{
+    return mSupportsBindless;
+}
+
+bool VulkanContext::IsIndirectDrawEnabled() const
+{
+    return mSupportsIndirectDraws;
+}
+
 void VulkanContext::UpdateGlobalDescriptorSet()
 {
     mGlobalUniformBuffer->Update(&mGlobalUniformData, sizeof(GlobalUniformData));
@@ -1488,6 +1714,7 @@ void VulkanContext::CreateGlobalDescriptorSet()
     mGlobalDescriptorSet = new DescriptorSet(layout);
     mGlobalDescriptorSet->UpdateUniformDescriptor(GLD_UNIFORM_BUFFER, mGlobalUniformBuffer);
     mGlobalDescriptorSet->UpdateImageDescriptor(GLD_SHADOW_MAP, mShadowMapImage);
+    mGlobalDescriptorSet->UpdateStorageDescriptor(GLD_CLUSTER_LIGHTS, mClusteredLighting.GetBuffer());
 
     UpdateGlobalDescriptorSet();
 }
@@ -1552,7 +1779,9 @@ Image* VulkanContext::GetShadowMapImage()
 
 VkCommandBuffer VulkanContext::GetCommandBuffer()
 {
-    return mCommandBuffers[mFrameIndex];
+    // Inside the shadow and forward passes, each thread records into its own secondary command buffer.
+    VkCommandBuffer secondaryCb = mCommandRecorder.GetCommandBuffer();
+    return (secondaryCb != VK_NULL_HANDLE) ? secondaryCb : mCommandBuffers[mFrameIndex];
 }
 
 VkCommandPool VulkanContext::GetCommandPool()
@@ -1595,7 +1824,7 @@ void VulkanContext::CreateFences()
 
 void VulkanContext::CreateDescriptorPool()
 {
-    VkDescriptorPoolSize poolSizes[4] = {};
+    VkDescriptorPoolSize poolSizes[5] = {};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     poolSizes[0].descriptorCount = MAX_UNIFORM_BUFFER_DESCRIPTORS;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -1604,10 +1833,12 @@ void VulkanContext::CreateDescriptorPool()
     poolSizes[2].descriptorCount = MAX_STORAGE_BUFFER_DESCRIPTORS;
     poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     poolSizes[3].descriptorCount = MAX_STORAGE_IMAGE_DESCRIPTORS;
+    poolSizes[4].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[4].descriptorCount = MAX_DYNAMIC_UNIFORM_BUFFER_DESCRIPTORS;
 
     VkDescriptorPoolCreateInfo ciPool = {};
     ciPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    ciPool.poolSizeCount = 4;
+    ciPool.poolSizeCount = 5;
     ciPool.pPoolSizes = poolSizes;
     ciPool.maxSets = MAX_DESCRIPTOR_SETS;
     ciPool.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
@@ -1662,6 +1893,11 @@ VkDescriptorPool VulkanContext::GetDescriptorPool()
     return mDescriptorPool;
 }
 
+VkPipelineCache VulkanContext::GetPipelineCache()
+{
+    return mPipelineCache;
+}
+
 DescriptorSet* VulkanContext::GetGlobalDescriptorSet()
 {
     return mGlobalDescriptorSet;
@@ -1867,9 +2103,9 @@ bool VulkanContext::CheckDeviceExtensionSupport(VkPhysicalDevice device,
 
     std::set<std::string> requiredExtensions;
 
-    for (uint32_t i = 0; i < sNumDeviceExtensions; ++i)
+    for (uint32_t i = 0; i < count; ++i)
     {
-        requiredExtensions.insert(sDeviceExtensions[i]);
+        requiredExtensions.insert(extensions[i]);
     }
 
     for (const auto& extension : availableExtensions)
@@ -1896,14 +2132,54 @@ void VulkanContext::DestroyDebugCallback()
     }
 }
 
-DescriptorSetArena& VulkanContext::GetMeshDescriptorSetArena()
+UniformRingBuffer& VulkanContext::GetGeometryRingBuffer()
 {
-    return mMeshDescriptorSetArena;
+    return mGeometryRing;
 }
 
-UniformBufferArena& VulkanContext::GetMeshUniformBufferArena()
+UiBatcher& VulkanContext::GetUiBatcher()
 {
-    return mMeshUniformBufferArena;
+    return mUiBatcher;
+}
+
+UploadQueue& VulkanContext::GetUploadQueue()
+{
+    return mUploadQueue;
+}
+
+CommandRecorder& VulkanContext::GetCommandRecorder()
+{
+    return mCommandRecorder;
+}
+
+BindlessTable& VulkanContext::GetBindlessTable()
+{
+    return mBindlessTable;
+}
+
+MeshPool& VulkanContext::GetMeshPool()
+{
+    return mMeshPool;
+}
+
+IndirectDrawer& VulkanContext::GetIndirectDrawer()
+{
+    return mIndirectDrawer;
+}
+
+GpuTimer& VulkanContext::GetGpuTimer()
+{
+    return mGpuTimer;
+}
+
+const VkViewport& VulkanContext::GetViewport() const
+{
+    return mViewport;
+}
+
+const VkRect2D& VulkanContext::GetScissor() const
+{
+    return mScissor;
 }
 
 VkExtent2D& VulkanContext::GetSwapchainExtent()
@@ -1920,7 +2196,7 @@ Pipeline* VulkanContext::GetPipeline(PipelineId id)
 
 Pipeline* VulkanContext::GetCurrentlyBoundPipeline()
 {
-    return mCurrentlyBoundPipeline;
+    return mCommandRecorder.GetThreadState().mBoundPipeline;
 }
 
 VkRenderPass VulkanContext::GetForwardRenderPass()
@@ -1956,8 +2232,13 @@ void VulkanContext::CreatePipelines()
     mPipelines[(size_t)PipelineId::Line] = new LineGeometryPipeline();
     mPipelines[(size_t)PipelineId::PostProcess] = new PostProcessPipeline();
     mPipelines[(size_t)PipelineId::NullPostProcess] = new NullPostProcessPipeline();
-    mPipelines[(size_t)PipelineId::Quad] = new QuadPipeline();
-    mPipelines[(size_t)PipelineId::Text] = new TextPipeline();
+    mPipelines[(size_t)PipelineId::Ui] = new UiPipeline();
+
+    if (mSupportsIndirectDraws)
+    {
+        mPipelines[(size_t)PipelineId::OpaqueIndirect] = new OpaqueIndirectPipeline();
+        mPipelines[(size_t)PipelineId::ShadowIndirect] = new ShadowIndirectPipeline();
+    }
 
 #if EDITOR
     mPipelines[(size_t)PipelineId::HitCheck] = new HitCheckPipeline();
@@ -1979,14 +2260,146 @@ void VulkanContext::CreatePipelines()
     mPipelines[(size_t)PipelineId::Line]->Create(mPostprocessRenderPass);
     mPipelines[(size_t)PipelineId::PostProcess]->Create(mPostprocessRenderPass);
     mPipelines[(size_t)PipelineId::NullPostProcess]->Create(mPostprocessRenderPass);
-    mPipelines[(size_t)PipelineId::Quad]->Create(mUIRenderPass);
-    mPipelines[(size_t)PipelineId::Text]->Create(mUIRenderPass);
+    mPipelines[(size_t)PipelineId::Ui]->Create(mUIRenderPass);
+
+    if (mSupportsIndirectDraws)
+    {
+        mPipelines[(size_t)PipelineId::OpaqueIndirect]->Create(mForwardRenderPass);
+        mPipelines[(size_t)PipelineId::ShadowIndirect]->Create(mShadowRenderPass);
+    }
 
 #if EDITOR
     mPipelines[(size_t)PipelineId::HitCheck]->Create(mHitCheckRenderPass);
 #endif
 }
 
+void VulkanContext::CreatePipelineCache()
+{
+    // The file starts with our own header so that data from a different GPU or driver is never handed to vkCreatePipelineCache().
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(mPhysicalDevice, &deviceProperties);
+
+    std::string cachePath = GetPipelineCachePath();
+    std::vector<uint8_t> cacheData;
+
+    if (DoesFileExist(cachePath.c_str()))
+    {
+        Stream stream;
+        stream.ReadFile(cachePath.c_str());
+
+        const uint32_t headerSize = 5 * sizeof(uint32_t) + VK_UUID_SIZE;
+        bool valid = stream.GetSize() >= headerSize;
+        uint8_t uuid[VK_UUID_SIZE] = {};
+
+        valid = valid && stream.ReadUint32() == PIPELINE_CACHE_MAGIC;
+        valid = valid && stream.ReadUint32() == PIPELINE_CACHE_VERSION;
+        valid = valid && stream.ReadUint32() == deviceProperties.vendorID;
+        valid = valid && stream.ReadUint32() == deviceProperties.deviceID;
+        valid = valid && stream.ReadUint32() == deviceProperties.driverVersion;
+
+        if (valid)
+        {
+            stream.ReadBytes(uuid, VK_UUID_SIZE);
+            valid = memcmp(uuid, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+
+        if (valid)
+        {
+            uint32_t dataSize = stream.GetSize() - stream.GetPos();
+            cacheData.resize(dataSize);
+            stream.ReadBytes(cacheData.data(), dataSize);
+        }
+        else
+        {
+            LogWarning("Ignoring pipeline cache from a different device or driver");
+        }
+    }
+
+    VkPipelineCacheCreateInfo ciCache = {};
+    ciCache.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    ciCache.initialDataSize = cacheData.size();
+    ciCache.pInitialData = cacheData.size() > 0 ? cacheData.data() : nullptr;
+
+    if (vkCreatePipelineCache(mDevice, &ciCache, nullptr, &mPipelineCache) != VK_SUCCESS)
+    {
+        // Not fatal, pipelines can still be created without a cache.
+        LogWarning("Failed to create pipeline cache");
+        mPipelineCache = VK_NULL_HANDLE;
+    }
+    else
+    {
+        LogDebug("Pipeline cache loaded with %d bytes", int32_t(cacheData.size()));
+    }
+}
+
+void VulkanContext::SavePipelineCache()
+{
+    if (mPipelineCache == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    size_t dataSize = 0;
+    vkGetPipelineCacheData(mDevice, mPipelineCache, &dataSize, nullptr);
+
+    std::vector<uint8_t> cacheData(dataSize);
+    if (dataSize == 0 ||
+        vkGetPipelineCacheData(mDevice, mPipelineCache, &dataSize, cacheData.data()) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(mPhysicalDevice, &deviceProperties);
+
+    Stream stream;
+    stream.WriteUint32(PIPELINE_CACHE_MAGIC);
+    stream.WriteUint32(PIPELINE_CACHE_VERSION);
+    stream.WriteUint32(deviceProperties.vendorID);
+    stream.WriteUint32(deviceProperties.deviceID);
+    stream.WriteUint32(deviceProperties.driverVersion);
+    stream.WriteBytes(deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    stream.WriteBytes(cacheData.data(), uint32_t(dataSize));
+
+    std::string cachePath = GetPipelineCachePath();
+    std::string cacheDir = cachePath.substr(0, cachePath.find_last_of('/'));
+
+    if (!DoesDirExist(cacheDir.c_str()))
+    {
+        CreateDir(cacheDir.c_str());
+    }
+
+    // Packaged games may not be able to write next to the project, the cache is simply rebuilt next run.
+    FILE* file = fopen(cachePath.c_str(), "wb");
+
+    if (file != nullptr)
+    {
+        fwrite(stream.GetData(), stream.GetSize(), 1, file);
+        fclose(file);
+        file = nullptr;
+    }
+    else
+    {
+        LogWarning("Failed to write pipeline cache %s", cachePath.c_str());
+    }
+}
+
+void VulkanContext::DestroyPipelineCache()
+{
+    SavePipelineCache();
+
+    if (mPipelineCache != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
+        mPipelineCache = VK_NULL_HANDLE;
+    }
+}
+
+std::string VulkanContext::GetPipelineCachePath() const
+{
+    return mEngineState->mProjectDirectory + "Intermediate/" + PIPELINE_CACHE_FILE;
+}
+
 void VulkanContext::DestroyPipelines()
 {
     for (uint32_t i = 0; i < (uint32_t)PipelineId::Count; ++i)
@@ -2009,6 +2422,9 @@ void VulkanContext::SetViewport(int32_t x, int32_t y, int32_t width, int32_t hei
     viewport.height = static_cast<float>(height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
+
+    // Kept around for secondary command buffers, which don't inherit dynamic state.
+    mViewport = viewport;
     vkCmdSetViewport(GetCommandBuffer(), 0, 1, &viewport);
 }
 
@@ -2017,7 +2433,36 @@ void VulkanContext::SetScissor(int32_t x, int32_t y, int32_t width, int32_t heig
     VkRect2D scissorRect = {};
     scissorRect.offset = { x, y };
     scissorRect.extent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
-    vkCmdSetScissor(GetCommandBuffer(), 0, 1, &scissorRect);
+    mScissor = scissorRect;
+
+    // UI draws are deferred until the end of the pass, so the batcher records the scissor with each batch.
+    mUiBatcher.SetScissor(scissorRect);
+
+    if (mCurrentRenderPassId != RenderPassId::Ui)
+    {
+        vkCmdSetScissor(GetCommandBuffer(), 0, 1, &scissorRect);
+    }
+}
+
+void VulkanContext::SetShadowCascade(uint32_t cascade)
+{
+    mShadowCascade = cascade;
+
+    // Fetch the command buffer first, starting a new secondary clears the bound pipeline.
+    VkCommandBuffer cb = GetCommandBuffer();
+    Pipeline* boundPipeline = GetCurrentlyBoundPipeline();
+
+    if (boundPipeline != nullptr &&
+        (boundPipeline->GetId() == PipelineId::Shadow || boundPipeline->GetId() == PipelineId::ShadowIndirect))
+    {
+        vkCmdPushConstants(
+            cb,
+            boundPipeline->GetPipelineLayout(),
+            boundPipeline->mPushConstantStages,
+            0,
+            sizeof(uint32_t),
+            &mShadowCascade);
+    }
 }
 
 #if EDITOR
@@ -2032,7 +2477,8 @@ Actor* VulkanContext::ProcessHitCheck(World* world, int32_t pixelX, int32_t pixe
 
     // Render to image
     {
-        VkCommandBuffer cb = BeginCommandBuffer();
+        // The upload batch can't hold a render pass, uploads made while rendering are recorded there instead.
+        VkCommandBuffer cb = BeginSingleCommandBuffer();
         // HACK - since I'm not passing the CB to Render calls()
         // replace the "current" CB with our temp CB
         VkCommandBuffer realCb = mCommandBuffers[mFrameIndex];
@@ -2041,6 +2487,9 @@ Actor* VulkanContext::ProcessHitCheck(World* world, int32_t pixelX, int32_t pixe
         UpdateGlobalUniformData();
         UpdateGlobalDescriptorSet();
 
+        // Hit check ids are assigned below, so cached geometry uniforms from the last frame can't be reused.
+        mGeometryRing.Invalidate();
+
         SetViewport(0, 0, mSwapchainExtent.width, mSwapchainExtent.height);
         SetScissor(0, 0, mSwapchainExtent.width, mSwapchainExtent.height);
 
@@ -2083,7 +2532,8 @@ Actor* VulkanContext::ProcessHitCheck(World* world, int32_t pixelX, int32_t pixe
 
         EndRenderPass();
 
-        EndCommandBuffer(cb);
+        mGeometryRing.Flush();
+        EndSingleCommandBuffer(cb);
         mCommandBuffers[mFrameIndex] = realCb; // HACK, see beginning of this CB recording block.
 
         // Ensure that this CB executes so that we can make sure the image is updated.
@@ -13,9 +13,8 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/ShadowMeshComponent.h"
 #include "Components/ParticleComponent.h"
-#include "Widgets/Quad.h"
-#include "Widgets/Text.h"
 #include "Utilities.h"
+#include "BlockCompressor.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
@@ -52,6 +51,11 @@ VkFormat ConvertPixelFormat(PixelFormat pixelFormat)
     case PixelFormat::Depth16: format = VK_FORMAT_D16_UNORM; break;
     case PixelFormat::Depth32F: format = VK_FORMAT_D32_SFLOAT; break;
 
+    case PixelFormat::BC1: format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+    case PixelFormat::BC3: format = VK_FORMAT_BC3_UNORM_BLOCK; break;
+    case PixelFormat::BC5: format = VK_FORMAT_BC5_UNORM_BLOCK; break;
+    case PixelFormat::BC7: format = VK_FORMAT_BC7_UNORM_BLOCK; break;
+
     default: break;
     }
 
@@ -238,28 +242,30 @@ void TransitionImageLayout(
     }
 }
 
-void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
+void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize dstOffset, VkDeviceSize srcOffset)
 {
     VkCommandBuffer commandBuffer = BeginCommandBuffer();
 
     VkBufferCopy copyRegion = {};
     copyRegion.size = size;
+    copyRegion.srcOffset = srcOffset;
+    copyRegion.dstOffset = dstOffset;
     vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
     EndCommandBuffer(commandBuffer);
 }
 
-void CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
+void CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevel, VkDeviceSize bufferOffset)
 {
     VkCommandBuffer commandBuffer = BeginCommandBuffer();
 
     VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
+    region.bufferOffset = bufferOffset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
 
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.mipLevel = mipLevel;
     region.imageSubresource.baseArrayLayer = 0;
     region.imageSubresource.layerCount = 1;
 
@@ -299,10 +305,22 @@ VkCommandBuffer GetCommandBuffer()
 
 void DeviceWaitIdle()
 {
+    // Anything still sitting in the upload batch needs to be submitted or it would never complete.
+    GetVulkanContext()->GetUploadQueue().Flush();
     vkDeviceWaitIdle(GetVulkanDevice());
 }
 
 VkCommandBuffer BeginCommandBuffer()
+{
+    return GetVulkanContext()->GetUploadQueue().GetCommandBuffer();
+}
+
+void EndCommandBuffer(VkCommandBuffer commandBuffer)
+{
+    // Nothing to submit here, the whole upload batch is submitted by UploadQueue::Flush().
+}
+
+VkCommandBuffer BeginSingleCommandBuffer()
 {
     VkDevice device = GetVulkanDevice();
     VkCommandPool commandPool = GetVulkanContext()->GetCommandPool();
@@ -327,12 +345,15 @@ VkCommandBuffer BeginCommandBuffer()
     return commandBuffer;
 }
 
-void EndCommandBuffer(VkCommandBuffer commandBuffer)
+void EndSingleCommandBuffer(VkCommandBuffer commandBuffer)
 {
     VkQueue graphicsQueue = GetVulkanContext()->GetGraphicsQueue();
 
     vkEndCommandBuffer(commandBuffer);
 
+    // Uploads recorded while this command buffer was open have to execute before it.
+    GetVulkanContext()->GetUploadQueue().Flush();
+
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
@@ -405,6 +426,9 @@ uint32_t GetFormatBlockSize(VkFormat format)
     switch (format)
     {
     case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: size = 8; break;
+    case VK_FORMAT_BC3_UNORM_BLOCK: size = 16; break;
+    case VK_FORMAT_BC5_UNORM_BLOCK: size = 16; break;
+    case VK_FORMAT_BC7_UNORM_BLOCK: size = 16; break;
     case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK: size = 8; break;
     default: break;
     }
@@ -420,12 +444,13 @@ uint32_t GetFormatBlockSize(VkFormat format)
 
 bool IsFormatBlockCompressed(VkFormat format)
 {
-    // Will probably only support BC1 and ETC2 formats.
-    // Trying to keep things simple for now.
-    // Desktop -> BC1
+    // Desktop -> BC1/BC3/BC5/BC7 (cooked by Texture::SaveStream)
     // Android -> ETC2
     bool isCompressed =
         format == VK_FORMAT_BC1_RGBA_UNORM_BLOCK ||
+        format == VK_FORMAT_BC3_UNORM_BLOCK ||
+        format == VK_FORMAT_BC5_UNORM_BLOCK ||
+        format == VK_FORMAT_BC7_UNORM_BLOCK ||
         format == VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
 
     return isCompressed;
@@ -704,12 +729,10 @@ void EndDebugLabel()
 void WriteGeometryUniformData(GeometryData& outData, World* world, const glm::mat4& transform)
 {
     CameraComponent* camera = world->GetActiveCamera();
-    DirectionalLightComponent* dirLight = world->GetDirectionalLight();
 
     outData.mWVPMatrix = camera->GetViewProjectionMatrix() * transform;
     outData.mWorldMatrix = transform;
-    outData.mNormalMatrix = glm::transpose(glm::inverse(transform));
-    outData.mLightWVPMatrix = dirLight ? (dirLight->GetViewProjectionMatrix() * transform) : glm::mat4(1);
+    outData.mNormalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(transform))));
     outData.mColor = glm::vec4(0.25f, 0.25f, 1.0f, 1.0f);
     outData.mHitCheckId = 0;
 }
@@ -767,8 +790,18 @@ void CreateTextureResource(Texture* texture, uint8_t* pixels)
 {
     TextureResource* resource = texture->GetResource();
 
-    // TODO: Handle other pixel formats
-    VkFormat format = ConvertPixelFormat(PixelFormat::RGBA8 /*texture->GetFormat()*/);
+    // Textures are either raw RGBA8 or were block compressed (with all of their mips) when cooked.
+    PixelFormat cookedFormat = texture->GetCookedFormat();
+    bool blockCompressed = BC_IsBlockFormat(cookedFormat);
+
+    if (blockCompressed && !GetVulkanContext()->IsBlockCompressionSupported())
+    {
+        LogError("Texture %s is block compressed but the device doesn't support BC formats", texture->GetName().c_str());
+        blockCompressed = false;
+        pixels = nullptr;
+    }
+
+    VkFormat format = ConvertPixelFormat(blockCompressed ? cookedFormat : PixelFormat::RGBA8);
 
     ImageDesc imageDesc;
     imageDesc.mWidth = texture->GetWidth();
@@ -812,18 +845,40 @@ void CreateTextureResource(Texture* texture, uint8_t* pixels)
 
     resource->mImage = new Image(imageDesc, samplerDesc, "Texture (Asset)");
 
-    if (pixels != nullptr)
+    if (pixels != nullptr && blockCompressed)
     {
-        resource->mImage->Update(pixels);
+        // Compressed mips are stored back to back, they can't be generated with blits.
+        uint32_t offset = 0;
+
+        for (uint32_t mip = 0; mip < texture->GetMipLevels(); ++mip)
+        {
+            uint32_t mipWidth = glm::max(texture->GetWidth() >> mip, 1u);
+            uint32_t mipHeight = glm::max(texture->GetHeight() >> mip, 1u);
+
+            resource->mImage->Update(pixels + offset, mip);
+            offset += BC_GetCompressedSize(cookedFormat, mipWidth, mipHeight);
+        }
     }
     else
     {
-        resource->mImage->Clear(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        if (pixels != nullptr)
+        {
+            resource->mImage->Update(pixels);
+        }
+        else
+        {
+            resource->mImage->Clear(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        }
+
+        if (texture->IsMipmapped())
+        {
+            resource->mImage->GenerateMips();
+        }
     }
 
-    if (texture->IsMipmapped())
+    if (GetVulkanContext()->IsBindlessEnabled())
     {
-        resource->mImage->GenerateMips();
+        resource->mBindlessIndex = GetVulkanContext()->GetBindlessTable().AddTexture(resource->mImage);
     }
 }
 
@@ -831,6 +886,14 @@ void DestroyTextureResource(Texture* texture)
 {
     TextureResource* resource = texture->GetResource();
 
+    GetVulkanContext()->GetUiBatcher().RemoveTexture(texture);
+
+    if (resource->mBindlessIndex != BINDLESS_INVALID_INDEX)
+    {
+        GetVulkanContext()->GetBindlessTable().RemoveTexture(resource->mBindlessIndex);
+        resource->mBindlessIndex = BINDLESS_INVALID_INDEX;
+    }
+
     if (resource->mImage != nullptr)
     {
         GetDestroyQueue()->Destroy(resource->mImage);
@@ -841,10 +904,18 @@ void DestroyTextureResource(Texture* texture)
 void CreateMaterialResource(Material* material)
 {
     MaterialResource* resource = material->GetResource();
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Material);
 
-    resource->mUniformBuffer = new UniformBuffer(sizeof(MaterialData), "Material Uniforms");
-    resource->mDescriptorSet = new DescriptorSet(layout);
+    if (GetVulkanContext()->IsBindlessEnabled())
+    {
+        resource->mBindlessIndex = GetVulkanContext()->GetBindlessTable().AddMaterial();
+    }
+    else
+    {
+        VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Material);
+
+        resource->mUniformBuffer = new UniformBuffer(sizeof(MaterialData), "Material Uniforms");
+        resource->mDescriptorSet = new DescriptorSet(layout);
+    }
 
     UpdateMaterialResource(material);
 }
@@ -853,6 +924,12 @@ void DestroyMaterialResource(Material* material)
 {
     MaterialResource* resource = material->GetResource();
 
+    if (resource->mBindlessIndex != BINDLESS_INVALID_INDEX)
+    {
+        GetVulkanContext()->GetBindlessTable().RemoveMaterial(resource->mBindlessIndex);
+        resource->mBindlessIndex = BINDLESS_INVALID_INDEX;
+    }
+
     if (resource->mUniformBuffer != nullptr)
     {
         GetDestroyQueue()->Destroy(resource->mUniformBuffer);
@@ -876,7 +953,28 @@ void BindMaterialResource(Material* material, Pipeline* pipeline)
         UpdateMaterialResource(material);
     }
 
-    resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Material, pipeline->GetPipelineLayout());
+    if (pipeline->IsBindless())
+    {
+        // The bindless set was bound with the pipeline, only the material index changes per draw.
+        uint32_t materialIndex = resource->mBindlessIndex;
+
+        if (materialIndex == BINDLESS_INVALID_INDEX)
+        {
+            materialIndex = Renderer::Get()->GetDefaultMaterial()->GetResource()->mBindlessIndex;
+        }
+
+        vkCmdPushConstants(
+            cb,
+            pipeline->GetPipelineLayout(),
+            pipeline->mPushConstantStages,
+            offsetof(DrawPushConstants, mMaterialIndex),
+            sizeof(uint32_t),
+            &materialIndex);
+    }
+    else
+    {
+        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Material, pipeline->GetPipelineLayout());
+    }
 }
 
 void UpdateMaterialResource(Material* material)
@@ -916,23 +1014,42 @@ void UpdateMaterialResource(Material* material)
     ubo.mTevModes[2] = textures[2] ? (uint32_t) material->GetTevMode(2) : (uint32_t)TevMode::Count;
     ubo.mTevModes[3] = textures[3] ? (uint32_t) material->GetTevMode(3) : (uint32_t)TevMode::Count;
 
-    resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
-
-    // Update descriptor bindings
     Renderer* renderer = Renderer::Get();
-    assert(resource->mDescriptorSet != nullptr);
-    resource->mDescriptorSet->UpdateUniformDescriptor(MD_UNIFORM_BUFFER, resource->mUniformBuffer);
+
+    Texture* whiteTexture = renderer->mWhiteTexture.Get<Texture>();
+    assert(whiteTexture != nullptr);
 
     for (uint32_t i = 0; i < MATERIAL_MAX_TEXTURES; ++i)
     {
-        Texture* texture = textures[i];
-        if (texture == nullptr)
+        if (textures[i] == nullptr)
+        {
+            textures[i] = whiteTexture;
+        }
+
+        // Textures that didn't get a bindless slot fall back to white as well.
+        ubo.mTextureIndices[i] = textures[i]->GetResource()->mBindlessIndex;
+        if (ubo.mTextureIndices[i] == BINDLESS_INVALID_INDEX)
         {
-            texture = renderer->mWhiteTexture.Get<Texture>();
-            assert(texture != nullptr);
+            ubo.mTextureIndices[i] = whiteTexture->GetResource()->mBindlessIndex;
         }
+    }
 
-        resource->mDescriptorSet->UpdateImageDescriptor(MD_TEXTURE_0 + i, texture->GetResource()->mImage);
+    if (GetVulkanContext()->IsBindlessEnabled())
+    {
+        GetVulkanContext()->GetBindlessTable().UpdateMaterial(resource->mBindlessIndex, ubo);
+    }
+    else
+    {
+        resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
+
+        // Update descriptor bindings
+        assert(resource->mDescriptorSet != nullptr);
+        resource->mDescriptorSet->UpdateUniformDescriptor(MD_UNIFORM_BUFFER, resource->mUniformBuffer);
+
+        for (uint32_t i = 0; i < MATERIAL_MAX_TEXTURES; ++i)
+        {
+            resource->mDescriptorSet->UpdateImageDescriptor(MD_TEXTURE_0 + i, textures[i]->GetResource()->mImage);
+        }
     }
 
     material->ClearDirty(GetFrameIndex());
@@ -985,6 +1102,25 @@ void CreateStaticMeshResource(StaticMesh* staticMesh, bool hasColor, uint32_t nu
 {
     StaticMeshResource* resource = staticMesh->GetResource();
 
+    // Generated LODs share the vertex buffer and are appended after LOD 0 in the index buffer.
+    const std::vector<IndexType>& lodIndices = staticMesh->GetLodIndices();
+    std::vector<IndexType> allIndices;
+
+    if (lodIndices.size() > 0)
+    {
+        allIndices.reserve(numIndices + lodIndices.size());
+        allIndices.insert(allIndices.end(), indices, indices + numIndices);
+        allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
+        indices = allIndices.data();
+        numIndices = uint32_t(allIndices.size());
+    }
+
+    // Most meshes live in the shared mesh pool, which is what lets them be drawn indirectly.
+    if (GetVulkanContext()->GetMeshPool().Alloc(hasColor, numVertices, vertices, numIndices, indices, resource->mPoolAlloc))
+    {
+        return;
+    }
+
     uint32_t vertexSize = hasColor ? sizeof(VertexColor) : sizeof(Vertex);
     resource->mVertexBuffer = new Buffer(BufferType::Vertex, numVertices * vertexSize, "StaticMesh Vertices", vertices, false);
     resource->mIndexBuffer = new Buffer(BufferType::Index, numIndices * sizeof(IndexType), "StaticMesh Indices", indices, false);
@@ -994,6 +1130,8 @@ void DestroyStaticMeshResource(StaticMesh* staticMesh)
 {
     StaticMeshResource* resource = staticMesh->GetResource();
 
+    GetVulkanContext()->GetMeshPool().Free(resource->mPoolAlloc);
+
     if (resource->mVertexBuffer != nullptr)
     {
         GetDestroyQueue()->Destroy(resource->mVertexBuffer);
@@ -1012,6 +1150,13 @@ void BindStaticMeshResource(StaticMesh* staticMesh)
     StaticMeshResource* resource = staticMesh->GetResource();
 
     VkCommandBuffer cb = GetCommandBuffer();
+
+    if (resource->mPoolAlloc.IsValid())
+    {
+        GetVulkanContext()->GetMeshPool().Bind(cb, resource->mPoolAlloc.mVertexColor, &resource->mPoolAlloc);
+        return;
+    }
+
     VkBuffer vertexBuffers[] = { resource->mVertexBuffer->Get() };
     VkDeviceSize offsets[] = { 0 };
     vkCmdBindVertexBuffers(cb, 0, 1, vertexBuffers, offsets);
@@ -1064,41 +1209,22 @@ void BindSkeletalMeshResourceIndices(SkeletalMesh* skeletalMesh)
 
 void CreateStaticMeshCompResource(StaticMeshComponent* staticMeshComp)
 {
-    StaticMeshCompResource* resource = staticMeshComp->GetResource();
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Geometry);
-
-    resource->mUniformBuffer = new UniformBuffer(sizeof(GeometryData), "Geometry Uniforms");
-    resource->mDescriptorSet = new DescriptorSet(layout);
-
-    resource->mDescriptorSet->UpdateUniformDescriptor(GD_UNIFORM_BUFFER, resource->mUniformBuffer);
+    // Geometry uniforms are allocated from the frame's uniform ring when the component is first drawn.
+    staticMeshComp->GetResource()->mGeometryAlloc = UniformRingAlloc();
 }
 
 void DestroyStaticMeshCompResource(StaticMeshComponent* staticMeshComp)
 {
-    StaticMeshCompResource* resource = staticMeshComp->GetResource();
-
-    if (resource->mUniformBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mUniformBuffer);
-        resource->mUniformBuffer = nullptr;
-    }
-
-    if (resource->mDescriptorSet != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mDescriptorSet);
-        resource->mDescriptorSet = nullptr;
-    }
+    staticMeshComp->GetResource()->mGeometryAlloc = UniformRingAlloc();
 }
 
-void UpdateStaticMeshCompResource(StaticMeshComponent* staticMeshComp)
+void WriteStaticMeshCompGeometryData(StaticMeshComponent* staticMeshComp, GeometryData& ubo)
 {
-    StaticMeshCompResource* resource = staticMeshComp->GetResource();
-
     Renderer* renderer = Renderer::Get();
     OCT_UNUSED(renderer);
 
     World* world = staticMeshComp->GetWorld();
-    GeometryData ubo = {};
+    ubo = {};
 
     WriteGeometryUniformData(ubo, world, staticMeshComp->GetRenderTransform());
 
@@ -1118,8 +1244,17 @@ void UpdateStaticMeshCompResource(StaticMeshComponent* staticMeshComp)
         }
     }
 #endif
+}
 
-    resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
+void UpdateStaticMeshCompResource(StaticMeshComponent* staticMeshComp)
+{
+    StaticMeshCompResource* resource = staticMeshComp->GetResource();
+
+    GeometryData ubo;
+    WriteStaticMeshCompGeometryData(staticMeshComp, ubo);
+
+    UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
+    memcpy(ring.Alloc(sizeof(ubo), resource->mGeometryAlloc), &ubo, sizeof(ubo));
 }
 
 void DrawStaticMeshComp(StaticMeshComponent* staticMeshComp, StaticMesh* meshOverride)
@@ -1130,8 +1265,13 @@ void DrawStaticMeshComp(StaticMeshComponent* staticMeshComp, StaticMesh* meshOve
     if (mesh != nullptr)
     {
         VkCommandBuffer cb = GetCommandBuffer();
+        UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
 
-        UpdateStaticMeshCompResource(staticMeshComp);
+        // Geometry uniforms are written by the first pass that draws the component each frame.
+        if (!ring.IsCurrent(resource->mGeometryAlloc))
+        {
+            UpdateStaticMeshCompResource(staticMeshComp);
+        }
 
         BindStaticMeshResource(mesh);
 
@@ -1160,12 +1300,15 @@ void DrawStaticMeshComp(StaticMeshComponent* staticMeshComp, StaticMesh* meshOve
         assert(pipeline);
 
         BindMaterialResource(material, pipeline);
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout(), resource->mGeometryAlloc);
+
+        uint32_t lod = (meshOverride == nullptr) ? glm::min(staticMeshComp->GetLod(), mesh->GetNumLods() - 1) : 0;
+        const StaticMeshLod& meshLod = mesh->GetLod(lod);
 
         vkCmdDrawIndexed(cb,
-            mesh->GetNumIndices(),
+            meshLod.mNumIndices,
             1,
-            0,
+            meshLod.mFirstIndex,
             0,
             0);
     }
@@ -1174,31 +1317,13 @@ void DrawStaticMeshComp(StaticMeshComponent* staticMeshComp, StaticMesh* meshOve
 void CreateSkeletalMeshCompResource(SkeletalMeshComponent* skeletalMeshComp)
 {
     SkeletalMeshCompResource* resource = skeletalMeshComp->GetResource();
-
-    size_t bufferSize = IsCpuSkinningRequired(skeletalMeshComp) ? sizeof(GeometryData) : sizeof(SkinnedGeometryData);
-    resource->mUniformBuffer = new UniformBuffer(bufferSize, "Skinned Geometry Uniforms");
-
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout(1);
-    resource->mDescriptorSet = new DescriptorSet(layout);
-
-    resource->mDescriptorSet->UpdateUniformDescriptor(GD_UNIFORM_BUFFER, resource->mUniformBuffer);
+    resource->mGeometryAlloc = UniformRingAlloc();
 }
 
 void DestroySkeletalMeshCompResource(SkeletalMeshComponent* skeletalMeshComp)
 {
     SkeletalMeshCompResource* resource = skeletalMeshComp->GetResource();
-
-    if (resource->mUniformBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mUniformBuffer);
-        resource->mUniformBuffer = nullptr;
-    }
-
-    if (resource->mDescriptorSet != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mDescriptorSet);
-        resource->mDescriptorSet = nullptr;
-    }
+    resource->mGeometryAlloc = UniformRingAlloc();
 
     if (resource->mVertexBuffer != nullptr)
     {
@@ -1242,8 +1367,7 @@ void UpdateSkeletalMeshCompUniformBuffer(SkeletalMeshComponent* skeletalMeshComp
     OCT_UNUSED(renderer);
 
     World* world = skeletalMeshComp->GetWorld();
-    CameraComponent* camera = world->GetActiveCamera();
-    DirectionalLightComponent* dirLight = world->GetDirectionalLight();
+    UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
     uint32_t numBoneInfluences = 1;
 
     switch (skeletalMeshComp->GetBoneInfluenceMode())
@@ -1277,33 +1401,26 @@ void UpdateSkeletalMeshCompUniformBuffer(SkeletalMeshComponent* skeletalMeshComp
 
     if (!IsCpuSkinningRequired(skeletalMeshComp))
     {
-        SkinnedGeometryData ubo = {};
-        ubo.mBase.mWVPMatrix = camera->GetViewProjectionMatrix() * transform;
-        ubo.mBase.mWorldMatrix = transform;
-        ubo.mBase.mNormalMatrix = glm::transpose(glm::inverse(transform));
-        ubo.mBase.mLightWVPMatrix = dirLight ? (dirLight->GetViewProjectionMatrix() * transform) : glm::mat4(1);
-        ubo.mBase.mColor = uniformColor; // Currently used for wireframe only.
-        ubo.mBase.mHitCheckId = EDITOR ? skeletalMeshComp->GetOwner()->GetHitCheckId() : 0;
+        // Written in place, only the bones that the mesh uses are filled in.
+        SkinnedGeometryData* ubo = (SkinnedGeometryData*)ring.Alloc(sizeof(SkinnedGeometryData), resource->mGeometryAlloc);
+        WriteGeometryUniformData(ubo->mBase, world, transform);
+        ubo->mBase.mColor = uniformColor; // Currently used for wireframe only.
+        ubo->mBase.mHitCheckId = EDITOR ? skeletalMeshComp->GetOwner()->GetHitCheckId() : 0;
 
         for (uint32_t i = 0; i < skeletalMeshComp->GetNumBones(); ++i)
         {
-            ubo.mBoneMatrices[i] = skeletalMeshComp->GetBoneTransform(i);
+            ubo->mBoneMatrices[i] = skeletalMeshComp->GetBoneTransform(i);
         }
-        ubo.mNumBoneInfluences = numBoneInfluences;
-
-        resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
+        ubo->mNumBoneInfluences = numBoneInfluences;
     }
     else
     {
         GeometryData ubo = {};
-        ubo.mWVPMatrix = camera->GetViewProjectionMatrix() * transform;
-        ubo.mWorldMatrix = transform;
-        ubo.mNormalMatrix = glm::transpose(glm::inverse(transform));
-        ubo.mLightWVPMatrix = dirLight ? (dirLight->GetViewProjectionMatrix() * transform) : glm::mat4(1);
+        WriteGeometryUniformData(ubo, world, transform);
         ubo.mColor = uniformColor; // Currently used for wireframe only.
         ubo.mHitCheckId = EDITOR ? skeletalMeshComp->GetOwner()->GetHitCheckId() : 0;
 
-        resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
+        memcpy(ring.Alloc(sizeof(ubo), resource->mGeometryAlloc), &ubo, sizeof(ubo));
     }
 }
 
@@ -1315,8 +1432,12 @@ void DrawSkeletalMeshComp(SkeletalMeshComponent* skeletalMeshComp)
     if (mesh != nullptr)
     {
         VkCommandBuffer cb = GetCommandBuffer();
+        UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
 
-        UpdateSkeletalMeshCompUniformBuffer(skeletalMeshComp);
+        if (!ring.IsCurrent(resource->mGeometryAlloc))
+        {
+            UpdateSkeletalMeshCompUniformBuffer(skeletalMeshComp);
+        }
 
         if (IsCpuSkinningRequired(skeletalMeshComp))
         {
@@ -1356,7 +1477,7 @@ void DrawSkeletalMeshComp(SkeletalMeshComponent* skeletalMeshComp)
         assert(pipeline);
 
         BindMaterialResource(material, pipeline);
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout(), resource->mGeometryAlloc);
 
         vkCmdDrawIndexed(cb,
             mesh->GetNumIndices(),
@@ -1389,8 +1510,12 @@ void DrawShadowMeshComp(ShadowMeshComponent* shadowMeshComp)
         mesh != nullptr)
     {
         VkCommandBuffer cb = GetCommandBuffer();
+        UniformRingBuffer& ring = context->GetGeometryRingBuffer();
 
-        UpdateStaticMeshCompResource(shadowMeshComp);
+        if (!ring.IsCurrent(resource->mGeometryAlloc))
+        {
+            UpdateStaticMeshCompResource(shadowMeshComp);
+        }
 
         BindStaticMeshResource(mesh);
 
@@ -1398,20 +1523,20 @@ void DrawShadowMeshComp(ShadowMeshComponent* shadowMeshComp)
         // Depth test is reversed.
         Pipeline* backPipeline = context->GetPipeline(PipelineId::ShadowMeshBack);
         context->BindPipeline(backPipeline, shadowMeshComp->GetVertexType());
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, backPipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, backPipeline->GetPipelineLayout(), resource->mGeometryAlloc);
         vkCmdDrawIndexed(cb, mesh->GetNumIndices(), 1, 0, 0, 0);
 
         // Step 2, render front faces and blend the shadow color to the scene colors's RGB channels based on the scene color's Alpha.
         // Depth test is normal
         Pipeline* frontPipeline = context->GetPipeline(PipelineId::ShadowMeshFront);
         context->BindPipeline(frontPipeline, shadowMeshComp->GetVertexType());
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, frontPipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, frontPipeline->GetPipelineLayout(), resource->mGeometryAlloc);
         vkCmdDrawIndexed(cb, mesh->GetNumIndices(), 1, 0, 0, 0);
 
         // Step 3, render front faces without depth testing to clear scene color's alpha channel.
         Pipeline* clearPipeline = context->GetPipeline(PipelineId::ShadowMeshClear);
         context->BindPipeline(clearPipeline, shadowMeshComp->GetVertexType());
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, clearPipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, clearPipeline->GetPipelineLayout(), resource->mGeometryAlloc);
         vkCmdDrawIndexed(cb, mesh->GetNumIndices(), 1, 0, 0, 0);
     }
 }
@@ -1419,30 +1544,13 @@ void DrawShadowMeshComp(ShadowMeshComponent* shadowMeshComp)
 void CreateParticleCompResource(ParticleComponent* particleComp)
 {
     ParticleCompResource* resource = particleComp->GetResource();
-
-    resource->mUniformBuffer = new UniformBuffer(sizeof(GeometryData), "Particle Geometry Uniforms");
-
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Opaque)->GetDescriptorSetLayout(1);
-    resource->mDescriptorSet = new DescriptorSet(layout);
-
-    resource->mDescriptorSet->UpdateUniformDescriptor(GD_UNIFORM_BUFFER, resource->mUniformBuffer);
+    resource->mGeometryAlloc = UniformRingAlloc();
 }
 
 void DestroyParticleCompResource(ParticleComponent* particleComp)
 {
     ParticleCompResource* resource = particleComp->GetResource();
-
-    if (resource->mUniformBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mUniformBuffer);
-        resource->mUniformBuffer = nullptr;
-    }
-
-    if (resource->mDescriptorSet != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mDescriptorSet);
-        resource->mDescriptorSet = nullptr;
-    }
+    resource->mGeometryAlloc = UniformRingAlloc();
 
     if (resource->mVertexBuffer != nullptr)
     {
@@ -1459,15 +1567,12 @@ void DestroyParticleCompResource(ParticleComponent* particleComp)
 
 void UpdateParticleCompResource(ParticleComponent* particleComp)
 {
-    // TODO: Reduce code duplication in updating these uniform buffers...
     ParticleCompResource* resource = particleComp->GetResource();
 
     Renderer* renderer = Renderer::Get();
     OCT_UNUSED(renderer);
 
     World* world = particleComp->GetWorld();
-    CameraComponent* camera = world->GetActiveCamera();
-    DirectionalLightComponent* dirLight = world->GetDirectionalLight();
 
     const glm::mat4 transform = particleComp->GetUseLocalSpace() ? particleComp->GetTransform() : glm::mat4(1);
     glm::vec4 uniformColor = glm::vec4(0.25f, 0.25f, 1.0f, 1.0f);
@@ -1492,14 +1597,12 @@ void UpdateParticleCompResource(ParticleComponent* particleComp)
 #endif
 
     GeometryData ubo = {};
-    ubo.mWVPMatrix = camera->GetViewProjectionMatrix() * transform;
-    ubo.mWorldMatrix = transform;
-    ubo.mNormalMatrix = glm::transpose(glm::inverse(transform));
-    ubo.mLightWVPMatrix = dirLight ? (dirLight->GetViewProjectionMatrix() * transform) : glm::mat4(1);
+    WriteGeometryUniformData(ubo, world, transform);
     ubo.mColor = uniformColor;
     ubo.mHitCheckId = EDITOR ? particleComp->GetOwner()->GetHitCheckId() : 0;
 
-    resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
+    UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
+    memcpy(ring.Alloc(sizeof(ubo), resource->mGeometryAlloc), &ubo, sizeof(ubo));
 }
 
 void UpdateParticleCompVertexBuffer(ParticleComponent* particleComp, const std::vector<VertexParticle>& vertices)
@@ -1571,8 +1674,12 @@ void DrawParticleComp(ParticleComponent* particleComp)
     {
         ParticleCompResource* resource = particleComp->GetResource();
         VkCommandBuffer cb = GetCommandBuffer();
+        UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
 
-        UpdateParticleCompResource(particleComp);
+        if (!ring.IsCurrent(resource->mGeometryAlloc))
+        {
+            UpdateParticleCompResource(particleComp);
+        }
 
         Material* material = particleComp->GetMaterial();
 
@@ -1599,7 +1706,7 @@ void DrawParticleComp(ParticleComponent* particleComp)
         assert(pipeline);
 
         BindMaterialResource(material, pipeline);
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout(), resource->mGeometryAlloc);
 
         VkDeviceSize offset = 0;
         VkBuffer vertexBuffer = resource->mVertexBuffer->Get();
@@ -1616,216 +1723,6 @@ void DrawParticleComp(ParticleComponent* particleComp)
     }
 }
 
-void CreateQuadResource(Quad* quad)
-{
-    QuadResource* resource = quad->GetResource();
-
-    assert(resource->mVertexBuffer == nullptr);
-    resource->mVertexBuffer = new Buffer(BufferType::Vertex, 4 * sizeof(VertexUI), "Quad Vertices");
-
-    assert(resource->mUniformBuffer == nullptr);
-    resource->mUniformBuffer = new UniformBuffer(sizeof(QuadUniformData), "Quad Uniforms");
-    
-    assert(resource->mDescriptorSet == nullptr);
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Quad)->GetDescriptorSetLayout(1);
-    resource->mDescriptorSet = new DescriptorSet(layout);
-
-    UpdateQuadResource(quad);
-}
-
-void DestroyQuadResource(Quad* quad)
-{
-    QuadResource* resource = quad->GetResource();
-
-    if (resource->mVertexBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mVertexBuffer);
-        resource->mVertexBuffer = nullptr;
-    }
-
-    if (resource->mUniformBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mUniformBuffer);
-        resource->mUniformBuffer = nullptr;
-    }
-
-    if (resource->mDescriptorSet != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mDescriptorSet);
-        resource->mDescriptorSet = nullptr;
-    }
-}
-
-void UpdateQuadResource(Quad* quad)
-{
-    // Vertex Buffer
-    QuadResource* resource = quad->GetResource();
-    resource->mVertexBuffer->Update(quad->GetVertices(), sizeof(VertexUI) * 4, 0);
-
-    // Uniform Buffer
-    QuadUniformData ubo = {};
-    ubo.mTransform = glm::mat4(quad->GetTransform());
-    ubo.mTint = quad->GetTint();
-    resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
-
-    // Descriptor Set
-    Renderer* renderer = Renderer::Get();
-    Texture* texture = quad->GetTexture() ? quad->GetTexture() : renderer->mWhiteTexture.Get<Texture>();
-    resource->mDescriptorSet->UpdateUniformDescriptor(0, resource->mUniformBuffer);
-    resource->mDescriptorSet->UpdateImageDescriptor(1, texture->GetResource()->mImage);
-}
-
-void DrawQuad(Quad* quad)
-{
-    QuadResource* resource = quad->GetResource();
-    VkCommandBuffer cb = GetCommandBuffer();
-
-    // Make sure to bind the quad pipeline. Quad and text rendering will be interleaved.
-    Pipeline* quadPipeline = GetVulkanContext()->GetPipeline(PipelineId::Quad);
-    GetVulkanContext()->BindPipeline(quadPipeline, VertexType::VertexUI);
-
-    VkDeviceSize offset = 0;
-    VkBuffer vertexBuffer = resource->mVertexBuffer->Get();
-    vkCmdBindVertexBuffers(cb, 0, 1, &vertexBuffer, &offset);
-
-    resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Quad, quadPipeline->GetPipelineLayout());
-
-    vkCmdDraw(cb, 4, 1, 0, 0);
-}
-
-void CreateTextResource(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    CreateTextResourceVertexBuffer(text);
-
-    assert(resource->mUniformBuffer == nullptr);
-    resource->mUniformBuffer = new UniformBuffer(sizeof(TextUniformData), "Text Uniforms");
-
-    assert(resource->mDescriptorSet == nullptr);
-    VkDescriptorSetLayout layout = GetVulkanContext()->GetPipeline(PipelineId::Text)->GetDescriptorSetLayout(1);
-    resource->mDescriptorSet = new DescriptorSet(layout);
-
-    UpdateTextResourceUniformData(text);
-    UpdateTextResourceVertexData(text);
-}
-
-void DestroyTextResource(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    DestroyTextResourceVertexBuffer(text);
-
-    if (resource->mUniformBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mUniformBuffer);
-        resource->mUniformBuffer = nullptr;
-    }
-
-    if (resource->mDescriptorSet != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mDescriptorSet);
-        resource->mDescriptorSet = nullptr;
-    }
-}
-
-void CreateTextResourceVertexBuffer(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    if (text->GetText().size() > 0 && text->GetNumCharactersAllocated() > 0)
-    {
-        resource->mVertexBuffer = new Buffer(BufferType::Vertex, text->GetNumCharactersAllocated() * TEXT_VERTS_PER_CHAR * sizeof(VertexUI), "Text Vertex Buffer");
-        resource->mNumBufferCharsAllocated = text->GetNumCharactersAllocated();
-    }
-}
-
-void DestroyTextResourceVertexBuffer(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    if (resource->mVertexBuffer != nullptr)
-    {
-        GetDestroyQueue()->Destroy(resource->mVertexBuffer);
-        resource->mVertexBuffer = nullptr;
-        resource->mNumBufferCharsAllocated = 0;
-    }
-}
-
-void UpdateTextResourceUniformData(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    // Uniform Buffer
-    int32_t fontSize = text->GetFont() ? text->GetFont()->GetSize() : 32;
-
-    TextUniformData ubo = {};
-    ubo.mTransform = glm::mat4(text->GetTransform());
-    ubo.mX = text->GetRect().mX;
-    ubo.mY = text->GetRect().mY;
-    ubo.mCutoff = text->GetCutoff();
-    ubo.mOutlineSize = text->GetOutlineSize();
-    ubo.mScale = text->GetScaledSize() / fontSize;
-    ubo.mSoftness = text->GetSoftness();
-    ubo.mPadding1 = 1337;
-    ubo.mPadding2 = 1337;
-    ubo.mDistanceField = false;
-    ubo.mEffect = 0;
-
-    resource->mUniformBuffer->Update(&ubo, sizeof(ubo));
-
-    // Descriptors
-    Renderer* renderer = Renderer::Get();
-    Texture* texture = renderer->mWhiteTexture.Get<Texture>();
-    Font* font = text->GetFont();
-
-    if (font != nullptr &&
-        font->GetTexture() != nullptr)
-    {
-        texture = font->GetTexture();
-    }
-
-    resource->mDescriptorSet->UpdateUniformDescriptor(0, resource->mUniformBuffer);
-    resource->mDescriptorSet->UpdateImageDescriptor(1, texture->GetResource()->mImage);
-}
-
-void UpdateTextResourceVertexData(Text* text)
-{
-    TextResource* resource = text->GetResource();
-    uint32_t numCharsAllocated = text->GetNumCharactersAllocated();
-    if (resource->mNumBufferCharsAllocated < numCharsAllocated)
-    {
-        DestroyTextResourceVertexBuffer(text);
-        CreateTextResourceVertexBuffer(text);
-    }
-
-    if (resource->mVertexBuffer != nullptr)
-    {
-        // Copy over vertex array from system memory
-        resource->mVertexBuffer->Update(text->GetVertices(), sizeof(VertexUI) * TEXT_VERTS_PER_CHAR * numCharsAllocated);
-    }
-}
-
-void DrawTextWidget(Text* text)
-{
-    TextResource* resource = text->GetResource();
-
-    if (text->GetText().size() > 0 && resource->mVertexBuffer != nullptr)
-    {
-        VkCommandBuffer cb = GetCommandBuffer();
-        Pipeline* textPipeline = GetVulkanContext()->GetPipeline(PipelineId::Text);
-        GetVulkanContext()->BindPipeline(textPipeline, VertexType::VertexUI);
-
-        VkDeviceSize offset = 0;
-        VkBuffer vertexBuffer = resource->mVertexBuffer->Get();
-        vkCmdBindVertexBuffers(cb, 0, 1, &vertexBuffer, &offset);
-
-        resource->mDescriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Text, textPipeline->GetPipelineLayout());
-
-        vkCmdDraw(cb, 6 * text->GetNumVisibleCharacters(), 1, 0, 0);
-    }
-}
-
 void DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& transform, glm::vec4 color, uint32_t hitCheckId)
 {
     assert(mesh != nullptr);
@@ -1834,13 +1731,13 @@ void DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& trans
         VkCommandBuffer cb = GetCommandBuffer();
 
         // Setup uniform buffer
-        UniformBufferArena& uniformArena = GetVulkanContext()->GetMeshUniformBufferArena();
-        UniformBuffer* uniformBuffer = uniformArena.Alloc(sizeof(GeometryData), "DrawStaticMesh Uniforms");
+        UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
+        UniformRingAlloc geometryAlloc;
         GeometryData ubo = {};
         WriteGeometryUniformData(ubo, GetWorld(), transform);
         ubo.mColor = color;
         ubo.mHitCheckId = hitCheckId;
-        uniformBuffer->Update(&ubo, sizeof(ubo));
+        memcpy(ring.Alloc(sizeof(ubo), geometryAlloc), &ubo, sizeof(ubo));
 
         BindStaticMeshResource(mesh);
 
@@ -1867,10 +1764,7 @@ void DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& trans
         assert(pipeline);
         BindMaterialResource(material, pipeline);
 
-        DescriptorSetArena& descriptorArena = GetVulkanContext()->GetMeshDescriptorSetArena();
-        DescriptorSet* descriptorSet = descriptorArena.Alloc(pipeline->GetDescriptorSetLayout((uint32_t)DescriptorSetBinding::Geometry));
-        descriptorSet->UpdateUniformDescriptor(GD_UNIFORM_BUFFER, uniformBuffer);
-        descriptorSet->Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout());
+        ring.Bind(cb, (uint32_t)DescriptorSetBinding::Geometry, pipeline->GetPipelineLayout(), geometryAlloc);
 
         vkCmdDrawIndexed(cb,
             mesh->GetNumIndices(),
@@ -1880,3 +1774,50 @@ void DrawStaticMesh(StaticMesh* mesh, Material* material, const glm::mat4& trans
             0);
     }
 }
+
+void PrepareDrawResources(PrimitiveComponent* comp, Material* material)
+{
+    UniformRingBuffer& ring = GetVulkanContext()->GetGeometryRingBuffer();
+
+    // ShadowMeshComponent is a StaticMeshComponent and shares its resource.
+    if (comp->Is(StaticMeshComponent::ClassRuntimeId()))
+    {
+        StaticMeshComponent* staticMeshComp = static_cast<StaticMeshComponent*>(comp);
+        if (!ring.IsCurrent(staticMeshComp->GetResource()->mGeometryAlloc))
+        {
+            UpdateStaticMeshCompResource(staticMeshComp);
+        }
+    }
+    else if (comp->Is(SkeletalMeshComponent::ClassRuntimeId()))
+    {
+        SkeletalMeshComponent* skeletalMeshComp = static_cast<SkeletalMeshComponent*>(comp);
+        if (!ring.IsCurrent(skeletalMeshComp->GetResource()->mGeometryAlloc))
+        {
+            UpdateSkeletalMeshCompUniformBuffer(skeletalMeshComp);
+        }
+    }
+    else if (comp->Is(ParticleComponent::ClassRuntimeId()))
+    {
+        ParticleComponent* particleComp = static_cast<ParticleComponent*>(comp);
+        if (!ring.IsCurrent(particleComp->GetResource()->mGeometryAlloc))
+        {
+            UpdateParticleCompResource(particleComp);
+        }
+    }
+
+    if (material == nullptr)
+    {
+        material = Renderer::Get()->GetDefaultMaterial();
+        assert(material != nullptr);
+    }
+
+    if (material->IsDirty(GetFrameIndex()))
+    {
+        UpdateMaterialResource(material);
+    }
+
+    if (material->GetResource()->mDescriptorSet != nullptr)
+    {
+        material->GetResource()->mDescriptorSet->Refresh();
+    }
+}
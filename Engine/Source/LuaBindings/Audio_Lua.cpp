@@ -4,6 +4,8 @@
 #include "Asset.h"
 #include "Assets/SoundWave.h"
 
+#include "Audio/AudioMixer.h"
+
 #include "LuaBindings/LuaUtils.h"
 #include "LuaBindings/Audio_Lua.h"
 #include "LuaBindings/Asset_Lua.h"
@@ -89,6 +91,19 @@ int Audio_Lua::StopAllSounds(lua_State* L)
     return 0;
 }
 
+int Audio_Lua::BenchmarkMixer(lua_State* L)
+{
+    uint32_t numVoices = 32;
+    float seconds = 10.0f;
+    if (!lua_isnone(L, 1)) { numVoices = (uint32_t) CHECK_INTEGER(L, 1); }
+    if (!lua_isnone(L, 2)) { seconds = CHECK_NUMBER(L, 2); }
+
+    float elapsedMs = AUD_BenchmarkMixer(numVoices, seconds);
+
+    lua_pushnumber(L, elapsedMs);
+    return 1;
+}
+
 void Audio_Lua::Bind()
 {
     lua_State* L = GetLua();
@@ -108,6 +123,9 @@ void Audio_Lua::Bind()
     lua_pushcfunction(L, StopAllSounds);
     lua_setfield(L, tableIdx, "StopAllSounds");
 
+    lua_pushcfunction(L, BenchmarkMixer);
+    lua_setfield(L, tableIdx, "BenchmarkMixer");
+
     lua_setglobal(L, AUDIO_LUA_NAME);
 
     assert(lua_gettop(L) == 0);
@@ -3,6 +3,8 @@
 #include "AssetManager.h"
 #include "Utilities.h"
 
+#include "Widgets/StatsOverlay.h"
+
 #include "LuaBindings/Renderer_Lua.h"
 #include "LuaBindings/LuaUtils.h"
 #include "LuaBindings/Vector_Lua.h"
@@ -57,6 +59,28 @@ int Renderer_Lua::EnableStatsOverlay(lua_State* L)
     return 0;
 }
 
+int Renderer_Lua::SetStatsDisplayMode(lua_State* L)
+{
+    int32_t value = CHECK_INTEGER(L, 1);
+
+    if (value < 0 || value >= (int32_t)StatDisplayMode::Count)
+    {
+        luaL_error(L, "Invalid stats display mode %d", value);
+    }
+
+    Renderer::Get()->GetStatsWidget()->SetDisplayMode((StatDisplayMode)value);
+
+    return 0;
+}
+
+int Renderer_Lua::GetStatsDisplayMode(lua_State* L)
+{
+    StatDisplayMode ret = Renderer::Get()->GetStatsWidget()->GetDisplayMode();
+
+    lua_pushinteger(L, (int)ret);
+    return 1;
+}
+
 int Renderer_Lua::SetModalWidget(lua_State* L)
 {
     Widget* widget = CHECK_WIDGET(L, 1);
@@ -217,6 +241,23 @@ int Renderer_Lua::IsFrustumCullingEnabled(lua_State* L)
     return 1;
 }
 
+int Renderer_Lua::EnableMeshLods(lua_State* L)
+{
+    bool value = CHECK_BOOLEAN(L, 1);
+
+    Renderer::Get()->EnableMeshLods(value);
+
+    return 0;
+}
+
+int Renderer_Lua::AreMeshLodsEnabled(lua_State* L)
+{
+    bool ret = Renderer::Get()->AreMeshLodsEnabled();
+
+    lua_pushboolean(L, ret);
+    return 1;
+}
+
 int Renderer_Lua::AddDebugDraw(lua_State* L)
 {
     DebugDraw draw;
@@ -275,6 +316,12 @@ void Renderer_Lua::Bind()
     lua_pushcfunction(L, EnableStatsOverlay);
     lua_setfield(L, tableIdx, "EnableStatsOverlay");
 
+    lua_pushcfunction(L, SetStatsDisplayMode);
+    lua_setfield(L, tableIdx, "SetStatsDisplayMode");
+
+    lua_pushcfunction(L, GetStatsDisplayMode);
+    lua_setfield(L, tableIdx, "GetStatsDisplayMode");
+
     lua_pushcfunction(L, SetModalWidget);
     lua_setfield(L, tableIdx, "SetModalWidget");
 
@@ -332,6 +379,12 @@ void Renderer_Lua::Bind()
     lua_pushcfunction(L, IsFrustumCullingEnabled);
     lua_setfield(L, tableIdx, "IsFrustumCullingEnabled");
 
+    lua_pushcfunction(L, EnableMeshLods);
+    lua_setfield(L, tableIdx, "EnableMeshLods");
+
+    lua_pushcfunction(L, AreMeshLodsEnabled);
+    lua_setfield(L, tableIdx, "AreMeshLodsEnabled");
+
     lua_pushcfunction(L, AddDebugDraw);
     lua_setfield(L, tableIdx, "AddDebugDraw");
 
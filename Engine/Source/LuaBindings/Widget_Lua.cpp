@@ -610,6 +610,26 @@ int Widget_Lua::IsDirty(lua_State* L)
     return 1;
 }
 
+int Widget_Lua::SetAnimated(lua_State* L)
+{
+    Widget* widget = CHECK_WIDGET(L, 1);
+    bool value = CHECK_BOOLEAN(L, 2);
+
+    widget->SetAnimated(value);
+
+    return 0;
+}
+
+int Widget_Lua::IsAnimated(lua_State* L)
+{
+    Widget* widget = CHECK_WIDGET(L, 1);
+
+    bool ret = widget->IsAnimated();
+
+    lua_pushboolean(L, ret);
+    return 1;
+}
+
 int Widget_Lua::ContainsMouse(lua_State* L)
 {
     Widget* widget = CHECK_WIDGET(L, 1);
@@ -905,6 +925,12 @@ void Widget_Lua::Bind()
     lua_pushcfunction(L, IsDirty);
     lua_setfield(L, mtIndex, "IsDirty");
 
+    lua_pushcfunction(L, SetAnimated);
+    lua_setfield(L, mtIndex, "SetAnimated");
+
+    lua_pushcfunction(L, IsAnimated);
+    lua_setfield(L, mtIndex, "IsAnimated");
+
     lua_pushcfunction(L, ContainsMouse);
     lua_setfield(L, mtIndex, "ContainsMouse");
 
@@ -9,6 +9,7 @@
 #include "LuaBindings/DirectionalLightComponent_Lua.h"
 
 #include "Components/PrimitiveComponent.h"
+#include "Components/ScriptComponent.h"
 
 #if LUA_ENABLED
 
@@ -458,6 +459,28 @@ int World_Lua::SpawnBlueprint(lua_State* L)
     return 1;
 }
 
+int World_Lua::PrewarmActorPool(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+    const char* actorClass = CHECK_STRING(L, 2);
+    int32_t count = CHECK_INTEGER(L, 3);
+
+    world->PrewarmActorPool(actorClass, (uint32_t)glm::max(count, 0));
+
+    return 0;
+}
+
+int World_Lua::PrewarmBlueprintPool(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+    const char* name = CHECK_STRING(L, 2);
+    int32_t count = CHECK_INTEGER(L, 3);
+
+    world->PrewarmBlueprintPool(name, (uint32_t)glm::max(count, 0));
+
+    return 0;
+}
+
 int World_Lua::LoadLevel(lua_State* L)
 {
     World* world = CHECK_WORLD(L, 1);
@@ -499,6 +522,69 @@ int World_Lua::UnloadLevel(lua_State* L)
     return 0;
 }
 
+int World_Lua::StreamLevel(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+    const char* name = CHECK_STRING(L, 2);
+    glm::vec3 offset = { 0.0f, 0.0f, 0.0f };
+    glm::vec3 rotation = { 0.0f, 0.0f, 0.0f };
+    if (!lua_isnone(L, 3)) { offset = CHECK_VECTOR(L, 3); }
+    if (!lua_isnone(L, 4)) { rotation = CHECK_VECTOR(L, 4); }
+
+    world->StreamLevel(name, offset, rotation);
+
+    return 0;
+}
+
+int World_Lua::IsStreamingLevels(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+
+    bool ret = world->IsStreamingLevels();
+
+    lua_pushboolean(L, ret);
+    return 1;
+}
+
+int World_Lua::GetLevelStreamProgress(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+
+    float ret = world->GetLevelStreamProgress();
+
+    lua_pushnumber(L, ret);
+    return 1;
+}
+
+int World_Lua::SetLevelStreamBudget(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+    float budgetMs = CHECK_NUMBER(L, 2);
+
+    world->SetLevelStreamBudget(budgetMs);
+
+    return 0;
+}
+
+int World_Lua::SetLevelStreamedCallback(lua_State* L)
+{
+    World* world = CHECK_WORLD(L, 1);
+    const char* funcName = CHECK_STRING(L, 2);
+
+    if (strcmp(funcName, "") == 0)
+    {
+        world->SetScriptLevelStreamedCallback("", "");
+    }
+    else
+    {
+        world->SetScriptLevelStreamedCallback(
+            ScriptComponent::GetExecutingScriptTableName(),
+            funcName);
+    }
+
+    return 0;
+}
+
 int World_Lua::EnableInternalEdgeSmoothing(lua_State* L)
 {
     World* world = CHECK_WORLD(L, 1);
@@ -614,6 +700,12 @@ void World_Lua::Bind()
     lua_pushcfunction(L, World_Lua::SpawnBlueprint);
     lua_setfield(L, mtIndex, "SpawnBlueprint");
 
+    lua_pushcfunction(L, World_Lua::PrewarmActorPool);
+    lua_setfield(L, mtIndex, "PrewarmActorPool");
+
+    lua_pushcfunction(L, World_Lua::PrewarmBlueprintPool);
+    lua_setfield(L, mtIndex, "PrewarmBlueprintPool");
+
     lua_pushcfunction(L, World_Lua::LoadLevel);
     lua_setfield(L, mtIndex, "LoadLevel");
 
@@ -623,6 +715,21 @@ void World_Lua::Bind()
     lua_pushcfunction(L, World_Lua::UnloadLevel);
     lua_setfield(L, mtIndex, "UnloadLevel");
 
+    lua_pushcfunction(L, World_Lua::StreamLevel);
+    lua_setfield(L, mtIndex, "StreamLevel");
+
+    lua_pushcfunction(L, World_Lua::IsStreamingLevels);
+    lua_setfield(L, mtIndex, "IsStreamingLevels");
+
+    lua_pushcfunction(L, World_Lua::GetLevelStreamProgress);
+    lua_setfield(L, mtIndex, "GetLevelStreamProgress");
+
+    lua_pushcfunction(L, World_Lua::SetLevelStreamBudget);
+    lua_setfield(L, mtIndex, "SetLevelStreamBudget");
+
+    lua_pushcfunction(L, World_Lua::SetLevelStreamedCallback);
+    lua_setfield(L, mtIndex, "SetLevelStreamedCallback");
+
     lua_pushcfunction(L, World_Lua::EnableInternalEdgeSmoothing);
     lua_setfield(L, mtIndex, "EnableInternalEdgeSmoothing");
 
@@ -99,6 +99,20 @@ void SYS_RemoveFile(const char* path)
     remove(path);
 }
 
+bool SYS_GetFileInfo(const char* path, uint64_t& outModifiedTime, uint64_t& outSize)
+{
+    struct stat statbuf;
+
+    if (stat(path, &statbuf) != 0)
+    {
+        return false;
+    }
+
+    outModifiedTime = uint64_t(statbuf.st_mtime);
+    outSize = uint64_t(statbuf.st_size);
+    return true;
+}
+
 bool SYS_Rename(const char* oldPath, const char* newPath)
 {
     return (rename(oldPath, newPath) == 0);
@@ -284,6 +284,20 @@ void SYS_RemoveFile(const char* path)
     remove(path);
 }
 
+bool SYS_GetFileInfo(const char* path, uint64_t& outModifiedTime, uint64_t& outSize)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fileData = {};
+
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &fileData))
+    {
+        return false;
+    }
+
+    outModifiedTime = (uint64_t(fileData.ftLastWriteTime.dwHighDateTime) << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+    outSize = (uint64_t(fileData.nFileSizeHigh) << 32) | fileData.nFileSizeLow;
+    return true;
+}
+
 bool SYS_Rename(const char* oldPath, const char* newPath)
 {
     return (rename(oldPath, newPath) == 0);